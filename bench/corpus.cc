@@ -0,0 +1,48 @@
+/* Writes every benchmark corpus to <directory>/<name>.kon */
+
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <print>
+
+#include "corpus.hh"
+
+
+auto
+main(int argc, char **argv) -> int
+{
+    if (argc < 2)
+    {
+        std::println(stderr, "usage: {} <directory> [bytes] [seed]", argv[0]);
+        return 1;
+    }
+
+    std::size_t   bytes { 1 << 20 };
+    std::uint64_t seed { 0x6b6f6e };
+
+    if (argc > 2)
+    {
+        const std::string_view arg { argv[2] };
+        std::from_chars(arg.data(), arg.data() + arg.size(), bytes);
+    }
+
+    if (argc > 3)
+    {
+        const std::string_view arg { argv[3] };
+        std::from_chars(arg.data(), arg.data() + arg.size(), seed);
+    }
+
+    const std::filesystem::path directory { argv[1] };
+    std::filesystem::create_directories(directory);
+
+    for (const auto corpus : bench::Corpora)
+    {
+        const auto path { directory
+                          / std::format("{}.kon", bench::name(corpus)) };
+        std::ofstream { path, std::ios::binary }
+            << bench::generate(corpus, bytes, seed);
+        std::println("{}", path.string());
+    }
+
+    return 0;
+}
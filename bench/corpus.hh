@@ -0,0 +1,241 @@
+#ifndef BENCH__CORPUS__HH
+#define BENCH__CORPUS__HH
+#include <array>
+#include <cstdint>
+#include <format>
+#include <string>
+#include <string_view>
+
+
+namespace bench
+{
+    enum class Corpus : std::uint8_t
+    {
+        Numeric,
+        String,
+        Nested,
+        Wide,
+        Comment,
+        Dotted,
+    };
+
+
+    inline constexpr std::array Corpora {
+        Corpus::Numeric, Corpus::String,  Corpus::Nested,
+        Corpus::Wide,    Corpus::Comment, Corpus::Dotted,
+    };
+
+
+    [[nodiscard]]
+    constexpr auto
+    name(Corpus corpus) noexcept -> std::string_view
+    {
+        switch (corpus)
+        {
+        case Corpus::Numeric: return "numeric";
+        case Corpus::String:  return "string";
+        case Corpus::Nested:  return "nested";
+        case Corpus::Wide:    return "wide";
+        case Corpus::Comment: return "comment";
+        case Corpus::Dotted:  return "dotted";
+        }
+
+        return "unknown";
+    }
+
+
+    /* splitmix64, so that every platform generates the same corpus. */
+    class Random
+    {
+    public:
+        explicit Random(std::uint64_t seed) : m_state(seed) {}
+
+
+        auto
+        next() noexcept -> std::uint64_t
+        {
+            auto z { m_state += 0x9e3779b97f4a7c15 };
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+            return z ^ (z >> 31);
+        }
+
+
+        auto
+        below(std::uint64_t bound) noexcept -> std::uint64_t
+        {
+            return next() % bound;
+        }
+
+
+    private:
+        std::uint64_t m_state;
+    };
+
+
+    namespace detail
+    {
+        inline constexpr std::array<std::string_view, 16> Words {
+            "alpha", "bravo",  "charlie", "delta", "echo",   "foxtrot",
+            "golf",  "hotel",  "india",   "juliet", "kilo",  "lima",
+            "mike",  "november", "oscar", "papa",
+        };
+
+
+        inline void
+        words(std::string &out, Random &random, std::size_t count)
+        {
+            for (std::size_t i { 0 }; i < count; i++)
+            {
+                if (i != 0) out += ' ';
+                out += Words[random.below(Words.size())];
+            }
+        }
+
+
+        inline void
+        numeric(std::string &out, Random &random, std::size_t line)
+        {
+            switch (random.below(3))
+            {
+            case 0:
+                std::format_to(std::back_inserter(out),
+                               "int{}: {}\n",
+                               line,
+                               static_cast<std::int64_t>(random.next()) >> 16);
+                break;
+            case 1:
+                std::format_to(std::back_inserter(out),
+                               "float{}: {}.{}\n",
+                               line,
+                               random.below(1'000'000),
+                               random.below(1'000'000));
+                break;
+            default:
+                std::format_to(std::back_inserter(out), "array{}: [ ", line);
+                for (int i { 0 }; i < 8; i++)
+                    std::format_to(std::back_inserter(out),
+                                   "{}{}",
+                                   i == 0 ? "" : ", ",
+                                   random.below(100'000));
+                out += " ]\n";
+            }
+        }
+
+
+        inline void
+        string(std::string &out, Random &random, std::size_t line)
+        {
+            std::format_to(std::back_inserter(out), "text{}: \"", line);
+            words(out, random, 4 + random.below(12));
+
+            if (random.below(4) == 0) out += R"(\n\t\"quoted\")";
+            out += '"';
+
+            if (random.below(4) == 0)
+            {
+                out += "\n    \"";
+                words(out, random, 4);
+                out += '"';
+            }
+            out += '\n';
+        }
+
+
+        inline void
+        nested(std::string &out, Random &random, std::size_t line)
+        {
+            const auto depth { 4 + random.below(12) };
+
+            for (std::size_t level { 0 }; level < depth; level++)
+            {
+                out.append(level * 4, ' ');
+                std::format_to(
+                    std::back_inserter(out), "level{}x{}:\n", level, line);
+            }
+
+            out.append(depth * 4, ' ');
+            std::format_to(
+                std::back_inserter(out), "leaf: {}\n", random.below(1000));
+        }
+
+
+        inline void
+        wide(std::string &out, Random &random, std::size_t line)
+        {
+            if (line == 0) out += "wide:\n";
+            std::format_to(std::back_inserter(out),
+                           "    member{}: {}\n",
+                           line,
+                           random.below(1'000'000));
+        }
+
+
+        inline void
+        comment(std::string &out, Random &random, std::size_t line)
+        {
+            if (random.below(8) == 0)
+            {
+                out += "/*\n";
+                for (int i { 0 }; i < 12; i++)
+                {
+                    out += " * ";
+                    words(out, random, 10);
+                    out += '\n';
+                }
+                out += " */\n";
+            }
+
+            out += "// ";
+            words(out, random, 6);
+            std::format_to(std::back_inserter(out),
+                           "\nvalue{}: {} /* inline */ // trailing\n",
+                           line,
+                           random.below(1000));
+        }
+
+
+        inline void
+        dotted(std::string &out, Random &random, std::size_t line)
+        {
+            std::format_to(std::back_inserter(out),
+                           "svc{}.{}.{}.option{}: {}\n",
+                           line / 256,
+                           Words[(line / 16) % Words.size()],
+                           Words[line % Words.size()],
+                           line,
+                           random.below(1000));
+        }
+    }
+
+
+    /**
+     * @brief Generates a deterministic kon document of about @p bytes bytes.
+     */
+    [[nodiscard]]
+    inline auto
+    generate(Corpus corpus, std::size_t bytes, std::uint64_t seed = 0x6b6f6e)
+        -> std::string
+    {
+        Random      random { seed ^ static_cast<std::uint64_t>(corpus) };
+        std::string out;
+        out.reserve(bytes + 4096);
+
+        for (std::size_t line { 0 }; out.size() < bytes; line++)
+        {
+            switch (corpus)
+            {
+            case Corpus::Numeric: detail::numeric(out, random, line); break;
+            case Corpus::String:  detail::string(out, random, line); break;
+            case Corpus::Nested:  detail::nested(out, random, line); break;
+            case Corpus::Wide:    detail::wide(out, random, line); break;
+            case Corpus::Comment: detail::comment(out, random, line); break;
+            case Corpus::Dotted:  detail::dotted(out, random, line); break;
+            }
+        }
+
+        return out;
+    }
+}
+
+#endif /* BENCH__CORPUS__HH */
@@ -0,0 +1,199 @@
+#ifndef BENCH__MICRO__HH
+#define BENCH__MICRO__HH
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <print>
+#include <span>
+#include <string_view>
+#include <vector>
+
+
+/*
+ * A minimal, self-contained microbenchmark harness modelled after Google
+ * Benchmark:
+ *
+ *     void
+ *     bm_add(bench::State &state)
+ *     {
+ *         std::int64_t a { 1 };
+ *         for (auto _ : state) bench::do_not_optimize(a += 3);
+ *     }
+ */
+namespace bench
+{
+    /* Forces @p value to be materialised, so its computation is kept. */
+    template <typename T_Type>
+    inline void
+    do_not_optimize(T_Type &&value) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "g"(&value) : "memory");
+#else
+        static volatile const void *sink;
+        sink = &value;
+#endif
+    }
+
+
+    /* Prevents the compiler from caching memory across this point. */
+    inline void
+    clobber_memory() noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : : "memory");
+#endif
+    }
+
+
+    class State
+    {
+    public:
+        struct Iterator
+        {
+            std::size_t remaining;
+
+            /* non-trivial, so that unused loop variables are not diagnosed */
+            struct Value
+            {
+                ~Value() noexcept {}
+            };
+
+
+            auto
+            operator*() const noexcept -> Value
+            {
+                return {};
+            }
+
+
+            auto
+            operator++() noexcept -> Iterator &
+            {
+                remaining--;
+                return *this;
+            }
+
+
+            auto
+            operator!=(const Iterator &) const noexcept -> bool
+            {
+                return remaining != 0;
+            }
+        };
+
+
+        explicit State(std::size_t iterations) : m_iterations(iterations) {}
+
+
+        [[nodiscard]]
+        auto
+        begin() noexcept -> Iterator
+        {
+            m_start = std::chrono::steady_clock::now();
+            return { m_iterations };
+        }
+
+
+        [[nodiscard]]
+        auto
+        end() noexcept -> Iterator
+        {
+            return { 0 };
+        }
+
+
+        [[nodiscard]]
+        auto
+        iterations() const noexcept -> std::size_t
+        {
+            return m_iterations;
+        }
+
+
+        [[nodiscard]]
+        auto
+        start() const noexcept -> std::chrono::steady_clock::time_point
+        {
+            return m_start;
+        }
+
+
+    private:
+        std::size_t                           m_iterations;
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+
+    struct Benchmark
+    {
+        std::string_view name;
+
+        /* The name of the benchmark this one is compared against, if any. */
+        std::string_view baseline;
+
+        void (*run)(State &state);
+    };
+
+
+    /*
+     * Runs every benchmark for at least @p min_time seconds and prints one
+     * JSON object per benchmark. Benchmarks with a baseline also report
+     * their cost relative to it.
+     */
+    inline void
+    run(std::span<const Benchmark> benchmarks, double min_time)
+    {
+        struct Result
+        {
+            std::string_view name;
+            double           ns_per_op;
+        };
+
+        std::vector<Result> results;
+        results.reserve(benchmarks.size());
+
+        for (const auto &benchmark : benchmarks)
+        {
+            std::size_t iterations { 1 };
+            double      elapsed {};
+
+            while (true)
+            {
+                State state { iterations };
+                benchmark.run(state);
+
+                elapsed = std::chrono::duration<double> {
+                    std::chrono::steady_clock::now() - state.start()
+                }.count();
+                if (elapsed >= min_time || iterations >= (1ULL << 40)) break;
+
+                /* aim slightly past min_time, but never grow more than 10x */
+                const auto scale { elapsed > 0 ? min_time * 1.4 / elapsed
+                                               : 10.0 };
+                iterations = static_cast<std::size_t>(
+                    static_cast<double>(iterations)
+                    * std::clamp(scale, 2.0, 10.0));
+            }
+
+            const auto ns { elapsed * 1e9 / static_cast<double>(iterations) };
+            results.push_back({ benchmark.name, ns });
+
+            double ratio { 1.0 };
+            for (const auto &result : results)
+                if (result.name == benchmark.baseline)
+                    ratio = ns / result.ns_per_op;
+
+            std::println(R"({{"name":"{}","baseline":"{}","iterations":{},)"
+                         R"("ns_per_op":{:.3f},"ratio":{:.2f}}})",
+                         benchmark.name,
+                         benchmark.baseline,
+                         iterations,
+                         ns,
+                         ratio);
+        }
+    }
+}
+
+#endif /* BENCH__MICRO__HH */
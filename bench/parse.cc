@@ -0,0 +1,224 @@
+/*
+ * End-to-end parser benchmark.
+ *
+ * Prints one JSON object per corpus and parsing mode so that results can be
+ * compared between releases. Every pair runs in a process of its own, so
+ * that its peak RSS covers generating that corpus and parsing it in that
+ * mode alone.
+ *
+ * usage: __parse_bench [--size=BYTES] [--seed=N] [--min-time=SECONDS]
+ */
+
+#include <koncpp/parser.hh>
+
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <print>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "corpus.hh"
+
+
+namespace
+{
+    std::size_t g_allocations {};
+    std::size_t g_allocated {};
+
+
+    /* Discards every event, measuring the parser alone. */
+    class NullHandler : public koncpp::Handler
+    {
+    public:
+        void key(std::string_view) override {}
+        void begin_object() override {}
+        void end_object() override {}
+        void begin_array() override {}
+        void end_array() override {}
+        void null() override {}
+        void integer(koncpp::types::Signed) override {}
+        void unsigned_integer(koncpp::types::Unsigned) override {}
+        void floating(double) override {}
+        void boolean(bool) override {}
+        void string(std::string_view) override {}
+    };
+
+
+    struct Mode
+    {
+        std::string_view name;
+        void (*run)(koncpp::Parser &parser, std::string_view source);
+    };
+
+
+    constexpr std::array Modes {
+        Mode { "events",
+               [](koncpp::Parser &parser, std::string_view source)
+               {
+                   NullHandler handler;
+                   parser.parse(source, handler);
+               } },
+        Mode { "tree",
+               [](koncpp::Parser &parser, std::string_view source)
+               {
+                   koncpp::Builder<> builder;
+                   parser.parse(source, builder);
+                   auto document { builder.take() };
+               } },
+    };
+
+
+    struct Options
+    {
+        std::size_t   size { 1 << 20 };
+        std::uint64_t seed { 0x6b6f6e };
+        double        min_time { 0.5 };
+    };
+
+
+    auto
+    peak_rss_kib() -> long
+    {
+        rusage usage {};
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_maxrss;
+    }
+
+
+    template <typename T_Number>
+    void
+    option(std::string_view arg, std::string_view name, T_Number &value)
+    {
+        if (!arg.starts_with(name)) return;
+        arg.remove_prefix(name.size());
+        std::from_chars(arg.data(), arg.data() + arg.size(), value);
+    }
+}
+
+
+auto
+operator new(std::size_t size) -> void *
+{
+    g_allocations++;
+    g_allocated += size;
+
+    if (auto *ptr { std::malloc(size != 0 ? size : 1) }; ptr != nullptr)
+        return ptr;
+    throw std::bad_alloc {};
+}
+
+
+void
+operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+
+void
+operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+
+namespace
+{
+    /* Prints the row of @p mode on @p corpus . */
+    void
+    measure(bench::Corpus corpus, const Mode &mode, const Options &options)
+    {
+        const auto source { bench::generate(corpus, options.size,
+                                            options.seed) };
+
+        koncpp::Parser parser;
+        mode.run(parser, source); /* warm up */
+
+        const auto allocations { g_allocations };
+        const auto allocated { g_allocated };
+        mode.run(parser, source);
+        const auto doc_allocations { g_allocations - allocations };
+        const auto doc_allocated { g_allocated - allocated };
+
+        std::size_t iterations {};
+        const auto  start { std::chrono::steady_clock::now() };
+        std::chrono::duration<double> elapsed {};
+
+        while (elapsed.count() < options.min_time)
+        {
+            mode.run(parser, source);
+            iterations++;
+            elapsed = std::chrono::steady_clock::now() - start;
+        }
+
+        const auto bytes { static_cast<double>(source.size()) };
+
+        std::println(R"({{"corpus":"{}","mode":"{}","bytes":{},)"
+                     R"("iterations":{},"mb_per_s":{:.2f},)"
+                     R"("allocations_per_doc":{},)"
+                     R"("bytes_allocated_per_doc":{},)"
+                     R"("peak_rss_kib":{}}})",
+                     bench::name(corpus),
+                     mode.name,
+                     source.size(),
+                     iterations,
+                     bytes * static_cast<double>(iterations)
+                         / elapsed.count() / 1e6,
+                     doc_allocations,
+                     doc_allocated,
+                     peak_rss_kib());
+    }
+
+
+    /* Runs measure() in a child process, returning whether it succeeded. */
+    auto
+    measure_apart(bench::Corpus  corpus,
+                  const Mode    &mode,
+                  const Options &options) -> bool
+    {
+        std::fflush(stdout);
+
+        const auto pid { fork() };
+        if (pid == 0)
+        {
+            measure(corpus, mode, options);
+            std::fflush(stdout);
+            std::_Exit(0);
+        }
+
+        int status {};
+        return pid > 0 && waitpid(pid, &status, 0) == pid && WIFEXITED(status)
+            && WEXITSTATUS(status) == 0;
+    }
+}
+
+
+auto
+main(int argc, char **argv) -> int
+{
+    Options options;
+
+    for (int i { 1 }; i < argc; i++)
+    {
+        option(argv[i], "--size=", options.size);
+        option(argv[i], "--seed=", options.seed);
+        option(argv[i], "--min-time=", options.min_time);
+    }
+
+    for (const auto corpus : bench::Corpora)
+        for (const auto &mode : Modes)
+        {
+            if (measure_apart(corpus, mode, options)) continue;
+
+            std::println(stderr, "{}/{}: the measuring process failed",
+                         bench::name(corpus), mode.name);
+            return 1;
+        }
+
+    return 0;
+}
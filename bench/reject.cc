@@ -0,0 +1,145 @@
+/*
+ * Rejection microbenchmarks.
+ *
+ * Measures what rejecting a small invalid document costs, by try_parse()
+ * and by parse() throwing a ParseError, against accepting the same
+ * document with the mistake fixed. The mistakes are in the scanners that
+ * most invalid input trips over first: strings, numbers and indentation.
+ *
+ * usage: __reject_bench [--min-time=SECONDS]
+ */
+
+#include <koncpp/parser.hh>
+
+#include <array>
+#include <charconv>
+#include <string_view>
+
+#include "micro.hh"
+
+
+namespace
+{
+    /* Discards every event, measuring the parser alone. */
+    class NullHandler : public koncpp::Handler
+    {
+    public:
+        void key(std::string_view) override {}
+        void begin_object() override {}
+        void end_object() override {}
+        void begin_array() override {}
+        void end_array() override {}
+        void null() override {}
+        void integer(koncpp::types::Signed) override {}
+        void unsigned_integer(koncpp::types::Unsigned) override {}
+        void floating(double) override {}
+        void boolean(bool) override {}
+        void string(std::string_view) override {}
+    };
+
+
+    struct Case
+    {
+        std::string_view valid;
+        std::string_view invalid;
+    };
+
+
+    constexpr std::array Cases {
+        Case { "name: \"svc\"\nport: 8080\nhost: \"example.org\"\n",
+               "name: \"svc\"\nport: 8080\nhost: \"example.org\n" },
+        Case { "name: \"svc\"\nport: 8080\nratio: 1e3\n",
+               "name: \"svc\"\nport: 8080\nratio: 1e\n" },
+        Case { "http:\n    port: 8080\n    host: \"example.org\"\n",
+               "http:\n    port: 8080\n  host: \"example.org\"\n" },
+    };
+
+
+    template <std::size_t T_Case>
+    void
+    accept(bench::State &state)
+    {
+        koncpp::Parser parser;
+        NullHandler    handler;
+
+        for (auto _ : state)
+        {
+            auto result { parser.try_parse(Cases[T_Case].valid, handler) };
+            bench::do_not_optimize(result);
+        }
+    }
+
+
+    template <std::size_t T_Case>
+    void
+    reject(bench::State &state)
+    {
+        koncpp::Parser parser;
+        NullHandler    handler;
+
+        for (auto _ : state)
+        {
+            auto result { parser.try_parse(Cases[T_Case].invalid, handler) };
+            bench::do_not_optimize(result);
+        }
+    }
+
+
+    template <std::size_t T_Case>
+    void
+    reject_throw(bench::State &state)
+    {
+        koncpp::Parser parser;
+        NullHandler    handler;
+
+        for (auto _ : state)
+        {
+            try
+            {
+                parser.parse(Cases[T_Case].invalid, handler);
+            }
+            catch (const koncpp::ParseError &error)
+            {
+                bench::do_not_optimize(error);
+            }
+        }
+    }
+
+
+    /* Every rejection directly follows the acceptance it is compared
+       against. */
+    constexpr std::array Benchmarks {
+        /* clang-format off */
+        bench::Benchmark { "string/accept",            "", accept<0> },
+        bench::Benchmark { "string/try_parse",         "string/accept", reject<0> },
+        bench::Benchmark { "string/parse",             "string/accept", reject_throw<0> },
+
+        bench::Benchmark { "number/accept",            "", accept<1> },
+        bench::Benchmark { "number/try_parse",         "number/accept", reject<1> },
+        bench::Benchmark { "number/parse",             "number/accept", reject_throw<1> },
+
+        bench::Benchmark { "indentation/accept",       "", accept<2> },
+        bench::Benchmark { "indentation/try_parse",    "indentation/accept", reject<2> },
+        bench::Benchmark { "indentation/parse",        "indentation/accept", reject_throw<2> },
+        /* clang-format on */
+    };
+}
+
+
+auto
+main(int argc, char **argv) -> int
+{
+    double min_time { 0.2 };
+
+    for (int i { 1 }; i < argc; i++)
+    {
+        std::string_view arg { argv[i] };
+        if (!arg.starts_with("--min-time=")) continue;
+
+        arg.remove_prefix(std::string_view { "--min-time=" }.size());
+        std::from_chars(arg.data(), arg.data() + arg.size(), min_time);
+    }
+
+    bench::run(Benchmarks, min_time);
+    return 0;
+}
@@ -0,0 +1,185 @@
+/*
+ * Value type microbenchmarks.
+ *
+ * Measures Integer, Float and Boolean against the scalar they wrap, so that
+ * the cost of the nullable wrappers is visible at a glance.
+ *
+ * usage: __types_bench [--min-time=SECONDS]
+ */
+
+#include <koncpp/types/boolean.hh>
+#include <koncpp/types/float.hh>
+#include <koncpp/types/integer.hh>
+
+#include <array>
+#include <charconv>
+#include <format>
+#include <utility>
+
+#include "micro.hh"
+
+using koncpp::types::Boolean;
+using koncpp::types::Float;
+using koncpp::types::Integer;
+
+
+namespace
+{
+    template <typename T_Type, typename T_Raw>
+    void
+    arithmetic(bench::State &state)
+    {
+        T_Type       a { static_cast<T_Raw>(1) };
+        const T_Type b { static_cast<T_Raw>(1) };
+        const T_Type c { static_cast<T_Raw>(3) };
+
+        for (auto _ : state)
+        {
+            bench::do_not_optimize(b);
+            a = a * b + c;
+            bench::do_not_optimize(a);
+        }
+    }
+
+
+    template <typename T_Type, typename T_Raw>
+    void
+    logic(bench::State &state)
+    {
+        T_Type       a { static_cast<T_Raw>(true) };
+        const T_Type b { static_cast<T_Raw>(true) };
+        const T_Type c { static_cast<T_Raw>(false) };
+
+        for (auto _ : state)
+        {
+            bench::do_not_optimize(b);
+            a = (a && b) || c;
+            bench::do_not_optimize(a);
+        }
+    }
+
+
+    template <typename T_Type, typename T_Raw>
+    void
+    compare(bench::State &state)
+    {
+        const T_Type a { static_cast<T_Raw>(1) };
+        const T_Type b { static_cast<T_Raw>(3) };
+
+        for (auto _ : state)
+        {
+            bench::do_not_optimize(a);
+            bench::do_not_optimize(a == b);
+            if constexpr (requires { a < b; })
+                bench::do_not_optimize(a < b);
+            else
+                bench::do_not_optimize(a != b);
+        }
+    }
+
+
+    template <typename T_Type, typename T_Raw>
+    void
+    construct(bench::State &state)
+    {
+        T_Raw raw { static_cast<T_Raw>(3) };
+
+        for (auto _ : state)
+        {
+            bench::do_not_optimize(raw);
+            T_Type value { raw };
+            bench::do_not_optimize(value);
+        }
+    }
+
+
+    template <typename T_Type, typename T_Raw>
+    void
+    move(bench::State &state)
+    {
+        T_Type a { static_cast<T_Raw>(3) };
+
+        for (auto _ : state)
+        {
+            T_Type b { std::move(a) };
+            bench::do_not_optimize(b);
+            a = std::move(b);
+            bench::do_not_optimize(a);
+        }
+    }
+
+
+    template <typename T_Type, typename T_Raw>
+    void
+    format(bench::State &state)
+    {
+        const T_Type value { static_cast<T_Raw>(-12345.5) };
+        std::array<char, 64> buffer {};
+
+        for (auto _ : state)
+        {
+            bench::do_not_optimize(value);
+            bench::do_not_optimize(
+                std::format_to(buffer.data(), "{}", value));
+        }
+    }
+
+
+    /* Every wrapped benchmark directly follows the baseline it is
+       compared against. */
+    constexpr std::array Benchmarks {
+        /* clang-format off */
+        bench::Benchmark { "int64/arithmetic",  "", arithmetic<std::int64_t, std::int64_t> },
+        bench::Benchmark { "Integer/arithmetic", "int64/arithmetic", arithmetic<Integer<>, std::int64_t> },
+        bench::Benchmark { "int64/compare",     "", compare<std::int64_t, std::int64_t> },
+        bench::Benchmark { "Integer/compare",   "int64/compare", compare<Integer<>, std::int64_t> },
+        bench::Benchmark { "int64/construct",   "", construct<std::int64_t, std::int64_t> },
+        bench::Benchmark { "Integer/construct", "int64/construct", construct<Integer<>, std::int64_t> },
+        bench::Benchmark { "int64/move",        "", move<std::int64_t, std::int64_t> },
+        bench::Benchmark { "Integer/move",      "int64/move", move<Integer<>, std::int64_t> },
+        bench::Benchmark { "int64/format",      "", format<std::int64_t, std::int64_t> },
+        bench::Benchmark { "Integer/format",    "int64/format", format<Integer<>, std::int64_t> },
+
+        bench::Benchmark { "double/arithmetic", "", arithmetic<double, double> },
+        bench::Benchmark { "Float/arithmetic",  "double/arithmetic", arithmetic<Float, double> },
+        bench::Benchmark { "double/compare",    "", compare<double, double> },
+        bench::Benchmark { "Float/compare",     "double/compare", compare<Float, double> },
+        bench::Benchmark { "double/construct",  "", construct<double, double> },
+        bench::Benchmark { "Float/construct",   "double/construct", construct<Float, double> },
+        bench::Benchmark { "double/move",       "", move<double, double> },
+        bench::Benchmark { "Float/move",        "double/move", move<Float, double> },
+        bench::Benchmark { "double/format",     "", format<double, double> },
+        bench::Benchmark { "Float/format",      "double/format", format<Float, double> },
+
+        bench::Benchmark { "bool/logic",        "", logic<bool, bool> },
+        bench::Benchmark { "Boolean/logic",     "bool/logic", logic<Boolean, bool> },
+        bench::Benchmark { "bool/compare",      "", compare<bool, bool> },
+        bench::Benchmark { "Boolean/compare",   "bool/compare", compare<Boolean, bool> },
+        bench::Benchmark { "bool/construct",    "", construct<bool, bool> },
+        bench::Benchmark { "Boolean/construct", "bool/construct", construct<Boolean, bool> },
+        bench::Benchmark { "bool/move",         "", move<bool, bool> },
+        bench::Benchmark { "Boolean/move",      "bool/move", move<Boolean, bool> },
+        bench::Benchmark { "bool/format",       "", format<bool, bool> },
+        bench::Benchmark { "Boolean/format",    "bool/format", format<Boolean, bool> },
+        /* clang-format on */
+    };
+}
+
+
+auto
+main(int argc, char **argv) -> int
+{
+    double min_time { 0.2 };
+
+    for (int i { 1 }; i < argc; i++)
+    {
+        std::string_view arg { argv[i] };
+        if (!arg.starts_with("--min-time=")) continue;
+
+        arg.remove_prefix(std::string_view { "--min-time=" }.size());
+        std::from_chars(arg.data(), arg.data() + arg.size(), min_time);
+    }
+
+    bench::run(Benchmarks, min_time);
+    return 0;
+}
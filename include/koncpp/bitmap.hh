@@ -0,0 +1,202 @@
+/**
+ * @file koncpp/bitmap.hh
+ * @copyright Copyright (C) 2025-2026 Kei <RQuarx@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef KONCPP_BITMAP__HH
+#define KONCPP_BITMAP__HH
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+
+namespace koncpp
+{
+    /**
+     * @brief A packed, growable sequence of bits.
+     *
+     * Bits are stored least significant first in 64-bit words. Bits past
+     * @c size() in the last word are always zero, so whole words can be
+     * combined and counted without masking the tail.
+     */
+    class Bitmap
+    {
+    public:
+        using Word = std::uint64_t;
+
+        static constexpr std::size_t WordBits { 64 };
+
+
+        Bitmap() = default;
+
+        explicit Bitmap(std::size_t size, bool value = false)
+            : m_words(word_count(size), value ? ~Word {} : Word {}),
+              m_size(size)
+        {
+            mf_trim();
+        }
+
+
+        [[nodiscard]]
+        static constexpr auto
+        word_count(std::size_t size) noexcept -> std::size_t
+        {
+            return (size + WordBits - 1) / WordBits;
+        }
+
+
+        [[nodiscard]]
+        auto
+        size() const noexcept -> std::size_t
+        {
+            return m_size;
+        }
+
+
+        [[nodiscard]]
+        auto
+        empty() const noexcept -> bool
+        {
+            return m_size == 0;
+        }
+
+
+        [[nodiscard]]
+        auto
+        test(std::size_t index) const noexcept -> bool
+        {
+            return ((m_words[index / WordBits] >> (index % WordBits)) & 1)
+                != 0;
+        }
+
+
+        void
+        set(std::size_t index, bool value = true) noexcept
+        {
+            const auto bit { Word { 1 } << (index % WordBits) };
+
+            if (value)
+                m_words[index / WordBits] |= bit;
+            else
+                m_words[index / WordBits] &= ~bit;
+        }
+
+
+        void
+        push_back(bool value)
+        {
+            if (m_size % WordBits == 0) m_words.push_back(0);
+            m_size++;
+            set(m_size - 1, value);
+        }
+
+
+        void
+        resize(std::size_t size, bool value = false)
+        {
+            const auto old { m_size };
+
+            m_words.resize(word_count(size), value ? ~Word {} : Word {});
+            m_size = size;
+
+            /* the tail of the old last word was kept zero */
+            if (value && size > old && old % WordBits != 0)
+                m_words[old / WordBits] |= ~Word {} << (old % WordBits);
+            mf_trim();
+        }
+
+
+        void
+        reserve(std::size_t size)
+        {
+            m_words.reserve(word_count(size));
+        }
+
+
+        /**
+         * @brief Returns how many bits fit without reallocating.
+         */
+        [[nodiscard]]
+        auto
+        capacity() const noexcept -> std::size_t
+        {
+            return m_words.capacity() * WordBits;
+        }
+
+
+        void
+        clear() noexcept
+        {
+            m_words.clear();
+            m_size = 0;
+        }
+
+
+        /**
+         * @brief Returns the number of set bits.
+         */
+        [[nodiscard]]
+        auto
+        count() const noexcept -> std::size_t
+        {
+            std::size_t result {};
+            for (const auto word : m_words) result += std::popcount(word);
+            return result;
+        }
+
+
+        [[nodiscard]]
+        auto
+        words() const noexcept -> std::span<const Word>
+        {
+            return m_words;
+        }
+
+
+        /**
+         * @brief Returns the words for in-place modification.
+         * @warning Bits past @c size() must be left zero.
+         */
+        [[nodiscard]]
+        auto
+        words() noexcept -> std::span<Word>
+        {
+            return m_words;
+        }
+
+
+        [[nodiscard]]
+        auto
+        operator==(const Bitmap &rhs) const noexcept -> bool
+            = default;
+
+
+    private:
+        std::vector<Word> m_words;
+        std::size_t       m_size {};
+
+
+        void
+        mf_trim() noexcept
+        {
+            if (m_size % WordBits != 0)
+                m_words.back() &= (Word { 1 } << (m_size % WordBits)) - 1;
+        }
+    };
+}
+
+#endif /* KONCPP_BITMAP__HH */
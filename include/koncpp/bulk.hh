@@ -0,0 +1,593 @@
+/**
+ * @file koncpp/bulk.hh
+ * @copyright Copyright (C) 2025-2026 Kei <RQuarx@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef KONCPP_BULK__HH
+#define KONCPP_BULK__HH
+#include <span>
+#include <vector>
+
+#include "koncpp/.defs.hh"
+#include "koncpp/bitmap.hh"
+#include "koncpp/value.hh"
+
+
+/**
+ * Bulk kernels over whole numeric and boolean arrays.
+ *
+ * A kon array is a vector of boxed values, so every operation on it pays for
+ * a variant dispatch per element. A @c Column unboxes an array once into a
+ * contiguous buffer and a validity bitmap, and a @c BooleanColumn packs a
+ * boolean array into two bitmaps. The kernels below then process them with
+ * AVX2 or AVX-512 when the CPU supports them.
+ *
+ * Null elements are propagated explicitly: aggregates skip them, element
+ * wise operations produce null wherever an operand is null, and comparisons
+ * never select them.
+ */
+namespace koncpp::bulk
+{
+    template <typename T_Type>
+    concept Element = std::same_as<T_Type, types::Signed>
+                   || std::same_as<T_Type, types::Unsigned>
+                   || std::same_as<T_Type, double>;
+
+
+    /**
+     * @brief A contiguous array of numbers with a validity bitmap.
+     *
+     * Null elements always hold zero in @c values() .
+     */
+    template <Element T_Type>
+    class Column
+    {
+    public:
+        Column() = default;
+
+        explicit Column(std::vector<T_Type> values)
+            : m_values(std::move(values)), m_validity(m_values.size(), true)
+        {
+        }
+
+        /**
+         * @throws ValueError if @p validity and @p values differ in size.
+         */
+        Column(std::vector<T_Type> values, Bitmap validity)
+            : m_values(std::move(values)), m_validity(std::move(validity))
+        {
+            if (m_values.size() != m_validity.size())
+                throw ValueError { "validity has {} bits for {} values",
+                                   m_validity.size(),
+                                   m_values.size() };
+            mf_zero_nulls();
+        }
+
+
+        /**
+         * @brief Unboxes a kon array.
+         *
+         * Integers are converted with the usual @c Integer range rules, so a
+         * negative number read into an unsigned column becomes null.
+         *
+         * @throws ValueError if @p array is not an array of numbers.
+         */
+        template <typename T_Allocator>
+        [[nodiscard]]
+        static auto
+        from(const Value<T_Allocator> &array) -> Column
+        {
+            using ValueT = Value<T_Allocator>;
+
+            const auto &elements { array.template get<
+                typename ValueT::Array>() };
+
+            Column result;
+            result.reserve(elements.size());
+
+            for (const auto &element : elements)
+            {
+                if (const auto *i {
+                        element.template get_if<types::Integer<>>() })
+                    result.push_back(mf_convert(i->get()));
+                else if (const auto *u { element.template get_if<
+                                         types::Integer<types::Unsigned>>() })
+                    result.push_back(mf_convert(u->get()));
+                else if (const auto *f {
+                             element.template get_if<types::Float>() })
+                {
+                    if constexpr (std::same_as<T_Type, double>)
+                        result.push_back(f->get());
+                    else
+                        throw ValueError { "cannot read a float into an "
+                                           "integer column" };
+                }
+                else if (element.is_null())
+                    result.push_back(std::nullopt);
+                else
+                    throw ValueError { "arrays of numbers only" };
+            }
+
+            return result;
+        }
+
+
+        /**
+         * @brief Boxes the column back into a kon array.
+         */
+        template <typename T_Allocator = std::allocator<char>>
+        [[nodiscard]]
+        auto
+        to_value() const -> Value<T_Allocator>
+        {
+            using ValueT = Value<T_Allocator>;
+            using Boxed  = std::conditional_t<std::same_as<T_Type, double>,
+                                              types::Float,
+                                              types::Integer<T_Type>>;
+
+            ValueT result { ValueType::Array };
+            auto  &elements { result.template get<typename ValueT::Array>() };
+            elements.reserve(size());
+
+            for (std::size_t i { 0 }; i < size(); i++)
+            {
+                if (m_validity.test(i))
+                    elements.emplace_back(Boxed { m_values[i] });
+                else if constexpr (std::same_as<T_Type, double>)
+                    elements.emplace_back(Boxed {});
+                else
+                    elements.emplace_back(Boxed { std::nullopt });
+            }
+
+            return result;
+        }
+
+
+        void
+        push_back(std::optional<T_Type> value)
+        {
+            m_values.push_back(value.value_or(T_Type {}));
+            m_validity.push_back(value.has_value());
+        }
+
+
+        void
+        reserve(std::size_t size)
+        {
+            m_values.reserve(size);
+            m_validity.reserve(size);
+        }
+
+
+        [[nodiscard]]
+        auto
+        size() const noexcept -> std::size_t
+        {
+            return m_values.size();
+        }
+
+
+        [[nodiscard]]
+        auto
+        get(std::size_t index) const noexcept -> std::optional<T_Type>
+        {
+            if (!m_validity.test(index)) return std::nullopt;
+            return m_values[index];
+        }
+
+
+        [[nodiscard]]
+        auto
+        values() const noexcept -> std::span<const T_Type>
+        {
+            return m_values;
+        }
+
+
+        [[nodiscard]]
+        auto
+        validity() const noexcept -> const Bitmap &
+        {
+            return m_validity;
+        }
+
+
+        [[nodiscard]]
+        auto
+        null_count() const noexcept -> std::size_t
+        {
+            return size() - m_validity.count();
+        }
+
+
+        [[nodiscard]]
+        auto
+        operator==(const Column &rhs) const -> bool
+            = default;
+
+
+    private:
+        std::vector<T_Type> m_values;
+        Bitmap              m_validity;
+
+
+        void
+        mf_zero_nulls() noexcept
+        {
+            const auto words { m_validity.words() };
+            const auto tail { size() % Bitmap::WordBits };
+
+            for (std::size_t w { 0 }; w < words.size(); w++)
+            {
+                auto nulls { ~words[w] };
+                if (w + 1 == words.size() && tail != 0)
+                    nulls &= (Bitmap::Word { 1 } << tail) - 1;
+
+                for (; nulls != 0; nulls &= nulls - 1)
+                    m_values[(w * Bitmap::WordBits) + std::countr_zero(nulls)]
+                        = T_Type {};
+            }
+        }
+
+
+        template <typename T_Int>
+        [[nodiscard]]
+        static auto
+        mf_convert(std::optional<T_Int> value) -> std::optional<T_Type>
+        {
+            if (!value) return std::nullopt;
+
+            if constexpr (std::same_as<T_Type, double>)
+                return static_cast<double>(*value);
+            else
+                return types::Integer<T_Type> { *value }.get();
+        }
+    };
+
+
+    /**
+     * @brief A boolean array packed into a value and a validity bitmap.
+     *
+     * Like @c types::Boolean , the combinators treat null as false and never
+     * produce null. An array packed by the @c Builder is already a
+     * @c types::BooleanArray , which the queries below take directly.
+     */
+    class BooleanColumn : public types::BooleanArray
+    {
+    public:
+        BooleanColumn() = default;
+
+        BooleanColumn(types::BooleanArray array)
+            : types::BooleanArray(std::move(array))
+        {
+        }
+
+        explicit BooleanColumn(Bitmap values)
+            : types::BooleanArray(std::move(values))
+        {
+        }
+
+        /**
+         * @throws ValueError if @p validity and @p values differ in size.
+         */
+        BooleanColumn(Bitmap values, Bitmap validity)
+            : types::BooleanArray(std::move(values), std::move(validity))
+        {
+            mf_check_size(this->values().size(), this->validity().size());
+        }
+
+
+        /**
+         * @brief Packs a kon array of booleans.
+         *
+         * Integers are accepted as booleans, SYNTAX.md §2.4. An array that is
+         * already packed has its bitmaps copied.
+         *
+         * @throws ValueError if @p array is not an array of booleans.
+         */
+        template <typename T_Allocator>
+        [[nodiscard]]
+        static auto
+        from(const Value<T_Allocator> &array) -> BooleanColumn
+        {
+            using ValueT = Value<T_Allocator>;
+
+            if (const auto *packed { array.template get_if<
+                                     types::BooleanArray>() })
+                return *packed;
+
+            const auto &elements { array.template get<
+                typename ValueT::Array>() };
+
+            BooleanColumn result;
+            result.reserve(elements.size());
+
+            for (const auto &element : elements)
+            {
+                if (const auto *b { element.template get_if<types::Boolean>() })
+                    result.push_back(b->get());
+                else if (const auto *i {
+                             element.template get_if<types::Integer<>>() })
+                    result.push_back(mf_to_bool(i->get()));
+                else if (const auto *u { element.template get_if<
+                                         types::Integer<types::Unsigned>>() })
+                    result.push_back(mf_to_bool(u->get()));
+                else if (element.is_null())
+                    result.push_back(std::nullopt);
+                else
+                    throw ValueError { "arrays of booleans only" };
+            }
+
+            return result;
+        }
+
+
+        /**
+         * @brief Unpacks the column back into a kon array.
+         */
+        template <typename T_Allocator = std::allocator<char>>
+        [[nodiscard]]
+        auto
+        to_value() const -> Value<T_Allocator>
+        {
+            using ValueT = Value<T_Allocator>;
+
+            ValueT result { ValueType::Array };
+            auto  &elements { result.template get<typename ValueT::Array>() };
+            elements.reserve(size());
+
+            for (std::size_t i { 0 }; i < size(); i++)
+                elements.emplace_back((*this)[i]);
+
+            return result;
+        }
+
+
+        /**
+         * @throws ValueError if the columns differ in size.
+         */
+        [[nodiscard]]
+        auto
+        operator&&(const BooleanColumn &rhs) const -> BooleanColumn
+        {
+            return mf_combine(rhs, [](auto a, auto b) { return a & b; });
+        }
+
+
+        /**
+         * @throws ValueError if the columns differ in size.
+         */
+        [[nodiscard]]
+        auto
+        operator||(const BooleanColumn &rhs) const -> BooleanColumn
+        {
+            return mf_combine(rhs, [](auto a, auto b) { return a | b; });
+        }
+
+
+        [[nodiscard]]
+        auto
+        operator==(const BooleanColumn &rhs) const noexcept -> bool
+            = default;
+
+
+    private:
+        static void
+        mf_check_size(std::size_t lhs, std::size_t rhs)
+        {
+            if (lhs != rhs)
+                throw ValueError { "sizes differ, {} and {}", lhs, rhs };
+        }
+
+
+        template <typename T_Int>
+        [[nodiscard]]
+        static auto
+        mf_to_bool(std::optional<T_Int> value) noexcept -> std::optional<bool>
+        {
+            if (!value) return std::nullopt;
+            return *value != 0;
+        }
+
+
+        /* Null value bits are clear, so whole words combine directly. */
+        template <typename T_Func>
+        auto
+        mf_combine(const BooleanColumn &rhs, T_Func func) const
+            -> BooleanColumn
+        {
+            mf_check_size(size(), rhs.size());
+
+            Bitmap     result { size() };
+            const auto out { result.words() };
+            const auto a { values().words() };
+            const auto b { rhs.values().words() };
+
+            for (std::size_t w { 0 }; w < out.size(); w++)
+                out[w] = func(a[w], b[w]);
+
+            return BooleanColumn { std::move(result) };
+        }
+    };
+
+
+    enum class Compare : std::uint8_t
+    {
+        Equal,
+        NotEqual,
+        Less,
+        LessEqual,
+        Greater,
+        GreaterEqual
+    };
+
+
+    /**
+     * @brief The instruction set used by the kernels.
+     */
+    enum class Isa : std::uint8_t
+    {
+        Scalar,
+        Avx2,
+        Avx512
+    };
+
+
+    /**
+     * @brief Returns the instruction set the kernels currently use.
+     *
+     * This is the best one supported by the CPU, unless lowered with
+     * @c set_isa() .
+     */
+    [[nodiscard]]
+    KONCPP_PUBLIC auto isa() noexcept -> Isa;
+
+
+    /**
+     * @brief Selects the instruction set used by the kernels, mainly for
+     *        testing and benchmarking.
+     * @returns The instruction set actually selected, which is never better
+     *          than what the CPU supports.
+     */
+    KONCPP_PUBLIC auto set_isa(Isa isa) noexcept -> Isa;
+
+
+    /**
+     * @brief Returns the sum of the non-null elements, or null if there are
+     *        none. Integer sums wrap around on overflow.
+     */
+    template <Element T_Type>
+    [[nodiscard]]
+    KONCPP_PUBLIC auto sum(const Column<T_Type> &column)
+        -> std::optional<T_Type>;
+
+
+    /**
+     * @brief Returns the smallest non-null element, or null if there are
+     *        none. NaNs are ignored.
+     */
+    template <Element T_Type>
+    [[nodiscard]]
+    KONCPP_PUBLIC auto min(const Column<T_Type> &column)
+        -> std::optional<T_Type>;
+
+
+    /**
+     * @brief Returns the largest non-null element, or null if there are
+     *        none. NaNs are ignored.
+     */
+    template <Element T_Type>
+    [[nodiscard]]
+    KONCPP_PUBLIC auto max(const Column<T_Type> &column)
+        -> std::optional<T_Type>;
+
+
+    /**
+     * @brief Multiplies every element by @p factor .
+     */
+    template <Element T_Type>
+    [[nodiscard]]
+    KONCPP_PUBLIC auto scale(const Column<T_Type> &column, T_Type factor)
+        -> Column<T_Type>;
+
+
+    /**
+     * @brief Adds two columns element by element.
+     * @throws ValueError if the columns differ in size.
+     */
+    template <Element T_Type>
+    [[nodiscard]]
+    KONCPP_PUBLIC auto add(const Column<T_Type> &lhs, const Column<T_Type> &rhs)
+        -> Column<T_Type>;
+
+
+    /**
+     * @brief Returns a bitmap of the non-null elements for which
+     *        `element <op> value` holds.
+     */
+    template <Element T_Type>
+    [[nodiscard]]
+    KONCPP_PUBLIC auto compare(const Column<T_Type> &column,
+                               Compare               op,
+                               T_Type                value) -> Bitmap;
+
+
+    /**
+     * @brief Returns the elements whose bit is set in @p mask , nulls
+     *        included.
+     * @throws ValueError if @p mask and @p column differ in size.
+     */
+    template <Element T_Type>
+    [[nodiscard]]
+    KONCPP_PUBLIC auto filter(const Column<T_Type> &column, const Bitmap &mask)
+        -> Column<T_Type>;
+
+
+    /**
+     * @brief Returns the number of set bits in @p bitmap .
+     */
+    [[nodiscard]]
+    KONCPP_PUBLIC auto count(const Bitmap &bitmap) noexcept -> std::size_t;
+
+
+    /**
+     * @brief Returns whether any bit of @p bitmap is set.
+     */
+    [[nodiscard]]
+    KONCPP_PUBLIC auto any(const Bitmap &bitmap) noexcept -> bool;
+
+
+    /**
+     * @brief Returns whether every bit of @p bitmap is set.
+     */
+    [[nodiscard]]
+    KONCPP_PUBLIC auto all(const Bitmap &bitmap) noexcept -> bool;
+
+
+    /**
+     * @brief Returns the number of true elements.
+     */
+    [[nodiscard]]
+    inline auto
+    count(const types::BooleanArray &array) noexcept -> std::size_t
+    {
+        return count(array.values());
+    }
+
+
+    /**
+     * @brief Returns whether any element is true.
+     */
+    [[nodiscard]]
+    inline auto
+    any(const types::BooleanArray &array) noexcept -> bool
+    {
+        return any(array.values());
+    }
+
+
+    /**
+     * @brief Returns whether every element is true, null counting as false.
+     */
+    [[nodiscard]]
+    inline auto
+    all(const types::BooleanArray &array) noexcept -> bool
+    {
+        return all(array.values());
+    }
+}
+
+#endif /* KONCPP_BULK__HH */
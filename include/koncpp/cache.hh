@@ -0,0 +1,178 @@
+/**
+ * @file koncpp/cache.hh
+ * @copyright Copyright (C) 2025-2026 Kei <RQuarx@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef KONCPP_CACHE__HH
+#define KONCPP_CACHE__HH
+#include <atomic>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+#include "koncpp/.defs.hh"
+#include "koncpp/parser.hh"
+
+
+namespace koncpp
+{
+    /**
+     * @brief Records the events of a parse as a tape, a flat encoding that
+     *        refers to nothing outside of itself.
+     */
+    class KONCPP_PUBLIC TapeRecorder : public Handler
+    {
+    public:
+        void key(std::string_view key) override;
+
+        void begin_object() override;
+        void end_object() override;
+        void begin_array() override;
+        void end_array() override;
+
+        void null() override;
+        void integer(types::Signed value) override;
+        void unsigned_integer(types::Unsigned value) override;
+        void floating(double value) override;
+        void boolean(bool value) override;
+        void string(std::string_view value) override;
+
+
+        [[nodiscard]]
+        auto
+        tape() const noexcept -> std::string_view
+        {
+            return m_tape;
+        }
+
+
+    private:
+        std::string m_tape;
+    };
+
+
+    /**
+     * @brief Returns whether @p tape is complete and well formed, so that
+     *        @c replay() can trust it.
+     */
+    [[nodiscard]]
+    KONCPP_PUBLIC auto valid_tape(std::string_view tape) noexcept -> bool;
+
+
+    /**
+     * @brief Reports the events recorded in @p tape to @p handler .
+     *
+     * The views passed to @p handler refer to @p tape .
+     *
+     * @warning @p tape must have been checked with @c valid_tape() .
+     */
+    KONCPP_PUBLIC void replay(std::string_view tape, Handler &handler);
+
+
+    /**
+     * @brief An on-disk cache of parsed documents, keyed by the hash of
+     *        their source.
+     *
+     * An entry holds a copy of the source and the tape of its document. A
+     * hit maps it into memory, compares the sources byte for byte, so that
+     * a hash collision is a miss, and replays the tape. Nothing is
+     * tokenized, unescaped or converted. A miss parses the source and
+     * stores its tape once the handler has taken it. Entries are written to a
+     * temporary file and renamed into place, so processes sharing the
+     * directory only ever see complete entries. An entry that does not
+     * match its source is treated as a miss and replaced.
+     */
+    class KONCPP_PUBLIC ParseCache
+    {
+    public:
+        /**
+         * @brief Uses @p directory for the entries, creating it if needed.
+         * @throws Exception if @p directory cannot be created.
+         */
+        explicit ParseCache(std::filesystem::path directory);
+
+
+        /**
+         * @brief Parses @p source , or replays its cached tape.
+         * @throws ParseError if @p source is not valid kon.
+         */
+        template <typename T_Allocator = std::allocator<char>>
+        [[nodiscard]]
+        auto
+        parse(std::string_view source) -> Value<T_Allocator>
+        {
+            Builder<T_Allocator> builder;
+            parse(source, builder);
+            return builder.take();
+        }
+
+
+        /**
+         * @brief Reports @p source to @p handler , from its cached tape if
+         *        there is one.
+         *
+         * Failing to store an entry is not an error, the next load parses
+         * the source again.
+         *
+         * @throws ParseError if @p source is not valid kon, or
+         *         @p handler rejects it with a @c ValueError , at the same
+         *         offset as @c Parser::parse() would report.
+         */
+        void parse(std::string_view source, Handler &handler);
+
+
+        /**
+         * @brief Returns where the entry of @p source is stored.
+         */
+        [[nodiscard]]
+        auto entry_path(std::string_view source) const
+            -> std::filesystem::path;
+
+
+        [[nodiscard]]
+        auto
+        hits() const noexcept -> std::size_t
+        {
+            return m_hits.load(std::memory_order_relaxed);
+        }
+
+
+        [[nodiscard]]
+        auto
+        misses() const noexcept -> std::size_t
+        {
+            return m_misses.load(std::memory_order_relaxed);
+        }
+
+
+    private:
+        std::filesystem::path    m_directory;
+        std::atomic<std::size_t> m_hits {};
+        std::atomic<std::size_t> m_misses {};
+
+
+        [[nodiscard]]
+        auto mf_entry(std::string_view source, std::uint64_t hash) const
+            -> std::filesystem::path;
+
+        void mf_store(const std::filesystem::path &entry,
+                      std::string_view             source,
+                      std::uint64_t                hash,
+                      std::string_view             tape) const;
+    };
+}
+
+#endif /* KONCPP_CACHE__HH */
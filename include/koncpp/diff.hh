@@ -0,0 +1,374 @@
+/**
+ * @file koncpp/diff.hh
+ * @copyright Copyright (C) 2025-2026 Kei <RQuarx@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef KONCPP_DIFF__HH
+#define KONCPP_DIFF__HH
+#include <bit>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "koncpp/value.hh"
+
+
+namespace koncpp
+{
+    /**
+     * @brief A tree of subtree hashes mirroring the shape of a @c Value .
+     *
+     * @c children holds one digest per object member, in member order.
+     * Arrays are hashed as a whole and have no children.
+     */
+    struct Digest
+    {
+        std::uint64_t       hash {};
+        std::vector<Digest> children;
+    };
+
+
+    /**
+     * @brief A single change between two documents.
+     *
+     * @c path is the dotted path of the changed member. @c value holds the
+     * new value for @c Added and @c Changed edits, and is null for
+     * @c Removed edits.
+     */
+    template <typename T_Allocator = std::allocator<char>>
+    struct Edit
+    {
+        enum class Kind : std::uint8_t
+        {
+            Added,
+            Removed,
+            Changed
+        };
+
+        Kind               kind;
+        std::string        path;
+        Value<T_Allocator> value;
+    };
+
+
+    template <typename T_Allocator = std::allocator<char>>
+    using Patch = std::vector<Edit<T_Allocator>>;
+
+
+    namespace detail
+    {
+        inline constexpr std::uint64_t FnvOffset { 0xcbf29ce484222325 };
+        inline constexpr std::uint64_t FnvPrime { 0x100000001b3 };
+
+
+        constexpr auto
+        fnv1a(std::uint64_t hash, std::string_view bytes) noexcept
+            -> std::uint64_t
+        {
+            for (const auto c : bytes)
+                hash = (hash ^ static_cast<std::uint8_t>(c)) * FnvPrime;
+            return hash;
+        }
+
+
+        constexpr auto
+        fnv1a(std::uint64_t hash, std::uint64_t word) noexcept -> std::uint64_t
+        {
+            for (int i { 0 }; i < 8; i++, word >>= 8)
+                hash = (hash ^ (word & 0xFF)) * FnvPrime;
+            return hash;
+        }
+
+
+        /* Which of the values sharing a ValueType a scalar holds. */
+        enum class Scalar : std::uint8_t
+        {
+            Signed,
+            Unsigned,
+            Float,
+            Boolean,
+            String
+        };
+
+
+        /*
+         * Hashes the kind of a scalar and whether it is null, then its
+         * bits, so that no value of one kind hashes like another kind or
+         * like null.
+         */
+        constexpr auto
+        scalar(std::uint64_t hash,
+               Scalar        kind,
+               bool          null,
+               std::uint64_t bits = 0) noexcept -> std::uint64_t
+        {
+            hash = fnv1a(hash, static_cast<std::uint64_t>(kind));
+            hash = fnv1a(hash, std::uint64_t { null ? 0U : 1U });
+            return null ? hash : fnv1a(hash, bits);
+        }
+
+
+        constexpr auto
+        mix(std::uint64_t hash) noexcept -> std::uint64_t
+        {
+            hash ^= hash >> 33;
+            hash *= 0xff51afd7ed558ccd;
+            hash ^= hash >> 33;
+            hash *= 0xc4ceb9fe1a85ec53;
+            hash ^= hash >> 33;
+            return hash;
+        }
+
+
+        inline auto
+        join(const std::string &prefix, std::string_view key) -> std::string
+        {
+            if (prefix.empty()) return std::string { key };
+
+            std::string path;
+            path.reserve(prefix.size() + 1 + key.size());
+            path.append(prefix).append(1, '.').append(key);
+            return path;
+        }
+    }
+
+
+    /**
+     * @brief Computes the digest of @p value and all of its members.
+     *
+     * Object hashes do not depend on member order.
+     */
+    template <typename T_Allocator>
+    [[nodiscard]]
+    auto
+    digest(const Value<T_Allocator> &value) -> Digest
+    {
+        using ValueT = Value<T_Allocator>;
+
+        Digest result;
+        auto   hash { detail::fnv1a(detail::FnvOffset,
+                                  static_cast<std::uint64_t>(value.type())) };
+
+        if (const auto *object { value.template get_if<
+                                 typename ValueT::Object>() })
+        {
+            result.children.reserve(object->size());
+
+            std::uint64_t members {};
+            for (const auto &member : *object)
+            {
+                auto child { digest(member.value) };
+                members += detail::mix(
+                    detail::fnv1a(detail::fnv1a(detail::FnvOffset, member.key),
+                                  child.hash));
+                result.children.push_back(std::move(child));
+            }
+
+            result.hash = detail::fnv1a(hash, members);
+            return result;
+        }
+
+        if (const auto *array { value.template get_if<
+                                typename ValueT::Array>() })
+        {
+            for (const auto &item : *array)
+                hash = detail::fnv1a(hash, digest(item).hash);
+        }
+        else if (const auto *packed { value.template get_if<
+                                      types::BooleanArray>() })
+        {
+            /* the same as the boxed array of these booleans */
+            for (std::size_t i { 0 }; i < packed->size(); i++)
+                hash = detail::fnv1a(hash,
+                                     digest(ValueT { (*packed)[i] }).hash);
+        }
+        else if (const auto *i { value.template get_if<types::Integer<>>() })
+            hash = detail::scalar(hash, detail::Scalar::Signed, !i->get(),
+                                  i->get() ? std::bit_cast<std::uint64_t>(
+                                                 *i->get())
+                                           : 0);
+        else if (const auto *u { value.template get_if<
+                                 types::Integer<types::Unsigned>>() })
+            hash = detail::scalar(hash, detail::Scalar::Unsigned, !u->get(),
+                                  u->get() ? *u->get() : 0);
+        else if (const auto *f { value.template get_if<types::Float>() })
+            hash = detail::scalar(hash, detail::Scalar::Float, !f->get(),
+                                  f->get() ? std::bit_cast<std::uint64_t>(
+                                                 *f->get())
+                                           : 0);
+        else if (const auto *b { value.template get_if<types::Boolean>() })
+            hash = detail::scalar(hash, detail::Scalar::Boolean, !b->get(),
+                                  b->get() ? std::uint64_t { *b->get() } : 0);
+        else if (const auto *s { value.template get_if<
+                                 typename ValueT::StringType>() })
+        {
+            hash = detail::scalar(hash, detail::Scalar::String, !s->view());
+            if (s->view()) hash = detail::fnv1a(hash, *s->view());
+        }
+
+        result.hash = hash;
+        return result;
+    }
+
+
+    namespace detail
+    {
+        template <typename T_Allocator>
+        void
+        diff(const Value<T_Allocator> &from,
+             const Digest             &from_digest,
+             const Value<T_Allocator> &to,
+             const Digest             &to_digest,
+             const std::string        &path,
+             Patch<T_Allocator>       &patch)
+        {
+            using ValueT = Value<T_Allocator>;
+            using Kind   = Edit<T_Allocator>::Kind;
+
+            if (from_digest.hash == to_digest.hash) return;
+
+            const auto *lhs { from.template get_if<typename ValueT::Object>() };
+            const auto *rhs { to.template get_if<typename ValueT::Object>() };
+
+            if (lhs == nullptr || rhs == nullptr)
+            {
+                patch.push_back({ Kind::Changed, path, to });
+                return;
+            }
+
+            std::unordered_map<std::string_view, std::size_t> index;
+            index.reserve(lhs->size());
+            for (std::size_t i { 0 }; i < lhs->size(); i++)
+                index.emplace((*lhs)[i].key, i);
+
+            for (std::size_t i { 0 }; i < rhs->size(); i++)
+            {
+                const auto &member { (*rhs)[i] };
+                auto        child { join(path, member.key) };
+
+                const auto it { index.find(member.key) };
+                if (it == index.end())
+                {
+                    patch.push_back(
+                        { Kind::Added, std::move(child), member.value });
+                    continue;
+                }
+
+                diff((*lhs)[it->second].value,
+                     from_digest.children[it->second],
+                     member.value,
+                     to_digest.children[i],
+                     child,
+                     patch);
+                index.erase(it);
+            }
+
+            for (const auto &member : *lhs)
+                if (index.contains(member.key))
+                    patch.push_back(
+                        { Kind::Removed, join(path, member.key), {} });
+        }
+    }
+
+
+    /**
+     * @brief Computes the edit script that turns @p from into @p to .
+     *
+     * Subtrees with equal digests are skipped without being visited, so
+     * with digests kept from a previous load the cost is proportional to
+     * the changed members rather than the document size. Arrays are
+     * compared as a whole.
+     */
+    template <typename T_Allocator>
+    [[nodiscard]]
+    auto
+    diff(const Value<T_Allocator> &from,
+         const Digest             &from_digest,
+         const Value<T_Allocator> &to,
+         const Digest             &to_digest) -> Patch<T_Allocator>
+    {
+        Patch<T_Allocator> patch;
+        detail::diff(from, from_digest, to, to_digest, {}, patch);
+        return patch;
+    }
+
+
+    template <typename T_Allocator>
+    [[nodiscard]]
+    auto
+    diff(const Value<T_Allocator> &from, const Value<T_Allocator> &to)
+        -> Patch<T_Allocator>
+    {
+        return diff(from, digest(from), to, digest(to));
+    }
+
+
+    /**
+     * @brief Applies the edits of @p patch to @p document in order.
+     *
+     * Missing intermediate objects are created for @c Added and @c Changed
+     * edits. An edit with an empty path replaces the whole document.
+     *
+     * @throws ValueError if a path runs through a value that is not an
+     *         object.
+     */
+    template <typename T_Allocator>
+    void
+    apply_patch(Value<T_Allocator> &document, const Patch<T_Allocator> &patch)
+    {
+        using Kind = Edit<T_Allocator>::Kind;
+
+        for (const auto &edit : patch)
+        {
+            if (edit.path.empty())
+            {
+                document = edit.value;
+                continue;
+            }
+
+            auto             *node { &document };
+            std::string_view  path { edit.path };
+            std::size_t       dot;
+
+            while ((dot = path.find('.')) != std::string_view::npos)
+            {
+                const auto key { path.substr(0, dot) };
+                path.remove_prefix(dot + 1);
+
+                auto *next { node->find(key) };
+                if (next == nullptr)
+                {
+                    if (edit.kind == Kind::Removed) break;
+                    next = &node->insert(key, {});
+                }
+                node = next;
+            }
+
+            if (edit.kind == Kind::Removed)
+            {
+                if (dot == std::string_view::npos) node->erase(path);
+                continue;
+            }
+
+            if (!node->is_null() && node->type() != ValueType::Object)
+                throw ValueError { "'{}' does not lead through objects",
+                                   edit.path };
+            node->insert(path, edit.value);
+        }
+    }
+}
+
+#endif /* KONCPP_DIFF__HH */
@@ -0,0 +1,146 @@
+/**
+ * @file koncpp/error.hh
+ * @copyright Copyright (C) 2025-2026 Kei <RQuarx@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef KONCPP_ERROR__HH
+#define KONCPP_ERROR__HH
+#include <cstdint>
+#include <format>
+#include <string>
+#include <string_view>
+
+#include "koncpp/location.hh"
+
+
+namespace koncpp
+{
+    /**
+     * @brief What went wrong, for the @c std::expected based functions.
+     *
+     * Unlike the exceptions, an error code is a plain value. Nothing is
+     * allocated or formatted until a message is asked for.
+     */
+    enum class ErrorCode : std::uint8_t
+    {
+        /* parsing */
+        UnexpectedContent,
+        UnterminatedComment,
+        UnterminatedString,
+        InconsistentIndentation,
+        InvalidIdentifier,
+        UnexpectedIdentifier,
+        ExpectedColon,
+        ExpectedNewLine,
+        ExpectedArraySeparator,
+        ExpectedObjectSeparator,
+        ExpectedValue,
+        MixedArray,
+        InvalidNumber,
+        IntegerOutOfRange,
+        InvalidValue,
+        NestingTooDeep,
+
+        /* arithmetic */
+        NullOperand,
+        DivisionByZero,
+        Overflow
+    };
+
+
+    /**
+     * @brief Returns a static description of @p code .
+     */
+    [[nodiscard]]
+    constexpr auto
+    describe(ErrorCode code) noexcept -> std::string_view
+    {
+        switch (code)
+        {
+        case ErrorCode::UnexpectedContent:   return "unexpected content";
+        case ErrorCode::UnterminatedComment: return "unterminated comment";
+        case ErrorCode::UnterminatedString:  return "unterminated string";
+        case ErrorCode::InconsistentIndentation:
+            return "inconsistent indentation";
+        case ErrorCode::InvalidIdentifier:
+            return "identifiers must start with a letter";
+        case ErrorCode::UnexpectedIdentifier: return "unexpected identifier";
+        case ErrorCode::ExpectedColon:        return "expected ':' after a key";
+        case ErrorCode::ExpectedNewLine:
+            return "expected a new line after a value";
+        case ErrorCode::ExpectedArraySeparator:  return "expected ',' or ']'";
+        case ErrorCode::ExpectedObjectSeparator: return "expected ';' or '}'";
+        case ErrorCode::ExpectedValue:           return "expected a value";
+        case ErrorCode::MixedArray:
+            return "arrays must contain a single data type";
+        case ErrorCode::InvalidNumber:     return "invalid number";
+        case ErrorCode::IntegerOutOfRange: return "integer out of range";
+        case ErrorCode::InvalidValue:      return "invalid value";
+        case ErrorCode::NestingTooDeep:    return "nesting too deep";
+        case ErrorCode::NullOperand:       return "operation on a null value";
+        case ErrorCode::DivisionByZero:    return "division by zero";
+        case ErrorCode::Overflow:          return "overflow";
+        }
+        return "unknown error";
+    }
+
+
+    /**
+     * @brief An error code and the byte offset in the source it refers to.
+     */
+    struct Error
+    {
+        ErrorCode   code;
+        std::size_t offset {};
+
+
+        /**
+         * @brief Formats a message, only when it is actually needed.
+         */
+        [[nodiscard]]
+        auto
+        message() const -> std::string
+        {
+            return std::format("{} at byte {}", describe(code), offset);
+        }
+
+
+        /**
+         * @brief Formats a message with the line and column of the error in
+         *        @p source , which is only scanned now.
+         */
+        [[nodiscard]]
+        auto
+        message(std::string_view source) const -> std::string
+        {
+            return std::format("{}: {}", location(source), describe(code));
+        }
+
+
+        [[nodiscard]]
+        auto
+        location(std::string_view source) const noexcept -> Location
+        {
+            return locate(source, offset);
+        }
+
+
+        [[nodiscard]]
+        auto operator==(const Error &rhs) const noexcept -> bool = default;
+    };
+}
+
+#endif /* KONCPP_ERROR__HH */
@@ -0,0 +1,382 @@
+/**
+ * @file koncpp/index.hh
+ * @copyright Copyright (C) 2025-2026 Kei <RQuarx@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef KONCPP_INDEX__HH
+#define KONCPP_INDEX__HH
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "koncpp/.defs.hh"
+#include "koncpp/parser.hh"
+#include "koncpp/path.hh"
+
+
+namespace koncpp
+{
+    struct IndexError : public Exception
+    {
+        using Exception::Exception;
+    };
+
+
+    /**
+     * @brief Identifies the contents of a file an index was built from.
+     */
+    struct FileStamp
+    {
+        std::uint64_t size {};
+        std::int64_t  mtime {};  /* in ticks of the file clock */
+        std::uint64_t hash {};   /* of the contents, see hash_contents() */
+        std::uint64_t sample {}; /* of some blocks, see hash_sample() */
+
+
+        [[nodiscard]]
+        auto operator==(const FileStamp &rhs) const noexcept -> bool
+            = default;
+    };
+
+
+    /**
+     * @brief Returns a fast, non-cryptographic hash of @p contents .
+     */
+    [[nodiscard]]
+    KONCPP_PUBLIC auto hash_contents(std::string_view contents) noexcept
+        -> std::uint64_t;
+
+
+    /**
+     * @brief Returns the hash of a fixed number of blocks spread evenly over
+     *        @p contents , the first and the last included.
+     *
+     * It reads the same few pages however large the file is, and equals
+     * @c hash_contents() for files no larger than the blocks together.
+     */
+    [[nodiscard]]
+    KONCPP_PUBLIC auto hash_sample(std::string_view contents) noexcept
+        -> std::uint64_t;
+
+
+    /**
+     * @brief Where the members of a kon source are written: those of the
+     *        root, and those of the objects they hold.
+     *
+     * The index is saved in a sidecar file next to the source, in the byte
+     * order of the machine that wrote it.
+     */
+    struct KONCPP_PUBLIC SourceIndex
+    {
+        static constexpr std::uint32_t NoParent { 0xFFFFFFFF };
+
+
+        struct Entry
+        {
+            std::string   key; /* as written, possibly dotted */
+            std::uint64_t begin;
+            std::uint64_t end;
+            std::uint32_t parent; /* NoParent for members of the root */
+
+
+            [[nodiscard]]
+            auto operator==(const Entry &rhs) const noexcept -> bool
+                = default;
+        };
+
+
+        FileStamp          stamp;
+        std::vector<Entry> entries;
+
+
+        /**
+         * @brief Indexes @p source , leaving the stamp empty.
+         * @throws ParseError if the structure of @p source is not valid.
+         */
+        [[nodiscard]]
+        static auto build(std::string_view source) -> SourceIndex;
+
+        /**
+         * @throws IndexError if the sidecar cannot be read or is corrupt.
+         */
+        [[nodiscard]]
+        static auto read(const std::filesystem::path &path) -> SourceIndex;
+
+        /**
+         * @throws IndexError if the sidecar cannot be written.
+         */
+        void write(const std::filesystem::path &path) const;
+    };
+
+
+    /**
+     * @brief Returns where the index of @p file is kept.
+     */
+    [[nodiscard]]
+    KONCPP_PUBLIC auto sidecar_path(const std::filesystem::path &file)
+        -> std::filesystem::path;
+
+
+    /**
+     * @brief Indexes @p file , stamps it and writes its sidecar.
+     * @throws ParseError if the structure of the file is not valid.
+     * @throws IndexError if the file cannot be read or the sidecar written.
+     */
+    KONCPP_PUBLIC auto write_index(const std::filesystem::path &file)
+        -> SourceIndex;
+
+
+    /**
+     * @brief How much of a file @c open_indexed() compares to its stamp.
+     */
+    enum class Verify : std::uint8_t
+    {
+        Stamp,   /* its size and modification time */
+        Sample,  /* and the hash of a sample of its blocks */
+        Contents /* and the hash of its contents, which reads all of it */
+    };
+
+
+    namespace detail
+    {
+        /* The contents of a file, mapped into memory where possible. */
+        class KONCPP_PUBLIC FileContents
+        {
+        public:
+            explicit FileContents(const std::filesystem::path &path);
+            ~FileContents();
+
+            FileContents(FileContents &&other) noexcept;
+
+            FileContents(const FileContents &)                     = delete;
+            auto operator=(const FileContents &) -> FileContents & = delete;
+            auto operator=(FileContents &&) -> FileContents &      = delete;
+
+
+            [[nodiscard]]
+            auto
+            view() const noexcept -> std::string_view
+            {
+                return { m_data, m_size };
+            }
+
+
+        private:
+            const char *m_data {};
+            std::size_t m_size {};
+            bool        m_mapped {};
+        };
+
+
+        /* Forwards every event but the outermost object's, to parse a
+           fragment into an object that is already open. */
+        class Nested : public Handler
+        {
+        public:
+            explicit Nested(Handler &handler) : m_handler(handler) {}
+
+
+            void
+            key(std::string_view key) override
+            {
+                m_handler.key(key);
+            }
+
+
+            void
+            begin_object() override
+            {
+                if (m_depth++ > 0) m_handler.begin_object();
+            }
+
+
+            void
+            end_object() override
+            {
+                if (--m_depth > 0) m_handler.end_object();
+            }
+
+
+            void
+            begin_array() override
+            {
+                m_handler.begin_array();
+            }
+
+
+            void
+            end_array() override
+            {
+                m_handler.end_array();
+            }
+
+
+            void
+            null() override
+            {
+                m_handler.null();
+            }
+
+
+            void
+            integer(types::Signed value) override
+            {
+                m_handler.integer(value);
+            }
+
+
+            void
+            unsigned_integer(types::Unsigned value) override
+            {
+                m_handler.unsigned_integer(value);
+            }
+
+
+            void
+            floating(double value) override
+            {
+                m_handler.floating(value);
+            }
+
+
+            void
+            boolean(bool value) override
+            {
+                m_handler.boolean(value);
+            }
+
+
+            void
+            string(std::string_view value) override
+            {
+                m_handler.string(value);
+            }
+
+
+        private:
+            Handler    &m_handler;
+            std::size_t m_depth {};
+        };
+    }
+
+
+    /**
+     * @brief A kon file opened through its index, parsed a subtree at a
+     *        time.
+     */
+    class KONCPP_PUBLIC IndexedFile
+    {
+    public:
+        /* A part of the source, and the key of the member it belongs in. */
+        struct Fragment
+        {
+            std::string_view text;
+            std::string_view parent;
+        };
+
+
+        IndexedFile(detail::FileContents contents, SourceIndex index);
+
+
+        [[nodiscard]]
+        auto
+        source() const noexcept -> std::string_view
+        {
+            return m_contents.view();
+        }
+
+
+        [[nodiscard]]
+        auto
+        index() const noexcept -> const SourceIndex &
+        {
+            return m_index;
+        }
+
+
+        /**
+         * @brief Returns the fragments of the source that hold @p path , in
+         *        source order.
+         */
+        [[nodiscard]]
+        auto fragments(const Path &path) const -> std::vector<Fragment>;
+
+
+        /**
+         * @brief Parses the value at @p path , and nothing outside of it.
+         * @throws ParseError if a fragment holding it is not valid kon.
+         * @throws ValueError if there is no value at @p path .
+         */
+        template <typename T_Allocator = std::allocator<char>>
+        [[nodiscard]]
+        auto
+        get(const Path &path) const -> Value<T_Allocator>
+        {
+            Parser               parser;
+            Builder<T_Allocator> builder;
+            detail::Nested       nested { builder };
+
+            builder.begin_object();
+            for (const auto &fragment : fragments(path))
+            {
+                if (!fragment.parent.empty())
+                {
+                    builder.key(fragment.parent);
+                    builder.begin_object();
+                }
+
+                parser.parse(fragment.text, nested);
+
+                if (!fragment.parent.empty()) builder.end_object();
+            }
+            builder.end_object();
+
+            auto root { builder.take() };
+            return std::move(root.at(path));
+        }
+
+
+    private:
+        detail::FileContents m_contents;
+        SourceIndex          m_index;
+
+        /* The members of the root by the first segment of their key. */
+        std::unordered_map<std::string_view, std::vector<std::uint32_t>>
+            m_roots;
+    };
+
+
+    /**
+     * @brief Opens @p file through the index written by @c write_index() .
+     *
+     * The file is mapped into memory and nothing is parsed until asked for.
+     * By default a sample of its blocks is hashed as well as its size and
+     * modification time compared, which catches most edits that keep the
+     * size within the resolution of the time, without reading the whole
+     * file. @c Verify::Contents hashes all of it, to catch every edit.
+     *
+     * @throws IndexError if there is no index, or it does not match the file.
+     */
+    [[nodiscard]]
+    KONCPP_PUBLIC auto open_indexed(const std::filesystem::path &file,
+                                    Verify verify = Verify::Sample)
+        -> IndexedFile;
+}
+
+#endif /* KONCPP_INDEX__HH */
@@ -0,0 +1,281 @@
+/**
+ * @file koncpp/json.hh
+ * @copyright Copyright (C) 2025-2026 Kei <RQuarx@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef KONCPP_JSON__HH
+#define KONCPP_JSON__HH
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "koncpp/.defs.hh"
+#include "koncpp/parser.hh"
+
+
+namespace koncpp
+{
+    struct JsonError : public Exception
+    {
+        JsonError(std::string_view message, std::size_t offset)
+            : Exception("{} at byte {}", message, offset), m_offset(offset)
+        {
+        }
+
+
+        /**
+         * @brief Returns the byte offset of the error in the source.
+         */
+        [[nodiscard]]
+        auto
+        offset() const noexcept -> std::size_t
+        {
+            return m_offset;
+        }
+
+
+    private:
+        std::size_t m_offset;
+    };
+
+
+    namespace detail
+    {
+        /* Text written in chunks, so that a writer's memory does not grow
+           with its output. */
+        class KONCPP_PUBLIC Sink
+        {
+        public:
+            static constexpr std::size_t ChunkSize { 64 * 1024 };
+
+
+            explicit Sink(std::ostream &out) : m_out(out) {}
+
+
+            void
+            put(char c)
+            {
+                m_chunk.push_back(c);
+                if (m_chunk.size() >= ChunkSize) flush();
+            }
+
+
+            void
+            put(std::string_view text)
+            {
+                m_chunk.append(text);
+                if (m_chunk.size() >= ChunkSize) flush();
+            }
+
+
+            void flush();
+
+
+        private:
+            std::ostream &m_out;
+            std::string   m_chunk;
+        };
+    }
+
+
+    /**
+     * @brief A @c Handler that writes the events it receives as JSON.
+     *
+     * Comments are not reported by the parser and are dropped. Dotted keys
+     * become nested objects, and consecutive keys sharing a prefix are
+     * written into the same object, so that @c "a.b: 1" followed by
+     * @c "a.c: 2" becomes @c {"a":{"b":1,"c":2}} . Merging the members of
+     * an object defined in separate places would mean holding the document,
+     * so those are written as repeated names instead.
+     *
+     * Nulls, including those of out of range unsigned integers, are written
+     * as @c null . The writer's own memory is bounded by the nesting depth
+     * of the document.
+     */
+    class KONCPP_PUBLIC JsonWriter : public Handler
+    {
+    public:
+        explicit JsonWriter(std::ostream &out) : m_sink(out) {}
+
+
+        void key(std::string_view key) override;
+
+        void begin_object() override;
+        void end_object() override;
+        void begin_array() override;
+        void end_array() override;
+
+        void null() override;
+        void integer(types::Signed value) override;
+        void unsigned_integer(types::Unsigned value) override;
+        void floating(double value) override;
+        void boolean(bool value) override;
+        void string(std::string_view value) override;
+
+
+        /**
+         * @brief Writes out what is still buffered.
+         */
+        void
+        flush()
+        {
+            m_sink.flush();
+        }
+
+
+    private:
+        enum class FrameKind : std::uint8_t
+        {
+            Object,
+            Array,
+            Dotted /* an object opened by a dotted key */
+        };
+
+        struct Frame
+        {
+            FrameKind   kind;
+            bool        first;
+            std::size_t name; /* where a dotted frame's name starts */
+        };
+
+        detail::Sink       m_sink;
+        std::vector<Frame> m_frames;
+        std::string        m_names; /* of the open dotted frames */
+
+
+        void mf_member(std::string_view name);
+        void mf_value();
+        void mf_close_dotted(std::size_t keep);
+        void mf_string(std::string_view value);
+    };
+
+
+    /**
+     * @brief A @c Handler that writes the events it receives as kon.
+     *
+     * Objects in objects are written as indented blocks, and those in
+     * arrays inline. The events must describe an object, with keys that are
+     * valid kon identifiers and arrays holding a single type.
+     *
+     * @throws ValueError from the events that cannot be written as kon.
+     */
+    class KONCPP_PUBLIC KonWriter : public Handler
+    {
+    public:
+        static constexpr std::size_t IndentWidth { 4 };
+
+
+        explicit KonWriter(std::ostream &out) : m_sink(out) {}
+
+
+        void key(std::string_view key) override;
+
+        void begin_object() override;
+        void end_object() override;
+        void begin_array() override;
+        void end_array() override;
+
+        void null() override;
+        void integer(types::Signed value) override;
+        void unsigned_integer(types::Unsigned value) override;
+        void floating(double value) override;
+        void boolean(bool value) override;
+        void string(std::string_view value) override;
+
+
+        void
+        flush()
+        {
+            m_sink.flush();
+        }
+
+
+    private:
+        enum class ValueKind : std::uint8_t
+        {
+            None,
+            Null,
+            Boolean,
+            Integer,
+            Float,
+            String,
+            Array,
+            Object
+        };
+
+        enum class FrameKind : std::uint8_t
+        {
+            Block,
+            Inline,
+            Array
+        };
+
+        struct Frame
+        {
+            FrameKind   kind;
+            bool        first;
+            ValueKind   items; /* the type of an array's items */
+            std::size_t level; /* the indentation of a block's members */
+        };
+
+        detail::Sink       m_sink;
+        std::vector<Frame> m_frames;
+
+
+        void mf_begin(ValueKind kind);
+        void mf_end();
+        void mf_string(std::string_view value);
+    };
+
+
+    /**
+     * @brief Reads the JSON document @p source and reports it to
+     *        @p handler , without building it.
+     *
+     * Strings without escape sequences are passed as views of @p source ,
+     * and numbers that do not fit a 64-bit integer are reported as floats.
+     *
+     * @throws JsonError if @p source is not valid JSON, nests objects and
+     *         arrays deeper than @c MaxDepth , or @p handler throws a
+     *         @c ValueError .
+     */
+    KONCPP_PUBLIC void parse_json(std::string_view source, Handler &handler);
+
+
+    /**
+     * @brief Writes the kon document @p source as JSON to @p out .
+     *
+     * The document is not built, but the parser measures the indentation
+     * of every line of @p source first, so memory grows with its number of
+     * lines as well as with its nesting depth.
+     *
+     * @throws ParseError if @p source is not valid kon, or nests deeper
+     *         than @c MaxDepth .
+     */
+    KONCPP_PUBLIC void kon_to_json(std::string_view source, std::ostream &out);
+
+
+    /**
+     * @brief Writes the JSON document @p source as kon to @p out .
+     * @throws JsonError if @p source is not valid JSON, nests deeper than
+     *         @c MaxDepth , or cannot be written as kon.
+     */
+    KONCPP_PUBLIC void json_to_kon(std::string_view source, std::ostream &out);
+}
+
+#endif /* KONCPP_JSON__HH */
@@ -0,0 +1,147 @@
+/**
+ * @file koncpp/loader.hh
+ * @copyright Copyright (C) 2025-2026 Kei <RQuarx@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef KONCPP_LOADER__HH
+#define KONCPP_LOADER__HH
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "koncpp/.defs.hh"
+#include "koncpp/parser.hh"
+
+
+namespace koncpp
+{
+    struct LoadError : public Exception
+    {
+        using Exception::Exception;
+    };
+
+
+    /**
+     * @brief How the files of a directory are read.
+     */
+    enum class LoadMethod : std::uint8_t
+    {
+        Automatic, /* io_uring where the kernel allows it, else Threads */
+        IoUring,   /* batched opens and reads, throws LoadError without it */
+        Threads    /* a pool of threads reading each file with pread */
+    };
+
+
+    struct LoadOptions
+    {
+        LoadMethod       method { LoadMethod::Automatic };
+        std::string_view extension { ".kon" };
+
+        /* The threads parsing the files, 0 for one per core. */
+        std::size_t threads {};
+
+        /* The most files read at once through io_uring. */
+        std::size_t batch { 64 };
+    };
+
+
+    /**
+     * @brief A file loaded by @c load_directory() .
+     */
+    template <typename T_Allocator = std::allocator<char>>
+    struct Loaded
+    {
+        std::filesystem::path path;
+        Value<T_Allocator>    document;
+    };
+
+
+    namespace detail
+    {
+        /* Receives the index and contents of a file on a parsing thread. */
+        using Consumer = std::function<void(std::size_t, std::string_view)>;
+
+
+        /**
+         * @brief Returns the regular files with @p extension in
+         *        @p directory , sorted by name.
+         * @throws LoadError if @p directory cannot be listed.
+         */
+        [[nodiscard]]
+        KONCPP_PUBLIC auto list_files(const std::filesystem::path &directory,
+                                      std::string_view             extension)
+            -> std::vector<std::filesystem::path>;
+
+
+        /**
+         * @brief Reads @p files and passes each one to @p consume as soon as
+         *        it has been read, on one of the parsing threads.
+         *
+         * Every file is consumed or failed before returning.
+         *
+         * @throws LoadError or the exception thrown by @p consume , for the
+         *         first file in @p files that failed.
+         * @returns The method that was used.
+         */
+        KONCPP_PUBLIC auto
+        load_files(std::span<const std::filesystem::path> files,
+                   const LoadOptions                     &options,
+                   const Consumer                        &consume)
+            -> LoadMethod;
+    }
+
+
+    /**
+     * @brief Parses every kon file in @p directory , in parallel.
+     *
+     * Reading and parsing overlap: a file is parsed as soon as it has been
+     * read, while the others are still being read. The documents are
+     * built on the parsing threads.
+     *
+     * @throws LoadError if a file cannot be read.
+     * @throws ParseError if a file is not valid kon. The error of the first
+     *         file by name is thrown, once every file has been tried.
+     * @returns The documents, sorted by the name of their file.
+     */
+    template <typename T_Allocator = std::allocator<char>>
+    [[nodiscard]]
+    auto
+    load_directory(const std::filesystem::path &directory,
+                   const LoadOptions           &options = {})
+        -> std::vector<Loaded<T_Allocator>>
+    {
+        auto files { detail::list_files(directory, options.extension) };
+
+        std::vector<Loaded<T_Allocator>> result(files.size());
+        (void)detail::load_files(
+            files, options,
+            [&](std::size_t index, std::string_view contents)
+            {
+                thread_local Parser  parser;
+                Builder<T_Allocator> builder;
+
+                parser.parse(contents, builder);
+                result[index] = { std::move(files[index]), builder.take() };
+            });
+
+        return result;
+    }
+}
+
+#endif /* KONCPP_LOADER__HH */
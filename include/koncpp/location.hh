@@ -0,0 +1,118 @@
+/**
+ * @file koncpp/location.hh
+ * @copyright Copyright (C) 2025-2026 Kei <RQuarx@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef KONCPP_LOCATION__HH
+#define KONCPP_LOCATION__HH
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include "koncpp/.defs.hh"
+
+
+namespace koncpp
+{
+    /**
+     * @brief A one-based line and column in a source.
+     *
+     * Columns count UTF-8 code points, so they match what an editor shows
+     * for text without tabs.
+     */
+    struct Location
+    {
+        std::size_t line { 1 };
+        std::size_t column { 1 };
+
+
+        [[nodiscard]]
+        auto operator==(const Location &rhs) const noexcept -> bool = default;
+    };
+
+
+    /**
+     * @brief Resolves byte offsets in a source to line and column.
+     *
+     * The parser only keeps byte offsets. Lines are found when a location is
+     * actually needed, by building this index once and binary searching it.
+     * @c locate() is cheaper for a single lookup.
+     *
+     * @warning The index refers to @p source , which must outlive it.
+     */
+    class KONCPP_PUBLIC LineIndex
+    {
+    public:
+        explicit LineIndex(std::string_view source);
+
+
+        /**
+         * @brief Returns the location of @p offset , which is clamped to the
+         *        end of the source.
+         */
+        [[nodiscard]]
+        auto locate(std::size_t offset) const noexcept -> Location;
+
+
+        [[nodiscard]]
+        auto
+        line_count() const noexcept -> std::size_t
+        {
+            return m_starts.size();
+        }
+
+
+        /**
+         * @brief Returns the text of the one-based line @p number , without
+         *        its line break, or an empty view if there is no such line.
+         */
+        [[nodiscard]]
+        auto line(std::size_t number) const noexcept -> std::string_view;
+
+
+    private:
+        std::string_view         m_source;
+        std::vector<std::size_t> m_starts;
+    };
+
+
+    /**
+     * @brief Returns the location of @p offset in @p source .
+     *
+     * Only the part of @p source before @p offset is scanned.
+     */
+    [[nodiscard]]
+    KONCPP_PUBLIC auto locate(std::string_view source,
+                              std::size_t      offset) noexcept -> Location;
+}
+
+
+#ifndef KONCPP_NO_FORMATTER
+#include <format>
+
+template <>
+struct std::formatter<koncpp::Location, char> : std::formatter<std::size_t>
+{
+    auto
+    format(const koncpp::Location &location, std::format_context &ctx) const
+    {
+        return std::format_to(ctx.out(), "{}:{}", location.line,
+                              location.column);
+    }
+};
+
+#endif
+#endif /* KONCPP_LOCATION__HH */
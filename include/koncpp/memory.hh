@@ -0,0 +1,571 @@
+/**
+ * @file koncpp/memory.hh
+ * @copyright Copyright (C) 2025-2026 Kei <RQuarx@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef KONCPP_MEMORY__HH
+#define KONCPP_MEMORY__HH
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "koncpp/.defs.hh"
+#include "koncpp/types/base.hh"
+
+
+namespace koncpp
+{
+    /**
+     * @brief What a @c Value tree is made of, as returned by
+     *        @c Value::memory_usage() .
+     */
+    struct MemoryUsage
+    {
+        /* Inclusive upper bounds of the string size buckets, the last
+           bucket holds every longer string. */
+        static constexpr std::array<std::size_t, 4> StringBuckets {
+            15, 64, 256, 4096
+        };
+
+
+        /* Heap bytes owned by the tree, not counting the root node. */
+        std::size_t bytes {};
+
+        /* Node counts, indexed by ValueType. */
+        std::array<std::size_t, std::to_underlying(ValueType::Object) + 1>
+            nodes {};
+
+        /* String values and object keys, by size. */
+        std::array<std::size_t, StringBuckets.size() + 1> strings {};
+
+
+        [[nodiscard]]
+        auto
+        count(ValueType type) const noexcept -> std::size_t
+        {
+            return nodes[std::to_underlying(type)];
+        }
+
+
+        /**
+         * @brief Returns the index in @c strings of a string of @p size .
+         */
+        [[nodiscard]]
+        static constexpr auto
+        bucket(std::size_t size) noexcept -> std::size_t
+        {
+            std::size_t index { 0 };
+            while (index < StringBuckets.size() && size > StringBuckets[index])
+                index++;
+            return index;
+        }
+
+
+        [[nodiscard]]
+        auto operator==(const MemoryUsage &rhs) const noexcept -> bool
+            = default;
+    };
+
+
+    /**
+     * @brief Counts the bytes allocated through @c AccountingAllocator .
+     *
+     * An account is usually kept per document or per tenant. It is updated
+     * atomically, so documents charged to it may live on any thread.
+     */
+    class KONCPP_PUBLIC MemoryAccount
+    {
+    public:
+        /**
+         * @brief Makes @p account the current one of this thread until
+         *        destroyed.
+         *
+         * Default constructed @c AccountingAllocator s, which is how
+         * @c Value creates its strings and children, charge the account that
+         * is current when they are created.
+         */
+        class KONCPP_PUBLIC Scope
+        {
+        public:
+            explicit Scope(MemoryAccount &account) noexcept
+                : m_previous(current())
+            {
+                mf_set_current(&account);
+            }
+
+            ~Scope()
+            {
+                mf_set_current(m_previous);
+            }
+
+            Scope(const Scope &)                     = delete;
+            auto operator=(const Scope &) -> Scope & = delete;
+
+
+        private:
+            MemoryAccount *m_previous;
+        };
+
+
+        MemoryAccount() = default;
+
+        MemoryAccount(const MemoryAccount &)                     = delete;
+        auto operator=(const MemoryAccount &) -> MemoryAccount & = delete;
+
+
+        /**
+         * @brief Returns the account of this thread, or @c nullptr .
+         */
+        [[nodiscard]]
+        static auto current() noexcept -> MemoryAccount *;
+
+
+        void
+        allocated(std::size_t size) noexcept
+        {
+            m_allocations.fetch_add(1, std::memory_order_relaxed);
+
+            const auto live { m_live.fetch_add(size, std::memory_order_relaxed)
+                              + size };
+
+            auto peak { m_peak.load(std::memory_order_relaxed) };
+            while (peak < live
+                   && !m_peak.compare_exchange_weak(
+                       peak, live, std::memory_order_relaxed))
+            {}
+        }
+
+
+        void
+        freed(std::size_t size) noexcept
+        {
+            m_allocations.fetch_sub(1, std::memory_order_relaxed);
+            m_live.fetch_sub(size, std::memory_order_relaxed);
+        }
+
+
+        /**
+         * @brief Returns the bytes currently allocated.
+         */
+        [[nodiscard]]
+        auto
+        live() const noexcept -> std::size_t
+        {
+            return m_live.load(std::memory_order_relaxed);
+        }
+
+
+        /**
+         * @brief Returns the most bytes that were allocated at once.
+         */
+        [[nodiscard]]
+        auto
+        peak() const noexcept -> std::size_t
+        {
+            return m_peak.load(std::memory_order_relaxed);
+        }
+
+
+        /**
+         * @brief Returns the number of allocations not yet freed.
+         */
+        [[nodiscard]]
+        auto
+        allocations() const noexcept -> std::size_t
+        {
+            return m_allocations.load(std::memory_order_relaxed);
+        }
+
+
+        /**
+         * @brief Starts measuring the peak again from the live bytes.
+         */
+        void
+        reset_peak() noexcept
+        {
+            m_peak.store(live(), std::memory_order_relaxed);
+        }
+
+
+    private:
+        std::atomic<std::size_t> m_live {};
+        std::atomic<std::size_t> m_peak {};
+        std::atomic<std::size_t> m_allocations {};
+
+
+        static void mf_set_current(MemoryAccount *account) noexcept;
+    };
+
+
+    /**
+     * @brief An allocator adaptor that charges a @c MemoryAccount .
+     *
+     * The account is chosen when the allocator is created and travels with
+     * it through copies, moves and rebinding, so memory is always returned
+     * to the account it was taken from. An allocator without an account
+     * only forwards to @p T_Upstream .
+     *
+     * @tparam T_Upstream The allocator that does the actual allocation.
+     */
+    template <typename T_Type, typename T_Upstream = std::allocator<T_Type>>
+    class AccountingAllocator
+    {
+        using Traits = std::allocator_traits<T_Upstream>;
+
+    public:
+        using value_type = T_Type;
+
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap            = std::true_type;
+        using is_always_equal                        = std::false_type;
+
+        template <typename T_Other>
+        struct rebind
+        {
+            using other = AccountingAllocator<
+                T_Other,
+                typename Traits::template rebind_alloc<T_Other>>;
+        };
+
+
+        /**
+         * @brief Charges the current account of this thread, if any.
+         */
+        AccountingAllocator() noexcept : m_account(MemoryAccount::current()) {}
+
+        explicit AccountingAllocator(MemoryAccount *account,
+                                     T_Upstream     upstream = {}) noexcept
+            : m_account(account), m_upstream(std::move(upstream))
+        {
+        }
+
+        template <typename T_Other, typename T_OtherUpstream>
+        AccountingAllocator(
+            const AccountingAllocator<T_Other, T_OtherUpstream> &other) noexcept
+            : m_account(other.account()), m_upstream(other.upstream())
+        {
+        }
+
+
+        [[nodiscard]]
+        auto
+        allocate(std::size_t count) -> T_Type *
+        {
+            auto *ptr { Traits::allocate(m_upstream, count) };
+            if (m_account != nullptr)
+                m_account->allocated(count * sizeof(T_Type));
+            return ptr;
+        }
+
+
+        void
+        deallocate(T_Type *ptr, std::size_t count) noexcept
+        {
+            Traits::deallocate(m_upstream, ptr, count);
+            if (m_account != nullptr) m_account->freed(count * sizeof(T_Type));
+        }
+
+
+        [[nodiscard]]
+        auto
+        account() const noexcept -> MemoryAccount *
+        {
+            return m_account;
+        }
+
+
+        [[nodiscard]]
+        auto
+        upstream() const noexcept -> const T_Upstream &
+        {
+            return m_upstream;
+        }
+
+
+        template <typename T_Other, typename T_OtherUpstream>
+        [[nodiscard]]
+        auto
+        operator==(const AccountingAllocator<T_Other, T_OtherUpstream> &rhs)
+            const noexcept -> bool
+        {
+            return m_account == rhs.account() && m_upstream == rhs.upstream();
+        }
+
+
+    private:
+        MemoryAccount *m_account;
+
+        [[no_unique_address]] T_Upstream m_upstream;
+    };
+
+    /**
+     * @brief A region that hands out memory by bumping an offset, and takes
+     *        it all back at once.
+     *
+     * Its blocks are kept across @c reset() , so that parsing documents of a
+     * similar size over and over stops allocating once the arena has grown
+     * to fit them. How much is kept is bounded by the retain limit.
+     *
+     * @warning Everything allocated from the arena must be destroyed before
+     *          it is reset.
+     */
+    class KONCPP_PUBLIC Arena
+    {
+    public:
+        static constexpr std::size_t BlockSize { 64 * 1024 };
+
+
+        /**
+         * @brief Makes @p arena the current one of this thread until
+         *        destroyed.
+         *
+         * Default constructed @c ArenaAllocator s, which is how @c Value
+         * creates its strings and children, allocate from the arena that is
+         * current when they are created.
+         */
+        class KONCPP_PUBLIC Scope
+        {
+        public:
+            explicit Scope(Arena &arena) noexcept : m_previous(current())
+            {
+                mf_set_current(&arena);
+            }
+
+            ~Scope()
+            {
+                mf_set_current(m_previous);
+            }
+
+            Scope(const Scope &)                     = delete;
+            auto operator=(const Scope &) -> Scope & = delete;
+
+
+        private:
+            Arena *m_previous;
+        };
+
+
+        Arena() = default;
+
+        /**
+         * @param retain_limit The most bytes of blocks kept by @c reset() .
+         */
+        explicit Arena(std::size_t retain_limit) noexcept
+            : m_retain_limit(retain_limit)
+        {
+        }
+
+        ~Arena();
+
+        Arena(const Arena &)                     = delete;
+        auto operator=(const Arena &) -> Arena & = delete;
+
+
+        /**
+         * @brief Returns the arena of this thread, or @c nullptr .
+         */
+        [[nodiscard]]
+        static auto current() noexcept -> Arena *;
+
+
+        [[nodiscard]]
+        auto
+        allocate(std::size_t size, std::size_t alignment) -> void *
+        {
+            if (m_current < m_blocks.size())
+            {
+                const auto &block { m_blocks[m_current] };
+                const auto  address { reinterpret_cast<std::uintptr_t>(
+                    block.data + m_offset) };
+                const auto  padding { static_cast<std::size_t>(
+                    ((address + alignment - 1) & ~(alignment - 1))
+                    - address) };
+
+                if (m_offset + padding + size <= block.size)
+                {
+                    auto *ptr { block.data + m_offset + padding };
+                    m_offset += padding + size;
+                    m_used   += padding + size;
+                    return ptr;
+                }
+            }
+
+            return mf_grow(size, alignment);
+        }
+
+
+        /**
+         * @brief Takes back everything that was allocated, freeing the
+         *        blocks beyond the retain limit.
+         */
+        void reset() noexcept;
+
+        /**
+         * @brief Frees the blocks that are not in use.
+         */
+        void shrink_to_fit() noexcept;
+
+
+        /**
+         * @brief Returns the bytes handed out since the last reset.
+         */
+        [[nodiscard]]
+        auto
+        used() const noexcept -> std::size_t
+        {
+            return m_used;
+        }
+
+
+        /**
+         * @brief Returns the bytes of the blocks held by the arena.
+         */
+        [[nodiscard]]
+        auto
+        capacity() const noexcept -> std::size_t
+        {
+            return m_capacity;
+        }
+
+
+        /**
+         * @brief Returns the most bytes that were in use before a reset.
+         */
+        [[nodiscard]]
+        auto
+        high_water() const noexcept -> std::size_t
+        {
+            return std::max(m_high_water, m_used);
+        }
+
+
+        void
+        set_retain_limit(std::size_t bytes) noexcept
+        {
+            m_retain_limit = bytes;
+        }
+
+
+    private:
+        struct Block
+        {
+            char       *data;
+            std::size_t size;
+        };
+
+        std::vector<Block> m_blocks;
+        std::size_t        m_current {}; /* the block being filled */
+        std::size_t        m_offset {};  /* and how much of it is used */
+        std::size_t        m_used {};
+        std::size_t        m_capacity {};
+        std::size_t        m_high_water {};
+        std::size_t        m_retain_limit {
+            std::numeric_limits<std::size_t>::max()
+        };
+
+
+        auto mf_grow(std::size_t size, std::size_t alignment) -> void *;
+        void mf_release(std::size_t keep) noexcept;
+
+        static void mf_set_current(Arena *arena) noexcept;
+    };
+
+
+    /**
+     * @brief An allocator that takes its memory from an @c Arena .
+     *
+     * Like @c AccountingAllocator , the arena is chosen when the allocator
+     * is created and travels with it. Deallocating through an arena does
+     * nothing, the memory comes back when the arena is reset. An allocator
+     * without an arena uses @c operator new .
+     */
+    template <typename T_Type>
+    class ArenaAllocator
+    {
+    public:
+        using value_type = T_Type;
+
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap            = std::true_type;
+        using is_always_equal                        = std::false_type;
+
+
+        /**
+         * @brief Allocates from the current arena of this thread, if any.
+         */
+        ArenaAllocator() noexcept : m_arena(Arena::current()) {}
+
+        explicit ArenaAllocator(Arena *arena) noexcept : m_arena(arena) {}
+
+        template <typename T_Other>
+        ArenaAllocator(const ArenaAllocator<T_Other> &other) noexcept
+            : m_arena(other.arena())
+        {
+        }
+
+
+        [[nodiscard]]
+        auto
+        allocate(std::size_t count) -> T_Type *
+        {
+            if (m_arena == nullptr)
+                return std::allocator<T_Type> {}.allocate(count);
+
+            return static_cast<T_Type *>(
+                m_arena->allocate(count * sizeof(T_Type), alignof(T_Type)));
+        }
+
+
+        void
+        deallocate(T_Type *ptr, std::size_t count) noexcept
+        {
+            if (m_arena == nullptr)
+                std::allocator<T_Type> {}.deallocate(ptr, count);
+        }
+
+
+        [[nodiscard]]
+        auto
+        arena() const noexcept -> Arena *
+        {
+            return m_arena;
+        }
+
+
+        template <typename T_Other>
+        [[nodiscard]]
+        auto
+        operator==(const ArenaAllocator<T_Other> &rhs) const noexcept -> bool
+        {
+            return m_arena == rhs.arena();
+        }
+
+
+    private:
+        Arena *m_arena;
+    };
+}
+
+#endif /* KONCPP_MEMORY__HH */
@@ -0,0 +1,913 @@
+/**
+ * @file koncpp/parser.hh
+ * @copyright Copyright (C) 2025-2026 Kei <RQuarx@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef KONCPP_PARSER__HH
+#define KONCPP_PARSER__HH
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <expected>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "koncpp/.defs.hh"
+#include "koncpp/error.hh"
+#include "koncpp/path.hh"
+#include "koncpp/stats.hh"
+#include "koncpp/value.hh"
+
+
+namespace koncpp
+{
+    namespace detail
+    {
+        /* The leading whitespace of a line, SYNTAX.md §2.7. */
+        struct Indentation
+        {
+            std::size_t start; /* where the line starts */
+            std::size_t end;   /* where its whitespace ends */
+            std::size_t width; /* with tabs expanded */
+        };
+
+        struct ParseMode;
+    }
+
+
+    /**
+     * @brief The most objects and arrays nested in each other, the document
+     *        included, that a parser accepts.
+     *
+     * Parsing recurses into nested values, so that deeper input fails with
+     * @c ErrorCode::NestingTooDeep rather than overflowing the stack.
+     */
+    constexpr std::size_t MaxDepth { 512 };
+
+
+    struct ParseError : public Exception
+    {
+        explicit ParseError(const Error &error)
+            : Exception("{}", describe(error.code)), m_error(error)
+        {
+        }
+
+        ParseError(const Error &error, std::string_view detail)
+            : Exception("{}: {}", describe(error.code), detail),
+              m_error(error)
+        {
+        }
+
+
+        /**
+         * @brief Returns the byte offset of the error in the source.
+         */
+        [[nodiscard]]
+        auto
+        offset() const noexcept -> std::size_t
+        {
+            return m_error.offset;
+        }
+
+
+        [[nodiscard]]
+        auto
+        code() const noexcept -> ErrorCode
+        {
+            return m_error.code;
+        }
+
+
+        [[nodiscard]]
+        auto
+        error() const noexcept -> const Error &
+        {
+            return m_error;
+        }
+
+
+    private:
+        Error m_error;
+    };
+
+
+    /**
+     * @brief Where a member is written in a source, as reported by
+     *        @c Parser::outline() .
+     */
+    struct MemberRange
+    {
+        std::string_view key;    /* as written, possibly dotted */
+        std::size_t      begin;  /* where the key starts */
+        std::size_t      end;    /* where the value ends */
+        std::size_t      parent; /* the enclosing member, or npos */
+    };
+
+
+    /**
+     * @brief Receives the events produced by a @c Parser .
+     *
+     * A document is reported as a root object. Every member starts with a
+     * @c key() event holding the key as written, which may be dotted, followed
+     * by the events of its value. Views passed to @c key() and @c string() are
+     * only valid for the duration of the call.
+     */
+    class KONCPP_PUBLIC Handler
+    {
+    public:
+        virtual ~Handler() = default;
+
+        virtual void key(std::string_view key) = 0;
+
+        virtual void begin_object() = 0;
+        virtual void end_object()   = 0;
+        virtual void begin_array()  = 0;
+        virtual void end_array()    = 0;
+
+        virtual void null()                                  = 0;
+        virtual void integer(types::Signed value)            = 0;
+        virtual void unsigned_integer(types::Unsigned value) = 0;
+        virtual void floating(double value)                  = 0;
+        virtual void boolean(bool value)                     = 0;
+        virtual void string(std::string_view value)          = 0;
+    };
+
+
+    /**
+     * @brief An event-based Kei Object Notation parser.
+     *
+     * The parser reports the structure of a document to a @c Handler without
+     * building it. Scratch storage is kept between calls to @c parse() , so
+     * that once it has grown to fit the documents a parser is given, parsing
+     * does not allocate.
+     */
+    class KONCPP_PUBLIC Parser
+    {
+    public:
+        Parser() = default;
+
+        /**
+         * @param tab_width How many spaces a tab counts as when comparing
+         *                  indentation. By default every character of
+         *                  indentation counts as one.
+         */
+        explicit Parser(std::size_t tab_width) : m_tab_width(tab_width) {}
+
+
+        /**
+         * @throws ParseError if @p source is not valid kon.
+         */
+        void parse(std::string_view source, Handler &handler);
+
+        /**
+         * @brief Parses @p source and fills @p stats for it.
+         *
+         * @p stats is reset first. Allocations made by @p handler are only
+         * counted if it reports them, as @c Builder does.
+         *
+         * @throws ParseError if @p source is not valid kon.
+         */
+        void parse(std::string_view source,
+                   Handler         &handler,
+                   ParseStats      &stats);
+
+        /**
+         * @brief Parses only the members of @p source that are on the way
+         *        to, or inside, one of @p paths .
+         *
+         * Every other member is skipped by its structure alone. It is never
+         * reported, unescaped or converted, and errors within it other than
+         * unterminated strings and comments go unnoticed. Objects are only
+         * reported if a member inside them is, and paths do not lead into
+         * arrays. An empty path asks for the whole document, and no paths
+         * for none of it.
+         *
+         * @throws ParseError if @p source is not valid kon where it was
+         *         parsed.
+         */
+        void parse(std::string_view      source,
+                   Handler              &handler,
+                   std::span<const Path> paths);
+
+        /**
+         * @brief Parses only the members of @p source that are on the way
+         *        to one of @p paths , and fills @p stats for it.
+         *
+         * Skipped members are counted as scanning.
+         */
+        void parse(std::string_view      source,
+                   Handler              &handler,
+                   std::span<const Path> paths,
+                   ParseStats           &stats);
+
+        /**
+         * @brief Returns where the members of @p source are, down to
+         *        @p depth levels of nested objects.
+         *
+         * Members are listed in source order, each before the members of
+         * its value. Values are skipped as in a projected parse, so nothing
+         * is unescaped or converted. The keys refer to @p source .
+         *
+         * @throws ParseError if @p source is not valid kon where it was
+         *         parsed.
+         */
+        [[nodiscard]]
+        auto outline(std::string_view source, std::size_t depth)
+            -> std::vector<MemberRange>;
+
+
+        /**
+         * @brief Parses @p source without throwing on invalid input.
+         *
+         * Exceptions thrown by @p handler other than @c ValueError , which
+         * is reported as @c ErrorCode::InvalidValue , are propagated.
+         */
+        [[nodiscard]]
+        auto try_parse(std::string_view source, Handler &handler)
+            -> std::expected<void, Error>;
+
+        [[nodiscard]]
+        auto try_parse(std::string_view source,
+                       Handler         &handler,
+                       ParseStats      &stats) -> std::expected<void, Error>;
+
+
+        [[nodiscard]]
+        auto
+        tab_width() const noexcept -> std::size_t
+        {
+            return m_tab_width;
+        }
+
+
+        /**
+         * @brief Returns the bytes of scratch storage kept for the next
+         *        parse.
+         */
+        [[nodiscard]]
+        auto
+        retained() const noexcept -> std::size_t
+        {
+            return m_buffer.capacity()
+                 + m_lines.capacity() * sizeof(detail::Indentation);
+        }
+
+
+        /**
+         * @brief Frees the scratch storage kept for the next parse.
+         */
+        void
+        shrink_to_fit()
+        {
+            m_buffer.clear();
+            m_buffer.shrink_to_fit();
+            m_lines.clear();
+            m_lines.shrink_to_fit();
+        }
+
+
+        /**
+         * @brief Frees the scratch storage after a successful parse that
+         *        leaves more than @p bytes of it, so that one large document
+         *        does not keep its memory for the small ones that follow.
+         */
+        void
+        set_retain_limit(std::size_t bytes) noexcept
+        {
+            m_retain_limit = bytes;
+        }
+
+
+    private:
+        std::size_t                      m_tab_width { 1 };
+        std::size_t                      m_retain_limit {
+            std::numeric_limits<std::size_t>::max()
+        };
+        std::string                      m_buffer;
+        std::vector<detail::Indentation> m_lines;
+
+
+        void mf_run(std::string_view         source,
+                    Handler                 &handler,
+                    const detail::ParseMode &mode,
+                    ParseStats              &stats);
+
+        void
+        mf_trim()
+        {
+            if (retained() > m_retain_limit) shrink_to_fit();
+        }
+    };
+
+
+    /**
+     * @brief A @c Handler that builds a @c Value tree.
+     *
+     * Dotted keys create or extend nested objects (SYNTAX.md §2.7). The
+     * objects their prefixes resolved to are cached, so consecutive keys such
+     * as @c svc.http.timeout and @c svc.http.retries only look up their last
+     * segment. Large objects are indexed by key while they are being filled.
+     *
+     * With @c set_pack_booleans() , arrays of booleans are built as
+     * @c types::BooleanArray bitmaps rather than one @c Value per element.
+     *
+     * @tparam T_Allocator The allocator used by the built document.
+     */
+    template <typename T_Allocator = std::allocator<char>>
+    class Builder : public Handler
+    {
+    public:
+        using Document = Value<T_Allocator>;
+
+
+        Builder() = default;
+
+        /**
+         * @param stats Receives the allocations made while building.
+         */
+        explicit Builder(ParseStats &stats) : m_stats(&stats) {}
+
+
+        /**
+         * @brief Builds arrays of booleans packed, as two bits per element
+         *        instead of a @c Value .
+         *
+         * Off by default, as a packed array has no elements to reference
+         * through @c Value::at() or @c Value::Array .
+         */
+        void
+        set_pack_booleans(bool pack = true) noexcept
+        {
+            m_pack = pack;
+        }
+
+
+        void
+        key(std::string_view key) override
+        {
+            m_key = key;
+        }
+
+
+        void
+        begin_object() override
+        {
+            auto &slot { mf_slot() };
+            if (slot.type() != ValueType::Object)
+                slot = Document { ValueType::Object };
+            m_stack.push_back(&slot);
+        }
+
+
+        void
+        end_object() override
+        {
+            m_stack.pop_back();
+            mf_forget(m_stack.size() + 1);
+        }
+
+
+        void
+        begin_array() override
+        {
+            m_stack.push_back(&mf_set(Document { ValueType::Array }));
+        }
+
+
+        void
+        end_array() override
+        {
+            m_stack.pop_back();
+            mf_forget(m_stack.size() + 1);
+        }
+
+
+        void
+        null() override
+        {
+            if (auto *packed { mf_packed(false) })
+                packed->push_back(std::nullopt);
+            else
+                mf_set(Document {});
+        }
+
+
+        void
+        integer(types::Signed value) override
+        {
+            mf_set(types::Integer<types::Signed> { value });
+        }
+
+
+        void
+        unsigned_integer(types::Unsigned value) override
+        {
+            mf_set(types::Integer<types::Unsigned> { value });
+        }
+
+
+        void
+        floating(double value) override
+        {
+            mf_set(types::Float { value });
+        }
+
+
+        void
+        boolean(bool value) override
+        {
+            if (auto *packed { mf_packed(true) })
+                packed->push_back(value);
+            else
+                mf_set(types::Boolean { value });
+        }
+
+
+        void
+        string(std::string_view value) override
+        {
+            KONCPP_STATS_ONLY(mf_count_string(value);)
+            mf_set(typename Document::StringType { value });
+        }
+
+
+        /**
+         * @brief Returns the built document and resets the builder.
+         */
+        [[nodiscard]]
+        auto
+        take() -> Document
+        {
+            m_stack.clear();
+            mf_forget(0);
+
+            /* the next document must not reuse the allocator of this one */
+            auto document { std::move(m_root) };
+            m_root = Document {};
+            return document;
+        }
+
+
+    private:
+        using Object = typename Document::Object;
+
+        /* Objects with fewer members are searched linearly. */
+        static constexpr std::size_t IndexedSize { 16 };
+
+        static constexpr auto NPos { std::string_view::npos };
+
+
+        /**
+         * A dotted key prefix that was resolved in the object open at
+         * @c depth . The object is found again through the positions of its
+         * members, which stay valid while the object is open, unlike
+         * pointers into vectors that are still growing.
+         */
+        struct Prefix
+        {
+            std::string              key;
+            std::vector<std::size_t> path;
+            std::size_t              depth {};
+            std::size_t              used {}; /* 0 if the entry is free */
+
+            /* Valid until the next insertion. */
+            Document *node {};
+
+            /* An open addressing table of the positions of the members of
+               a large object, plus one, by key hash. It holds the first
+               @c indexed members stored at @c data , and keeps its
+               capacity when it is reset. */
+            std::vector<std::size_t> members;
+            const void              *data {};
+            std::size_t              indexed {};
+        };
+
+
+        Document                m_root;
+        std::vector<Document *> m_stack;
+        std::string_view        m_key;
+        bool                    m_pack {};
+
+        std::array<Prefix, 8>    m_prefixes;
+        std::vector<std::size_t> m_path;
+        std::size_t              m_tick {};
+
+        [[maybe_unused]] ParseStats *m_stats {};
+
+
+        /**
+         * @brief Writes @p value to the next slot.
+         */
+        auto
+        mf_set(Document value) -> Document &
+        {
+            auto &slot { mf_slot() };
+
+            /* the prefixes cached inside the replaced object are gone */
+            if (slot.type() == ValueType::Object) mf_forget(0);
+            return slot = std::move(value);
+        }
+
+
+        /**
+         * @brief Returns the packed array the next element goes to, packing
+         *        the open array if it is still empty and @p start is set.
+         */
+        auto
+        mf_packed(bool start) -> types::BooleanArray *
+        {
+            if (m_stack.empty()) return nullptr;
+
+            auto &parent { *m_stack.back() };
+            if (auto *packed { parent.template get_if<types::BooleanArray>() })
+                return packed;
+
+            const auto *array { parent.template get_if<
+                typename Document::Array>() };
+            if (!m_pack || !start || array == nullptr || !array->empty())
+                return nullptr;
+
+            parent = Document { types::BooleanArray {} };
+            return parent.template get_if<types::BooleanArray>();
+        }
+
+
+        /**
+         * @brief Returns the value the next event is written to.
+         */
+        auto
+        mf_slot() -> Document &
+        {
+            if (m_stack.empty()) return m_root;
+
+            auto &parent { *m_stack.back() };
+            /* the parser already enforces single-typed arrays */
+            if (auto *array { parent.template get_if<
+                              typename Document::Array>() })
+            {
+                KONCPP_STATS_GROWTH(m_stats, *array);
+                return array->emplace_back();
+            }
+            if (parent.template holds<types::BooleanArray>())
+                throw ValueError { "arrays must contain a single data type" };
+
+            const auto dot { m_key.rfind('.') };
+            const auto prefix { dot == NPos ? std::string_view {}
+                                            : m_key.substr(0, dot) };
+            const auto name { m_key.substr(dot + 1) };
+
+            auto &cached { mf_resolve(parent, prefix) };
+
+            if (const auto index { mf_position(cached, name) }; index != NPos)
+                return cached.node->template get<Object>()[index].value;
+            return mf_insert(*cached.node, name, {});
+        }
+
+
+        /**
+         * @brief Returns the cache entry of the object @p prefix names in
+         *        @p parent , creating the objects that do not exist yet.
+         *
+         * Only the segments after the longest cached prefix are looked up.
+         */
+        auto
+        mf_resolve(Document &parent, std::string_view prefix) -> Prefix &
+        {
+            const auto depth { m_stack.size() };
+            m_tick++;
+
+            Prefix *best {};
+            for (auto &entry : m_prefixes)
+            {
+                if (entry.used == 0 || entry.depth != depth
+                    || !mf_covers(entry.key, prefix))
+                    continue;
+                if (best == nullptr || entry.key.size() > best->key.size())
+                    best = &entry;
+            }
+
+            if (best != nullptr)
+            {
+                best->node = mf_follow(parent, best->path);
+                if (best->node == nullptr)
+                {
+                    mf_forget(depth);
+                    best = nullptr;
+                }
+            }
+
+            if (best == nullptr)
+            {
+                best       = &mf_claim(depth, {});
+                best->node = &parent;
+            }
+
+            best->used = m_tick;
+            if (best->key.size() == prefix.size()) return *best;
+
+            m_path.assign(best->path.begin(), best->path.end());
+
+            auto *from { best };
+            auto  pos { best->key.empty() ? 0 : best->key.size() + 1 };
+
+            while (true)
+            {
+                auto end { prefix.find('.', pos) };
+                if (end == NPos) end = prefix.size();
+
+                const auto segment { prefix.substr(pos, end - pos) };
+                auto      *node { from->node };
+                auto       index { mf_position(*from, segment) };
+
+                if (index == NPos)
+                {
+                    (void)mf_insert(*node, segment, ValueType::Object);
+                    index = node->template get<Object>().size() - 1;
+                }
+                else if (node->template get<Object>()[index].value.type()
+                         != ValueType::Object)
+                    throw ValueError { "'{}' is not an object", segment };
+
+                m_path.push_back(index);
+
+                auto &entry { mf_claim(depth, prefix.substr(0, end)) };
+                entry.path.assign(m_path.begin(), m_path.end());
+                entry.node = &node->template get<Object>()[index].value;
+
+                if (end == prefix.size()) return entry;
+
+                from = &entry;
+                pos  = end + 1;
+            }
+        }
+
+
+        /**
+         * @brief Returns whether @p key is @p prefix or one of its leading
+         *        segments.
+         */
+        static auto
+        mf_covers(std::string_view key, std::string_view prefix) noexcept
+            -> bool
+        {
+            if (key.empty()) return true;
+            return prefix.starts_with(key)
+                && (prefix.size() == key.size() || prefix[key.size()] == '.');
+        }
+
+
+        /**
+         * @brief Returns the object at @p path in @p node , or @c nullptr if
+         *        it was replaced.
+         */
+        static auto
+        mf_follow(Document &node, const std::vector<std::size_t> &path)
+            -> Document *
+        {
+            auto *current { &node };
+            for (const auto index : path)
+            {
+                auto *object { current->template get_if<Object>() };
+                if (object == nullptr || index >= object->size())
+                    return nullptr;
+                current = &(*object)[index].value;
+            }
+
+            return current->type() == ValueType::Object ? current : nullptr;
+        }
+
+
+        /**
+         * @brief Returns the position of the member @p key in the object of
+         *        @p entry , or @c NPos .
+         */
+        static auto
+        mf_position(Prefix &entry, std::string_view key) -> std::size_t
+        {
+            const auto &object { entry.node->template get<Object>() };
+
+            if (object.size() < IndexedSize)
+            {
+                const auto it { std::ranges::find(
+                    object, key, &Document::Member::key) };
+                return it == object.end()
+                         ? NPos
+                         : static_cast<std::size_t>(it - object.begin());
+            }
+
+            /* moving the members moves the keys the index refers to, and
+               the table is kept at most half full */
+            if (entry.data != object.data()
+                || entry.members.size() < 2 * object.size())
+            {
+                entry.members.assign(
+                    std::max(entry.members.size(),
+                             std::bit_ceil(4 * object.size())),
+                    0);
+                entry.data    = object.data();
+                entry.indexed = 0;
+            }
+
+            const auto mask { entry.members.size() - 1 };
+
+            for (; entry.indexed < object.size(); entry.indexed++)
+            {
+                auto slot { object[entry.indexed].hash & mask };
+                while (entry.members[slot] != 0) slot = (slot + 1) & mask;
+                entry.members[slot] = entry.indexed + 1;
+            }
+
+            const auto hash { hash_key(key) };
+            for (auto slot { hash & mask }; entry.members[slot] != 0;
+                 slot = (slot + 1) & mask)
+            {
+                const auto &member { object[entry.members[slot] - 1] };
+                if (member.hash == hash && member.key == key)
+                    return entry.members[slot] - 1;
+            }
+
+            return NPos;
+        }
+
+
+        /**
+         * @brief Returns a free cache entry for @p key , or the least
+         *        recently used one.
+         */
+        auto
+        mf_claim(std::size_t depth, std::string_view key) -> Prefix &
+        {
+            auto *entry { &m_prefixes.front() };
+            for (auto &candidate : m_prefixes)
+                if (candidate.used < entry->used) entry = &candidate;
+
+            mf_reset(*entry);
+            entry->key.assign(key);
+            entry->depth = depth;
+            entry->used  = m_tick;
+            return *entry;
+        }
+
+
+        static void
+        mf_reset(Prefix &entry)
+        {
+            entry.key.clear();
+            entry.path.clear();
+            entry.used = 0;
+            entry.node = nullptr;
+
+            entry.data    = nullptr;
+            entry.indexed = 0;
+        }
+
+
+        /**
+         * @brief Drops the prefixes cached in objects open at @p depth or
+         *        deeper.
+         */
+        void
+        mf_forget(std::size_t depth)
+        {
+            for (auto &entry : m_prefixes)
+                if (entry.used != 0 && entry.depth >= depth) mf_reset(entry);
+        }
+
+
+        /**
+         * @brief Appends a new member to the object @p node .
+         */
+        auto
+        mf_insert(Document &node, std::string_view key, Document value)
+            -> Document &
+        {
+            KONCPP_STATS_ONLY(mf_count_string(key);)
+
+            auto &object { node.template get<Object>() };
+            KONCPP_STATS_GROWTH(m_stats, object);
+
+            object.push_back(
+                typename Document::Member { Key { key }, std::move(value) });
+            return object.back().value;
+        }
+
+
+#ifdef KONCPP_STATS
+        /* Strings that do not fit in the small string buffer are allocated. */
+        void
+        mf_count_string(std::string_view value) noexcept
+        {
+            if (m_stats != nullptr
+                && value.size() > typename Document::BaseString {}.capacity())
+                m_stats->allocated(value.size() + 1);
+        }
+#endif
+    };
+
+
+    /**
+     * @brief A parsed document together with the statistics of its parse.
+     */
+    template <typename T_Allocator = std::allocator<char>>
+    struct Parsed
+    {
+        Value<T_Allocator> document;
+        ParseStats         stats;
+    };
+
+
+    /**
+     * @brief Parses @p source into a @c Value tree.
+     * @throws ParseError if @p source is not valid kon.
+     */
+    template <typename T_Allocator = std::allocator<char>>
+    [[nodiscard]]
+    auto
+    parse(std::string_view source) -> Value<T_Allocator>
+    {
+        Parser               parser;
+        Builder<T_Allocator> builder;
+
+        parser.parse(source, builder);
+        return builder.take();
+    }
+
+
+    /**
+     * @brief Parses the members of @p source on the way to, or inside, one
+     *        of @p paths into a @c Value tree, skipping everything else.
+     * @throws ParseError if @p source is not valid kon where it was parsed.
+     */
+    template <typename T_Allocator = std::allocator<char>>
+    [[nodiscard]]
+    auto
+    parse(std::string_view source, std::span<const Path> paths)
+        -> Value<T_Allocator>
+    {
+        Parser               parser;
+        Builder<T_Allocator> builder;
+
+        parser.parse(source, builder, paths);
+        return builder.take();
+    }
+
+
+    /**
+     * @brief Parses @p source into a @c Value tree, returning an @c Error
+     *        instead of throwing if it is not valid kon.
+     */
+    template <typename T_Allocator = std::allocator<char>>
+    [[nodiscard]]
+    auto
+    try_parse(std::string_view source)
+        -> std::expected<Value<T_Allocator>, Error>
+    {
+        Parser               parser;
+        Builder<T_Allocator> builder;
+
+        if (auto result { parser.try_parse(source, builder) }; !result)
+            return std::unexpected { result.error() };
+        return builder.take();
+    }
+
+
+    /**
+     * @brief Parses @p source into a @c Value tree and reports how the time
+     *        was spent.
+     *
+     * The statistics are all zero unless koncpp is built with @c stats .
+     *
+     * @throws ParseError if @p source is not valid kon.
+     */
+    template <typename T_Allocator = std::allocator<char>>
+    [[nodiscard]]
+    auto
+    parse_with_stats(std::string_view source) -> Parsed<T_Allocator>
+    {
+        Parsed<T_Allocator>  result;
+        Parser               parser;
+        Builder<T_Allocator> builder { result.stats };
+
+        parser.parse(source, builder, result.stats);
+        result.document = builder.take();
+        return result;
+    }
+}
+
+#endif /* KONCPP_PARSER__HH */
@@ -0,0 +1,167 @@
+/**
+ * @file koncpp/path.hh
+ * @copyright Copyright (C) 2025-2026 Kei <RQuarx@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef KONCPP_PATH__HH
+#define KONCPP_PATH__HH
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace koncpp
+{
+    /**
+     * @brief Returns the hash object members are compared by, FNV-1a.
+     */
+    [[nodiscard]]
+    constexpr auto
+    hash_key(std::string_view key) noexcept -> std::uint64_t
+    {
+        std::uint64_t hash { 0xcbf29ce484222325 };
+        for (const auto c : key)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 0x100000001b3;
+        }
+        return hash;
+    }
+
+
+    /**
+     * @brief An object key hashed ahead of its lookups.
+     *
+     * Keys made with the @c _k literal are hashed at compile time.
+     *
+     * @warning The key refers to @p name , which must outlive it.
+     */
+    struct Key
+    {
+        std::string_view name;
+        std::uint64_t    hash;
+
+
+        constexpr explicit Key(std::string_view name) noexcept
+            : name(name), hash(hash_key(name))
+        {
+        }
+
+        /**
+         * @param hash The result of @c hash_key() for @p name .
+         */
+        constexpr Key(std::string_view name, std::uint64_t hash) noexcept
+            : name(name), hash(hash)
+        {
+        }
+    };
+
+
+    /**
+     * @brief A dotted path such as @c "server.http.port" , split and hashed
+     *        once to be looked up many times.
+     *
+     * An empty path refers to the value it is looked up in.
+     */
+    class Path
+    {
+    public:
+        Path() = default;
+
+        explicit Path(std::string_view path) : m_text(path)
+        {
+            if (path.empty()) return;
+
+            for (std::size_t start { 0 };;)
+            {
+                auto end { path.find('.', start) };
+                if (end == std::string_view::npos) end = path.size();
+
+                m_segments.push_back(
+                    { start, end - start,
+                      hash_key(path.substr(start, end - start)) });
+
+                if (end == path.size()) break;
+                start = end + 1;
+            }
+        }
+
+
+        [[nodiscard]]
+        auto
+        size() const noexcept -> std::size_t
+        {
+            return m_segments.size();
+        }
+
+
+        [[nodiscard]]
+        auto
+        empty() const noexcept -> bool
+        {
+            return m_segments.empty();
+        }
+
+
+        [[nodiscard]]
+        auto
+        operator[](std::size_t index) const noexcept -> Key
+        {
+            const auto &segment { m_segments[index] };
+            return Key { std::string_view { m_text }.substr(segment.offset,
+                                                            segment.size),
+                         segment.hash };
+        }
+
+
+        [[nodiscard]]
+        auto
+        text() const noexcept -> std::string_view
+        {
+            return m_text;
+        }
+
+
+    private:
+        /* Offsets rather than views, which copying the text would break. */
+        struct Segment
+        {
+            std::size_t   offset;
+            std::size_t   size;
+            std::uint64_t hash;
+        };
+
+        std::string          m_text;
+        std::vector<Segment> m_segments;
+    };
+
+
+    namespace literals
+    {
+        /**
+         * @brief Makes a @c Key hashed at compile time, as in
+         *        @c doc["server"_k]["port"_k] .
+         */
+        consteval auto
+        operator""_k(const char *name, std::size_t size) noexcept -> Key
+        {
+            return Key { std::string_view { name, size } };
+        }
+    }
+}
+
+#endif /* KONCPP_PATH__HH */
@@ -0,0 +1,843 @@
+/**
+ * @file koncpp/persistent.hh
+ * @copyright Copyright (C) 2025-2026 Kei <RQuarx@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef KONCPP_PERSISTENT__HH
+#define KONCPP_PERSISTENT__HH
+#include <bit>
+#include <charconv>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "koncpp/value.hh"
+
+
+namespace koncpp
+{
+    namespace detail
+    {
+        inline constexpr unsigned      TrieBits { 5 };
+        inline constexpr std::uint32_t TrieMask { (1U << TrieBits) - 1 };
+
+
+        /**
+         * @brief A persistent hash array mapped trie.
+         *
+         * Every modification copies only the nodes on the path to the changed
+         * entry and shares the rest with the original map.
+         */
+        template <typename T_Key, typename T_Value>
+        class Hamt
+        {
+        public:
+            struct Entry
+            {
+                T_Key   key;
+                T_Value value;
+            };
+
+
+            [[nodiscard]]
+            auto
+            size() const noexcept -> std::size_t
+            {
+                return m_size;
+            }
+
+
+            [[nodiscard]]
+            auto
+            find(std::string_view key) const noexcept -> const T_Value *
+            {
+                const auto hash { mf_hash(key) };
+                const auto *node { m_root.get() };
+
+                for (unsigned shift { 0 }; node != nullptr; shift += TrieBits)
+                {
+                    if (shift >= 64)
+                    {
+                        for (const auto &entry : node->entries)
+                            if (entry.key == key) return &entry.value;
+                        return nullptr;
+                    }
+
+                    const auto bit { mf_bit(hash, shift) };
+
+                    if ((node->datamap & bit) != 0)
+                    {
+                        const auto &entry {
+                            node->entries[mf_index(node->datamap, bit)]
+                        };
+                        return entry.key == key ? &entry.value : nullptr;
+                    }
+
+                    if ((node->nodemap & bit) == 0) return nullptr;
+                    node = node->children[mf_index(node->nodemap, bit)].get();
+                }
+
+                return nullptr;
+            }
+
+
+            [[nodiscard]]
+            auto
+            assoc(T_Key key, T_Value value) const -> Hamt
+            {
+                bool added { false };
+                const auto hash { mf_hash(key) };
+
+                Hamt result;
+                result.m_root = mf_assoc(m_root,
+                                         0,
+                                         hash,
+                                         Entry { std::move(key),
+                                                 std::move(value) },
+                                         added);
+                result.m_size = m_size + (added ? 1 : 0);
+                return result;
+            }
+
+
+            [[nodiscard]]
+            auto
+            erase(std::string_view key) const -> Hamt
+            {
+                bool removed { false };
+
+                Hamt result;
+                result.m_root
+                    = mf_erase(m_root, 0, mf_hash(key), key, removed);
+                result.m_size = m_size - (removed ? 1 : 0);
+                return result;
+            }
+
+
+            template <typename T_Func>
+            void
+            for_each(T_Func &&func) const
+            {
+                mf_for_each(m_root.get(), func);
+            }
+
+
+        private:
+            struct Node
+            {
+                std::uint32_t datamap {};
+                std::uint32_t nodemap {};
+
+                std::vector<Entry>                       entries;
+                std::vector<std::shared_ptr<const Node>> children;
+            };
+
+            using NodePtr = std::shared_ptr<const Node>;
+
+            NodePtr     m_root;
+            std::size_t m_size {};
+
+
+            [[nodiscard]]
+            static auto
+            mf_hash(std::string_view key) noexcept -> std::uint64_t
+            {
+                return std::hash<std::string_view> {}(key);
+            }
+
+
+            [[nodiscard]]
+            static constexpr auto
+            mf_bit(std::uint64_t hash, unsigned shift) noexcept
+                -> std::uint32_t
+            {
+                return 1U << ((hash >> shift) & TrieMask);
+            }
+
+
+            [[nodiscard]]
+            static constexpr auto
+            mf_index(std::uint32_t map, std::uint32_t bit) noexcept
+                -> std::size_t
+            {
+                return std::popcount(map & (bit - 1));
+            }
+
+
+            [[nodiscard]]
+            static auto
+            mf_merge(Entry         a,
+                     std::uint64_t a_hash,
+                     Entry         b,
+                     std::uint64_t b_hash,
+                     unsigned      shift) -> NodePtr
+            {
+                auto node { std::make_shared<Node>() };
+
+                if (shift >= 64)
+                {
+                    node->entries.push_back(std::move(a));
+                    node->entries.push_back(std::move(b));
+                    return node;
+                }
+
+                const auto a_bit { mf_bit(a_hash, shift) };
+                const auto b_bit { mf_bit(b_hash, shift) };
+
+                if (a_bit == b_bit)
+                {
+                    node->nodemap = a_bit;
+                    node->children.push_back(mf_merge(std::move(a),
+                                                      a_hash,
+                                                      std::move(b),
+                                                      b_hash,
+                                                      shift + TrieBits));
+                    return node;
+                }
+
+                node->datamap = a_bit | b_bit;
+                if (a_bit > b_bit) std::swap(a, b);
+                node->entries.push_back(std::move(a));
+                node->entries.push_back(std::move(b));
+                return node;
+            }
+
+
+            [[nodiscard]]
+            static auto
+            mf_assoc(const NodePtr &node,
+                     unsigned       shift,
+                     std::uint64_t  hash,
+                     Entry          entry,
+                     bool          &added) -> NodePtr
+            {
+                if (node == nullptr)
+                {
+                    added = true;
+
+                    auto leaf { std::make_shared<Node>() };
+                    if (shift < 64) leaf->datamap = mf_bit(hash, shift);
+                    leaf->entries.push_back(std::move(entry));
+                    return leaf;
+                }
+
+                auto copy { std::make_shared<Node>(*node) };
+
+                if (shift >= 64)
+                {
+                    for (auto &existing : copy->entries)
+                        if (existing.key == entry.key)
+                        {
+                            existing.value = std::move(entry.value);
+                            return copy;
+                        }
+
+                    added = true;
+                    copy->entries.push_back(std::move(entry));
+                    return copy;
+                }
+
+                const auto bit { mf_bit(hash, shift) };
+
+                if ((node->datamap & bit) != 0)
+                {
+                    const auto index { mf_index(node->datamap, bit) };
+                    auto      &existing { copy->entries[index] };
+
+                    if (existing.key == entry.key)
+                    {
+                        existing.value = std::move(entry.value);
+                        return copy;
+                    }
+
+                    added = true;
+
+                    const auto existing_hash { mf_hash(existing.key) };
+                    auto       child { mf_merge(std::move(existing),
+                                          existing_hash,
+                                          std::move(entry),
+                                          hash,
+                                          shift + TrieBits) };
+
+                    copy->entries.erase(copy->entries.begin()
+                                        + static_cast<std::ptrdiff_t>(index));
+                    copy->datamap &= ~bit;
+                    copy->nodemap |= bit;
+                    copy->children.insert(
+                        copy->children.begin()
+                            + static_cast<std::ptrdiff_t>(
+                                mf_index(copy->nodemap, bit)),
+                        std::move(child));
+                    return copy;
+                }
+
+                if ((node->nodemap & bit) != 0)
+                {
+                    auto &child {
+                        copy->children[mf_index(node->nodemap, bit)]
+                    };
+                    child = mf_assoc(
+                        child, shift + TrieBits, hash, std::move(entry), added);
+                    return copy;
+                }
+
+                added = true;
+                copy->datamap |= bit;
+                copy->entries.insert(copy->entries.begin()
+                                         + static_cast<std::ptrdiff_t>(
+                                             mf_index(copy->datamap, bit)),
+                                     std::move(entry));
+                return copy;
+            }
+
+
+            [[nodiscard]]
+            static auto
+            mf_erase(const NodePtr   &node,
+                     unsigned         shift,
+                     std::uint64_t    hash,
+                     std::string_view key,
+                     bool            &removed) -> NodePtr
+            {
+                if (node == nullptr) return node;
+
+                if (shift >= 64)
+                {
+                    const auto it { std::ranges::find(
+                        node->entries, key, &Entry::key) };
+                    if (it == node->entries.end()) return node;
+
+                    removed = true;
+                    if (node->entries.size() == 1) return nullptr;
+
+                    auto copy { std::make_shared<Node>(*node) };
+                    copy->entries.erase(copy->entries.begin()
+                                        + (it - node->entries.begin()));
+                    return copy;
+                }
+
+                const auto bit { mf_bit(hash, shift) };
+
+                if ((node->datamap & bit) != 0)
+                {
+                    const auto index { mf_index(node->datamap, bit) };
+                    if (node->entries[index].key != key) return node;
+
+                    removed = true;
+                    if (node->entries.size() == 1 && node->children.empty())
+                        return nullptr;
+
+                    auto copy { std::make_shared<Node>(*node) };
+                    copy->entries.erase(copy->entries.begin()
+                                        + static_cast<std::ptrdiff_t>(index));
+                    copy->datamap &= ~bit;
+                    return copy;
+                }
+
+                if ((node->nodemap & bit) == 0) return node;
+
+                const auto index { mf_index(node->nodemap, bit) };
+                auto       child { mf_erase(node->children[index],
+                                          shift + TrieBits,
+                                          hash,
+                                          key,
+                                          removed) };
+                if (child == node->children[index]) return node;
+
+                if (child == nullptr && node->entries.empty()
+                    && node->children.size() == 1)
+                    return nullptr;
+
+                auto copy { std::make_shared<Node>(*node) };
+                if (child == nullptr)
+                {
+                    copy->children.erase(copy->children.begin()
+                                         + static_cast<std::ptrdiff_t>(index));
+                    copy->nodemap &= ~bit;
+                }
+                else
+                    copy->children[index] = std::move(child);
+                return copy;
+            }
+
+
+            template <typename T_Func>
+            static void
+            mf_for_each(const Node *node, T_Func &func)
+            {
+                if (node == nullptr) return;
+                for (const auto &entry : node->entries)
+                    func(entry.key, entry.value);
+                for (const auto &child : node->children)
+                    mf_for_each(child.get(), func);
+            }
+        };
+
+
+        /**
+         * @brief A persistent vector stored as a 32-way trie.
+         */
+        template <typename T_Value>
+        class Trie
+        {
+        public:
+            [[nodiscard]]
+            auto
+            size() const noexcept -> std::size_t
+            {
+                return m_size;
+            }
+
+
+            [[nodiscard]]
+            auto
+            at(std::size_t index) const -> const T_Value &
+            {
+                if (index >= m_size)
+                    throw ValueError { "index {} is out of range", index };
+
+                const auto *node { m_root.get() };
+                for (auto shift { m_shift }; shift > 0; shift -= TrieBits)
+                    node = node->children[(index >> shift) & TrieMask].get();
+                return node->values[index & TrieMask];
+            }
+
+
+            [[nodiscard]]
+            auto
+            set(std::size_t index, T_Value value) const -> Trie
+            {
+                if (index >= m_size)
+                    throw ValueError { "index {} is out of range", index };
+
+                Trie result { *this };
+                result.m_root
+                    = mf_set(m_root, m_shift, index, std::move(value));
+                return result;
+            }
+
+
+            [[nodiscard]]
+            auto
+            push_back(T_Value value) const -> Trie
+            {
+                Trie result { *this };
+
+                if (m_root != nullptr
+                    && m_size == std::size_t { 1 } << (m_shift + TrieBits))
+                {
+                    auto root { std::make_shared<Node>() };
+                    root->children.push_back(m_root);
+                    result.m_root = std::move(root);
+                    result.m_shift += TrieBits;
+                }
+
+                result.m_root = mf_set(
+                    result.m_root, result.m_shift, m_size, std::move(value));
+                result.m_size++;
+                return result;
+            }
+
+
+        private:
+            struct Node
+            {
+                std::vector<T_Value>                     values;
+                std::vector<std::shared_ptr<const Node>> children;
+            };
+
+            using NodePtr = std::shared_ptr<const Node>;
+
+            NodePtr     m_root;
+            std::size_t m_size {};
+            unsigned    m_shift {};
+
+
+            [[nodiscard]]
+            static auto
+            mf_set(const NodePtr &node,
+                   unsigned       shift,
+                   std::size_t    index,
+                   T_Value        value) -> NodePtr
+            {
+                auto copy { node != nullptr ? std::make_shared<Node>(*node)
+                                            : std::make_shared<Node>() };
+                const auto slot { (index >> shift) & TrieMask };
+
+                if (shift == 0)
+                {
+                    if (slot < copy->values.size())
+                        copy->values[slot] = std::move(value);
+                    else
+                        copy->values.push_back(std::move(value));
+                    return copy;
+                }
+
+                if (slot < copy->children.size())
+                    copy->children[slot] = mf_set(copy->children[slot],
+                                                  shift - TrieBits,
+                                                  index,
+                                                  std::move(value));
+                else
+                    copy->children.push_back(mf_set(
+                        nullptr, shift - TrieBits, index, std::move(value)));
+                return copy;
+            }
+        };
+    }
+
+
+    /**
+     * @brief An immutable kon document with structural sharing.
+     *
+     * Objects are stored as hash array mapped tries and arrays as 32-way
+     * tries. Modifying a @c PersistentValue returns a new document that
+     * shares every unchanged subtree with the original, so deriving a
+     * document costs O(log n) time and memory rather than a deep copy.
+     *
+     * Copying a @c PersistentValue only copies a reference.
+     *
+     * @tparam T_Allocator The allocator used for strings and keys.
+     *
+     * @note Object members are iterated in hash order, not insertion order.
+     */
+    template <typename T_Allocator = std::allocator<char>>
+    class PersistentValue
+    {
+    public:
+        using Source     = Value<T_Allocator>;
+        using BaseString = Source::BaseString;
+        using StringType = Source::StringType;
+        using Object     = detail::Hamt<BaseString, PersistentValue>;
+        using Array      = detail::Trie<PersistentValue>;
+
+
+        PersistentValue() noexcept = default;
+
+        PersistentValue(const Source &value)
+        {
+            if (value.is_null()) return;
+
+            if (const auto *object { value.template get_if<
+                                     typename Source::Object>() })
+            {
+                Object result;
+                for (const auto &member : *object)
+                    result = result.assoc(member.key,
+                                          PersistentValue { member.value });
+                m_impl = std::make_shared<const Impl>(std::move(result));
+            }
+            else if (const auto *array { value.template get_if<
+                                         typename Source::Array>() })
+            {
+                Array result;
+                for (const auto &item : *array)
+                    result = result.push_back(PersistentValue { item });
+                m_impl = std::make_shared<const Impl>(std::move(result));
+            }
+            else if (const auto *packed { value.template get_if<
+                                          types::BooleanArray>() })
+            {
+                Array result;
+                for (std::size_t i { 0 }; i < packed->size(); i++)
+                    result = result.push_back(
+                        PersistentValue { Source { (*packed)[i] } });
+                m_impl = std::make_shared<const Impl>(std::move(result));
+            }
+            else
+                m_impl = std::make_shared<const Impl>(mf_scalar(value));
+        }
+
+        PersistentValue(Object object)
+            : m_impl(std::make_shared<const Impl>(std::move(object)))
+        {
+        }
+
+        PersistentValue(Array array)
+            : m_impl(std::make_shared<const Impl>(std::move(array)))
+        {
+        }
+
+
+        [[nodiscard]]
+        auto
+        type() const noexcept -> ValueType
+        {
+            if (m_impl == nullptr) return ValueType::Null;
+
+            switch (m_impl->storage.index())
+            {
+            case 0:
+            case 1:  return ValueType::Integer;
+            case 2:  return ValueType::Float;
+            case 3:  return ValueType::Boolean;
+            case 4:  return ValueType::String;
+            case 5:  return ValueType::Array;
+            default: return ValueType::Object;
+            }
+        }
+
+
+        [[nodiscard]]
+        auto
+        is_null() const noexcept -> bool
+        {
+            return m_impl == nullptr;
+        }
+
+
+        /**
+         * @brief Checks whether both values share the same storage.
+         */
+        [[nodiscard]]
+        auto
+        identical(const PersistentValue &other) const noexcept -> bool
+        {
+            return m_impl == other.m_impl;
+        }
+
+
+        template <typename T_Type>
+        [[nodiscard]]
+        auto
+        get_if() const noexcept -> const T_Type *
+        {
+            if (m_impl == nullptr) return nullptr;
+            return std::get_if<T_Type>(&m_impl->storage);
+        }
+
+
+        /**
+         * @throws ValueError if the value does not hold a @p T_Type .
+         */
+        template <typename T_Type>
+        [[nodiscard]]
+        auto
+        get() const -> const T_Type &
+        {
+            if (const auto *ptr { get_if<T_Type>() }; ptr != nullptr)
+                return *ptr;
+            throw ValueError { "value does not hold the requested type" };
+        }
+
+
+        [[nodiscard]]
+        auto
+        find(std::string_view key) const noexcept -> const PersistentValue *
+        {
+            const auto *object { get_if<Object>() };
+            return object != nullptr ? object->find(key) : nullptr;
+        }
+
+
+        [[nodiscard]]
+        auto
+        at(std::string_view key) const -> const PersistentValue &
+        {
+            if (const auto *ptr { find(key) }; ptr != nullptr) return *ptr;
+            throw ValueError { "no member named '{}'", key };
+        }
+
+
+        [[nodiscard]]
+        auto
+        at(std::size_t index) const -> const PersistentValue &
+        {
+            return get<Array>().at(index);
+        }
+
+
+        [[nodiscard]]
+        auto
+        size() const noexcept -> std::size_t
+        {
+            if (const auto *array { get_if<Array>() }; array != nullptr)
+                return array->size();
+            if (const auto *object { get_if<Object>() }; object != nullptr)
+                return object->size();
+            return 0;
+        }
+
+
+        /**
+         * @brief Returns a document where the dotted @p path is set to
+         *        @p value .
+         *
+         * Missing objects along @p path are created. Numeric segments index
+         * into arrays.
+         *
+         * @throws ValueError if @p path runs through a scalar, an array index
+         *         is out of range, or the array would hold mixed types.
+         */
+        [[nodiscard]]
+        auto
+        with(std::string_view path, PersistentValue value) const
+            -> PersistentValue
+        {
+            const auto dot { path.find('.') };
+            const auto key { path.substr(0, dot) };
+            const auto rest { dot == std::string_view::npos
+                                  ? std::string_view {}
+                                  : path.substr(dot + 1) };
+
+            if (const auto *array { get_if<Array>() }; array != nullptr)
+            {
+                const auto index { mf_index(key) };
+                auto child { dot == std::string_view::npos
+                                 ? std::move(value)
+                                 : array->at(index).with(rest,
+                                                         std::move(value)) };
+
+                if (array->size() > 1
+                    && array->at(index == 0 ? 1 : 0).type() != child.type())
+                    throw ValueError {
+                        "arrays must contain a single data type"
+                    };
+                return array->set(index, std::move(child));
+            }
+
+            if (!is_null() && type() != ValueType::Object)
+                throw ValueError { "'{}' does not lead through objects",
+                                   path };
+
+            const auto *object { get_if<Object>() };
+            const auto *current { object != nullptr ? object->find(key)
+                                                    : nullptr };
+
+            auto child { dot == std::string_view::npos
+                             ? std::move(value)
+                             : (current != nullptr ? *current
+                                                   : PersistentValue {})
+                                   .with(rest, std::move(value)) };
+
+            return (object != nullptr ? *object : Object {})
+                .assoc(BaseString { key.begin(), key.end() },
+                       std::move(child));
+        }
+
+
+        /**
+         * @brief Returns a document without the member at the dotted @p path .
+         */
+        [[nodiscard]]
+        auto
+        without(std::string_view path) const -> PersistentValue
+        {
+            const auto *object { get_if<Object>() };
+            if (object == nullptr) return *this;
+
+            const auto dot { path.find('.') };
+            const auto key { path.substr(0, dot) };
+
+            if (dot == std::string_view::npos) return object->erase(key);
+
+            const auto *child { object->find(key) };
+            if (child == nullptr) return *this;
+
+            return object->assoc(BaseString { key.begin(), key.end() },
+                                 child->without(path.substr(dot + 1)));
+        }
+
+
+        /**
+         * @brief Materializes the document as a mutable @c Value .
+         */
+        [[nodiscard]]
+        auto
+        to_value() const -> Source
+        {
+            if (m_impl == nullptr) return {};
+
+            if (const auto *object { get_if<Object>() }; object != nullptr)
+            {
+                Source result { ValueType::Object };
+                object->for_each(
+                    [&result](const BaseString &key, const PersistentValue &v)
+                    { result.insert(key, v.to_value()); });
+                return result;
+            }
+
+            if (const auto *array { get_if<Array>() }; array != nullptr)
+            {
+                Source result { ValueType::Array };
+                for (std::size_t i { 0 }; i < array->size(); i++)
+                    result.push_back(array->at(i).to_value());
+                return result;
+            }
+
+            return std::visit(
+                []<typename T_Type>(const T_Type &scalar) -> Source
+                {
+                    if constexpr (std::is_same_v<T_Type, Object>
+                                  || std::is_same_v<T_Type, Array>)
+                        return {};
+                    else
+                        return scalar;
+                },
+                m_impl->storage);
+        }
+
+
+    private:
+        struct Impl
+        {
+            std::variant<types::Integer<types::Signed>,
+                         types::Integer<types::Unsigned>,
+                         types::Float,
+                         types::Boolean,
+                         StringType,
+                         Array,
+                         Object>
+                storage;
+        };
+
+        std::shared_ptr<const Impl> m_impl;
+
+
+        [[nodiscard]]
+        static auto
+        mf_scalar(const Source &value) -> Impl
+        {
+            using types::Integer, types::Signed, types::Unsigned;
+
+            if (const auto *i { value.template get_if<Integer<Signed>>() })
+                return { *i };
+            if (const auto *u { value.template get_if<Integer<Unsigned>>() })
+                return { *u };
+            if (const auto *f { value.template get_if<types::Float>() })
+                return { *f };
+            if (const auto *b { value.template get_if<types::Boolean>() })
+                return { *b };
+            return { value.template get<StringType>() };
+        }
+
+
+        [[nodiscard]]
+        static auto
+        mf_index(std::string_view segment) -> std::size_t
+        {
+            std::size_t index {};
+            const auto [ptr, ec] { std::from_chars(
+                segment.data(), segment.data() + segment.size(), index) };
+
+            if (ec != std::errc {} || ptr != segment.data() + segment.size())
+                throw ValueError { "'{}' is not an array index", segment };
+            return index;
+        }
+    };
+}
+
+#endif /* KONCPP_PERSISTENT__HH */
@@ -0,0 +1,381 @@
+/**
+ * @file koncpp/reload.hh
+ * @copyright Copyright (C) 2025-2026 Kei <RQuarx@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef KONCPP_RELOAD__HH
+#define KONCPP_RELOAD__HH
+#include <atomic>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "koncpp/.defs.hh"
+#include "koncpp/diff.hh"
+#include "koncpp/trace.hh"
+#include "koncpp/value.hh"
+
+
+namespace koncpp
+{
+    /**
+     * @brief A quiescent-state-based reclamation domain.
+     *
+     * Readers register a @c Slot and periodically announce that they hold no
+     * reference to a retired object by calling @c quiescent() , which is a
+     * single plain store. Retired objects are freed by the writer once every
+     * registered slot has announced a quiescent state after the retirement.
+     */
+    class KONCPP_PUBLIC EpochDomain
+    {
+    public:
+        struct alignas(64) Slot
+        {
+            /* 0 means the slot is unused. */
+            std::atomic<std::uint64_t> epoch;
+        };
+
+
+        EpochDomain() = default;
+        ~EpochDomain();
+
+        EpochDomain(const EpochDomain &)                     = delete;
+        auto operator=(const EpochDomain &) -> EpochDomain & = delete;
+
+
+        [[nodiscard]]
+        auto
+        epoch() const noexcept -> std::uint64_t
+        {
+            return m_epoch.load(std::memory_order_acquire);
+        }
+
+
+        void
+        quiescent(Slot &slot) const noexcept
+        {
+            slot.epoch.store(epoch(), std::memory_order_release);
+        }
+
+
+        [[nodiscard]]
+        auto enter() -> Slot *;
+        void leave(Slot *slot) noexcept;
+
+
+        /**
+         * @brief Schedules @p ptr to be freed with @p deleter once no reader
+         *        can still observe it.
+         */
+        void retire(void *ptr, void (*deleter)(void *));
+
+
+        /**
+         * @brief Frees every retired object no reader can still observe.
+         */
+        void collect();
+
+
+        [[nodiscard]]
+        auto pending() const -> std::size_t;
+
+
+    private:
+        struct Retired
+        {
+            std::uint64_t epoch;
+            void         *ptr;
+            void (*deleter)(void *);
+        };
+
+        std::atomic<std::uint64_t> m_epoch { 1 };
+
+        mutable std::mutex   m_mutex;
+        std::deque<Slot>     m_slots;
+        std::vector<Retired> m_retired;
+    };
+
+
+    /**
+     * @brief Calls a function whenever a file is written or replaced.
+     *
+     * Uses inotify on Linux and polls the modification time elsewhere.
+     * The parent directory is watched so that editors which save by
+     * renaming a temporary file are noticed as well.
+     */
+    class KONCPP_PUBLIC FileWatcher
+    {
+    public:
+        FileWatcher() = default;
+        ~FileWatcher();
+
+        FileWatcher(const FileWatcher &)                     = delete;
+        auto operator=(const FileWatcher &) -> FileWatcher & = delete;
+
+
+        /**
+         * @throws Exception if the file cannot be watched.
+         */
+        void start(std::filesystem::path path, std::function<void()> on_change);
+        void stop() noexcept;
+
+
+        [[nodiscard]]
+        auto running() const noexcept -> bool;
+
+
+    private:
+        std::thread       m_thread;
+        std::atomic<bool> m_running;
+    };
+
+
+    /**
+     * @brief A kon document that is reloaded whenever its file changes.
+     *
+     * Each load publishes a new immutable snapshot through an atomic pointer.
+     * Reading the current snapshot through a @c Reader is a single acquire
+     * load; it never locks or performs an atomic read-modify-write.
+     *
+     * A snapshot obtained from a @c Reader stays valid until that reader calls
+     * @c quiescent() , which request threads should do between requests.
+     *
+     * @tparam T_Allocator The allocator used by the documents.
+     *
+     * @warning Every @c Reader must be destroyed before the @c Reloadable .
+     */
+    template <typename T_Allocator = std::allocator<char>>
+    class Reloadable
+    {
+    public:
+        using Document = Value<T_Allocator>;
+        using Loader   = std::function<Document(const std::filesystem::path &)>;
+        using Changes  = Patch<T_Allocator>;
+        using Listener = std::function<void(const Document &previous,
+                                            const Document &current,
+                                            const Changes  &changes)>;
+
+
+        class Reader
+        {
+        public:
+            explicit Reader(Reloadable &owner)
+                : m_owner(&owner), m_slot(owner.m_domain.enter())
+            {
+            }
+
+            ~Reader()
+            {
+                if (m_slot != nullptr) m_owner->m_domain.leave(m_slot);
+            }
+
+            Reader(Reader &&other) noexcept
+                : m_owner(other.m_owner),
+                  m_slot(std::exchange(other.m_slot, nullptr))
+            {
+            }
+
+            Reader(const Reader &)                     = delete;
+            auto operator=(const Reader &) -> Reader & = delete;
+            auto operator=(Reader &&) -> Reader &      = delete;
+
+
+            [[nodiscard]]
+            auto
+            get() const noexcept -> const Document &
+            {
+                return *m_owner->m_current.load(std::memory_order_acquire);
+            }
+
+
+            [[nodiscard]]
+            auto
+            operator->() const noexcept -> const Document *
+            {
+                return &get();
+            }
+
+
+            /**
+             * @brief Announces that no snapshot obtained so far is in use.
+             */
+            void
+            quiescent() const noexcept
+            {
+                m_owner->m_domain.quiescent(*m_slot);
+            }
+
+
+        private:
+            Reloadable         *m_owner;
+            EpochDomain::Slot *m_slot;
+        };
+
+
+        /**
+         * @brief Loads @p path once with @p loader .
+         * @throws Whatever @p loader throws.
+         */
+        Reloadable(std::filesystem::path path, Loader loader)
+            : m_path(std::move(path)), m_loader(std::move(loader)),
+              m_current(new Document { m_loader(m_path) })
+        {
+        }
+
+
+        ~Reloadable()
+        {
+            m_watcher.stop();
+            delete m_current.load(std::memory_order_relaxed);
+        }
+
+
+        Reloadable(const Reloadable &)                     = delete;
+        auto operator=(const Reloadable &) -> Reloadable & = delete;
+
+
+        [[nodiscard]]
+        auto
+        reader() -> Reader
+        {
+            return Reader { *this };
+        }
+
+
+        /**
+         * @brief Sets the function called after every successful reload.
+         *
+         * The listener runs on the reloading thread and receives the previous
+         * and the new snapshot, with the @c diff() between them. The digest
+         * of each snapshot is kept for the next reload, so only the new one
+         * is hashed and unchanged members are skipped.
+         */
+        void
+        on_reload(Listener listener)
+        {
+            std::scoped_lock lock { m_mutex };
+            m_listener = std::move(listener);
+        }
+
+
+        /**
+         * @brief Loads the file again and publishes the new snapshot.
+         * @throws Whatever the loader throws, the current snapshot is kept.
+         *         Whatever the listener throws, after the new snapshot has
+         *         been published and the previous one retired.
+         */
+        void
+        reload()
+        {
+            trace::Span span { "reload" };
+
+            auto *next { new Document {} };
+
+            try
+            {
+                *next = m_loader(m_path);
+            }
+            catch (...)
+            {
+                delete next;
+                throw;
+            }
+
+            std::scoped_lock lock { m_mutex };
+            const auto      *previous { m_current.exchange(
+                next, std::memory_order_acq_rel) };
+
+            /* it stays valid for the listener until the next collect() */
+            m_domain.retire(const_cast<Document *>(previous),
+                            [](void *ptr)
+                            { delete static_cast<Document *>(ptr); });
+
+            if (m_listener)
+            {
+                if (!m_digest) m_digest = digest(*previous);
+
+                auto       current { digest(*next) };
+                const auto changes { diff(*previous, *m_digest, *next,
+                                          current) };
+                m_digest = std::move(current);
+                m_listener(*previous, *next, changes);
+            }
+            else
+                m_digest.reset();
+
+            m_domain.collect();
+        }
+
+
+        /**
+         * @brief Starts reloading in the background whenever the file changes.
+         *
+         * Failed loads are ignored and keep the current snapshot.
+         */
+        void
+        watch()
+        {
+            m_watcher.start(m_path,
+                            [this]
+                            {
+                                try
+                                {
+                                    reload();
+                                }
+                                catch (...)
+                                {}
+                            });
+        }
+
+
+        void
+        stop() noexcept
+        {
+            m_watcher.stop();
+        }
+
+
+        /**
+         * @brief Frees every retired snapshot that no reader can observe.
+         */
+        void
+        collect()
+        {
+            m_domain.collect();
+        }
+
+
+    private:
+        std::filesystem::path          m_path;
+        Loader                         m_loader;
+        Listener                       m_listener;
+        std::atomic<const Document *> m_current;
+
+        /* of the current snapshot, while there is a listener */
+        std::optional<Digest> m_digest;
+
+        std::mutex  m_mutex;
+        EpochDomain m_domain;
+        FileWatcher m_watcher;
+    };
+}
+
+#endif /* KONCPP_RELOAD__HH */
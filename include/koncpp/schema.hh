@@ -0,0 +1,711 @@
+/**
+ * @file koncpp/schema.hh
+ * @copyright Copyright (C) 2025-2026 Kei <RQuarx@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef KONCPP_SCHEMA__HH
+#define KONCPP_SCHEMA__HH
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "koncpp/.defs.hh"
+#include "koncpp/parser.hh"
+#include "koncpp/value.hh"
+
+
+namespace koncpp
+{
+    struct SchemaError : public Exception
+    {
+        using Exception::Exception;
+    };
+
+
+    /**
+     * @brief A compiled set of type, range, and presence rules.
+     *
+     * A @c Schema is compiled once into a flat table of rules keyed by the
+     * dotted path of each field, and is then shared by any number of
+     * @c Validator instances.
+     *
+     * A schema document is an object whose members are either a type name,
+     * a field specification, or a nested schema object:
+     *
+     * @code{.kon}
+     * name: "string"
+     * server:
+     *     port: { type: "uint"; min: 1; max: 65535; required: true }
+     *     ratio: { type: "float"; max: 1.0 }
+     * @endcode
+     *
+     * Valid type names are @c int , @c uint , @c float , @c bool , @c string ,
+     * @c array , @c object , and @c any .
+     */
+    class KONCPP_PUBLIC Schema
+    {
+    public:
+        static constexpr std::uint32_t NoSlot { ~std::uint32_t {} };
+
+        struct Rule
+        {
+            std::string path;
+
+            /* ValueType::Null accepts any type. */
+            ValueType type { ValueType::Null };
+
+            bool is_unsigned {};
+            bool required {};
+
+            std::optional<types::Signed> int_min;
+            std::optional<types::Signed> int_max;
+            std::optional<double>        float_min;
+            std::optional<double>        float_max;
+
+            /* Index into the required-key bitmap, or NoSlot. */
+            std::uint32_t slot { NoSlot };
+        };
+
+
+        Schema() = default;
+
+        /**
+         * @throws SchemaError if two rules share the same path.
+         */
+        Schema(std::vector<Rule> rules);
+
+
+        /**
+         * @brief Compiles a schema from a kon schema @p document .
+         * @throws SchemaError if the document is not a valid schema.
+         */
+        template <typename T_Allocator>
+        [[nodiscard]]
+        static auto
+        compile(const Value<T_Allocator> &document) -> Schema
+        {
+            if (document.type() != ValueType::Object)
+                throw SchemaError { "a schema document must be an object" };
+
+            std::vector<Rule> rules;
+            mf_lower(document, "", rules);
+            return { std::move(rules) };
+        }
+
+
+        [[nodiscard]]
+        auto find(std::string_view path) const noexcept -> const Rule *;
+
+
+        [[nodiscard]]
+        auto rules() const noexcept -> const std::vector<Rule> &;
+
+
+        [[nodiscard]]
+        auto required_count() const noexcept -> std::uint32_t;
+
+
+        [[nodiscard]]
+        static auto type_name(const Rule &rule) noexcept -> std::string_view;
+
+
+    private:
+        struct Hash
+        {
+            using is_transparent = void;
+
+            auto
+            operator()(std::string_view sv) const noexcept -> std::size_t
+            {
+                return std::hash<std::string_view> {}(sv);
+            }
+        };
+
+        std::vector<Rule> m_rules;
+        std::uint32_t     m_required {};
+
+        std::unordered_map<std::string, std::uint32_t, Hash, std::equal_to<>>
+            m_index;
+
+
+        static void mf_parse_type(std::string_view name, Rule &rule);
+
+
+        template <typename T_Allocator>
+        static void
+        mf_lower(const Value<T_Allocator> &object,
+                 const std::string        &prefix,
+                 std::vector<Rule>        &rules)
+        {
+            using ValueT = Value<T_Allocator>;
+
+            for (const auto &member : object.template get<
+                                      typename ValueT::Object>())
+            {
+                Rule rule;
+                rule.path = prefix.empty()
+                              ? std::string { member.key }
+                              : std::format("{}.{}", prefix, member.key);
+
+                const auto &spec { member.value };
+
+                if (const auto *name { spec.template get_if<
+                                       typename ValueT::StringType>() })
+                {
+                    mf_parse_type(*name->get(), rule);
+                    rules.push_back(std::move(rule));
+                    continue;
+                }
+
+                if (spec.type() != ValueType::Object)
+                    throw SchemaError { "'{}': expected a type name or an "
+                                        "object",
+                                        rule.path };
+
+                const auto *type { spec.find("type") };
+                if (type == nullptr)
+                {
+                    mf_lower(spec, rule.path, rules);
+                    continue;
+                }
+
+                const auto *name { type->template get_if<
+                                   typename ValueT::StringType>() };
+                if (name == nullptr)
+                    throw SchemaError { "'{}': 'type' must be a string",
+                                        rule.path };
+                mf_parse_type(*name->get(), rule);
+
+                if (const auto *required { spec.find("required") })
+                    rule.required = mf_to_bool(*required, rule.path);
+                if (const auto *min { spec.find("min") })
+                    mf_set_bound(*min, rule, rule.int_min, rule.float_min);
+                if (const auto *max { spec.find("max") })
+                    mf_set_bound(*max, rule, rule.int_max, rule.float_max);
+
+                rules.push_back(std::move(rule));
+            }
+        }
+
+
+        template <typename T_Allocator>
+        static auto
+        mf_to_bool(const Value<T_Allocator> &value, const std::string &path)
+            -> bool
+        {
+            /* Integer-compatible booleans, SYNTAX.md §2.4. */
+            if (const auto *b { value.template get_if<types::Boolean>() })
+                return static_cast<bool>(*b);
+            if (const auto *i { value.template get_if<types::Integer<>>() })
+                return i->get().value_or(0) != 0;
+
+            throw SchemaError { "'{}': 'required' must be a boolean", path };
+        }
+
+
+        template <typename T_Allocator>
+        static void
+        mf_set_bound(const Value<T_Allocator>     &value,
+                     const Rule                   &rule,
+                     std::optional<types::Signed> &int_bound,
+                     std::optional<double>        &float_bound)
+        {
+            if (rule.type == ValueType::Float)
+            {
+                if (const auto *f { value.template get_if<types::Float>() })
+                    float_bound = f->get();
+                else if (const auto *i {
+                             value.template get_if<types::Integer<>>() })
+                    float_bound = static_cast<double>(i->get().value_or(0));
+                else
+                    throw SchemaError { "'{}': bounds must be numbers",
+                                        rule.path };
+                return;
+            }
+
+            if (rule.type != ValueType::Integer)
+                throw SchemaError { "'{}': bounds are only valid on numbers",
+                                    rule.path };
+
+            if (const auto *i { value.template get_if<types::Integer<>>() })
+                int_bound = i->get();
+            else
+                throw SchemaError { "'{}': bounds of an integer must be "
+                                    "integers",
+                                    rule.path };
+        }
+    };
+
+
+    /**
+     * @brief A single-pass validator driven by a @c Schema .
+     *
+     * Every value is fed to the validator as soon as it has been produced,
+     * together with its dotted path, by a @c ValidatingBuilder during a
+     * parse. Each value is checked and
+     * coerced in place, so a document never has to be walked a second time:
+     *
+     * - an @c int fed to a @c uint rule becomes an @c Integer<Unsigned> , which
+     *   turns a negative number into null (SYNTAX.md §2.2.2),
+     * - an integer fed to a @c bool rule becomes a @c Boolean (SYNTAX.md §2.4).
+     *
+     * Paths not described by the schema are accepted as-is.
+     */
+    class KONCPP_PUBLIC Validator
+    {
+    public:
+        explicit Validator(const Schema &schema);
+
+
+        /**
+         * @brief Checks and coerces @p value against the rule for @p path .
+         * @returns false if @p value violates the rule, @c error() then
+         *          describes the violation.
+         */
+        template <typename T_Allocator>
+        auto
+        feed(std::string_view path, Value<T_Allocator> &value) -> bool
+        {
+            const auto *rule { mf_mark(path) };
+            if (rule == nullptr || value.is_null()) return true;
+
+            switch (rule->type)
+            {
+            case ValueType::Null: return true;
+
+            case ValueType::Integer:
+                if (value.template holds<types::Integer<types::Signed>>()
+                    && rule->is_unsigned)
+                    mf_coerce<types::Integer<types::Unsigned>>(
+                        value, value.template get<types::Integer<>>());
+                else if (value.template holds<types::Integer<types::Unsigned>>()
+                         && !rule->is_unsigned)
+                    return mf_narrow(*rule, value);
+                else if (value.type() != ValueType::Integer)
+                    return mf_fail(*rule);
+                return mf_check_int(*rule, value);
+
+            case ValueType::Float:
+                if (const auto *f { value.template get_if<types::Float>() })
+                    return mf_check_float(*rule, f->get());
+                return mf_fail(*rule);
+
+            case ValueType::Boolean:
+                if (const auto *i { value.template get_if<types::Integer<>>() })
+                    value = mf_to_boolean(i->get());
+                else if (const auto *u { value.template get_if<
+                                         types::Integer<types::Unsigned>>() })
+                    value = mf_to_boolean(u->get());
+                else if (value.type() != ValueType::Boolean)
+                    return mf_fail(*rule);
+                return true;
+
+            default:
+                return value.type() == rule->type || mf_fail(*rule);
+            }
+        }
+
+
+        /**
+         * @brief Checks that every required path has been fed.
+         */
+        [[nodiscard]]
+        auto finish() -> bool;
+
+
+        /**
+         * @brief Forgets every fed path so the validator can be reused.
+         */
+        void reset() noexcept;
+
+
+        [[nodiscard]]
+        auto error() const noexcept -> std::string_view;
+
+
+    private:
+        const Schema              *m_schema;
+        std::vector<std::uint64_t> m_seen;
+        std::string                m_error;
+
+
+        auto mf_mark(std::string_view path) -> const Schema::Rule *;
+        auto mf_fail(const Schema::Rule &rule) -> bool;
+        auto mf_check_range(const Schema::Rule &rule, bool below, bool above)
+            -> bool;
+
+
+        template <typename T_Int>
+        [[nodiscard]]
+        static auto
+        mf_to_boolean(const std::optional<T_Int> &value) -> types::Boolean
+        {
+            if (!value) return {};
+            return { *value != 0 };
+        }
+
+
+        template <typename T_To, typename T_Allocator, typename T_From>
+        static void
+        mf_coerce(Value<T_Allocator> &value, const T_From &from)
+        {
+            if (const auto raw { from.get() })
+                value = T_To { *raw };
+            else
+                value = Value<T_Allocator> {};
+        }
+
+
+        /* Checks an unsigned value against a signed rule before converting
+           it, as what does not fit in a Signed would become null. */
+        template <typename T_Allocator>
+        auto
+        mf_narrow(const Schema::Rule &rule, Value<T_Allocator> &value) -> bool
+        {
+            const auto &from { value.template get<
+                types::Integer<types::Unsigned>>() };
+            if (!mf_check_int(rule, value)) return false;
+
+            constexpr auto max { static_cast<types::Unsigned>(
+                std::numeric_limits<types::Signed>::max()) };
+            if (from.get() && *from.get() > max)
+                return mf_check_range(rule, false, true);
+
+            mf_coerce<types::Integer<types::Signed>>(value, from);
+            return true;
+        }
+
+
+        template <typename T_Allocator>
+        auto
+        mf_check_int(const Schema::Rule &rule, const Value<T_Allocator> &value)
+            -> bool
+        {
+            if (const auto *i { value.template get_if<types::Integer<>>() })
+            {
+                if (!i->get()) return true;
+                return mf_check_range(rule,
+                                      rule.int_min && *i->get() < *rule.int_min,
+                                      rule.int_max
+                                          && *i->get() > *rule.int_max);
+            }
+
+            if (const auto *u {
+                    value.template get_if<types::Integer<types::Unsigned>>() })
+            {
+                if (!u->get()) return true;
+
+                const auto raw { *u->get() };
+                constexpr auto max { static_cast<types::Unsigned>(
+                    std::numeric_limits<types::Signed>::max()) };
+
+                const auto fits { raw <= max };
+                const auto as_signed { static_cast<types::Signed>(raw) };
+
+                return mf_check_range(
+                    rule,
+                    fits && rule.int_min && as_signed < *rule.int_min,
+                    rule.int_max && (!fits || as_signed > *rule.int_max));
+            }
+
+            return true;
+        }
+
+
+        auto
+        mf_check_float(const Schema::Rule &rule, std::optional<double> value)
+            -> bool
+        {
+            if (!value) return true;
+            return mf_check_range(rule,
+                                  rule.float_min && *value < *rule.float_min,
+                                  rule.float_max && *value > *rule.float_max);
+        }
+    };
+
+
+    /**
+     * @brief A @c Builder that validates and coerces the members of a
+     *        document against a @c Schema while it is being parsed.
+     *
+     * A member is checked when its value is reported, before it is added
+     * to the document, and the prefixes of a dotted key are checked as
+     * objects. The items of arrays are not described by a schema and are
+     * built as they are.
+     *
+     * @tparam T_Allocator The allocator used by the built document.
+     */
+    template <typename T_Allocator = std::allocator<char>>
+    class ValidatingBuilder : public Handler
+    {
+    public:
+        explicit ValidatingBuilder(const Schema &schema)
+            : m_schema(schema), m_validator(schema)
+        {
+        }
+
+
+        /**
+         * @throws ValueError if a member violates its rule, which the parser
+         *         reports as a @c ParseError at that member.
+         */
+        void
+        key(std::string_view key) override
+        {
+            m_builder.key(key);
+            if (m_arrays > 0) return;
+
+            m_path.resize(m_bases.back());
+            if (!m_path.empty()) m_path.push_back('.');
+
+            for (auto dot { key.find('.') }; dot != std::string_view::npos;
+                 dot = key.find('.', dot + 1))
+            {
+                m_path.append(key.substr(0, dot));
+                mf_container(ValueType::Object);
+                m_path.resize(m_path.size() - dot);
+            }
+            m_path.append(key);
+        }
+
+
+        void
+        begin_object() override
+        {
+            if (!m_bases.empty()) mf_container(ValueType::Object);
+            if (m_arrays == 0) m_bases.push_back(m_path.size());
+            m_builder.begin_object();
+        }
+
+
+        void
+        end_object() override
+        {
+            if (m_arrays == 0) m_bases.pop_back();
+            m_builder.end_object();
+        }
+
+
+        void
+        begin_array() override
+        {
+            mf_container(ValueType::Array);
+            m_arrays++;
+            m_builder.begin_array();
+        }
+
+
+        void
+        end_array() override
+        {
+            m_arrays--;
+            m_builder.end_array();
+        }
+
+
+        void
+        null() override
+        {
+            mf_scalar([] { return ValueT {}; }, [&] { m_builder.null(); });
+        }
+
+
+        void
+        integer(types::Signed value) override
+        {
+            mf_scalar([&] { return ValueT { types::Integer<> { value } }; },
+                      [&] { m_builder.integer(value); });
+        }
+
+
+        void
+        unsigned_integer(types::Unsigned value) override
+        {
+            mf_scalar(
+                [&]
+                {
+                    return ValueT { types::Integer<types::Unsigned> {
+                        value } };
+                },
+                [&] { m_builder.unsigned_integer(value); });
+        }
+
+
+        void
+        floating(double value) override
+        {
+            mf_scalar([&] { return ValueT { types::Float { value } }; },
+                      [&] { m_builder.floating(value); });
+        }
+
+
+        void
+        boolean(bool value) override
+        {
+            mf_scalar([&] { return ValueT { types::Boolean { value } }; },
+                      [&] { m_builder.boolean(value); });
+        }
+
+
+        void
+        string(std::string_view value) override
+        {
+            using String = typename ValueT::StringType;
+
+            mf_scalar([&] { return ValueT { String { value } }; },
+                      [&] { m_builder.string(value); });
+        }
+
+
+        /**
+         * @brief Checks that every required member has been reported.
+         * @returns false if one is missing, @c error() then names it.
+         */
+        [[nodiscard]]
+        auto
+        finish() -> bool
+        {
+            return m_validator.finish();
+        }
+
+
+        [[nodiscard]]
+        auto
+        error() const noexcept -> std::string_view
+        {
+            return m_validator.error();
+        }
+
+
+        [[nodiscard]]
+        auto
+        take() -> Value<T_Allocator>
+        {
+            return m_builder.take();
+        }
+
+
+    private:
+        using ValueT = Value<T_Allocator>;
+
+        const Schema        &m_schema;
+        Validator            m_validator;
+        Builder<T_Allocator> m_builder;
+
+        std::string              m_path;  /* of the current member */
+        std::vector<std::size_t> m_bases; /* of m_path, per object */
+        std::size_t              m_arrays {};
+
+
+        /* Whether the current value has a rule to be checked against. */
+        [[nodiscard]]
+        auto
+        mf_checked() const -> bool
+        {
+            return m_arrays == 0 && !m_bases.empty()
+                && m_schema.find(m_path) != nullptr;
+        }
+
+
+        void
+        mf_feed(ValueT &value)
+        {
+            if (!m_validator.feed(m_path, value))
+                throw ValueError { "{}", m_validator.error() };
+        }
+
+
+        void
+        mf_container(ValueType type)
+        {
+            if (!mf_checked()) return;
+
+            ValueT value { type };
+            mf_feed(value);
+        }
+
+
+        template <typename T_Make, typename T_Forward>
+        void
+        mf_scalar(T_Make make, T_Forward forward)
+        {
+            if (!mf_checked())
+            {
+                forward();
+                return;
+            }
+
+            auto value { make() };
+            mf_feed(value);
+            mf_emit(value);
+        }
+
+
+        /* Reports a value, possibly coerced, to the builder. */
+        void
+        mf_emit(const ValueT &value)
+        {
+            using types::Unsigned;
+
+            if (const auto *i { value.template get_if<types::Integer<>>() };
+                i != nullptr && i->get())
+                m_builder.integer(*i->get());
+            else if (const auto *u { value.template get_if<
+                                     types::Integer<Unsigned>>() };
+                     u != nullptr && u->get())
+                m_builder.unsigned_integer(*u->get());
+            else if (const auto *f { value.template get_if<types::Float>() };
+                     f != nullptr && f->get())
+                m_builder.floating(*f->get());
+            else if (const auto *b { value.template get_if<types::Boolean>() };
+                     b != nullptr && b->get())
+                m_builder.boolean(*b->get());
+            else if (const auto *s { value.template get_if<
+                                     typename ValueT::StringType>() };
+                     s != nullptr && s->view())
+                m_builder.string(*s->view());
+            else
+                m_builder.null();
+        }
+    };
+
+
+    /**
+     * @brief Parses @p source into a @c Value tree, validating and coercing
+     *        its members against @p schema in the same pass.
+     *
+     * @throws ParseError if @p source is not valid kon, or does not match
+     *         @p schema . A member that violates its rule is reported at
+     *         its offset, a missing required member at the end of
+     *         @p source .
+     */
+    template <typename T_Allocator = std::allocator<char>>
+    [[nodiscard]]
+    auto
+    parse(std::string_view source, const Schema &schema) -> Value<T_Allocator>
+    {
+        ValidatingBuilder<T_Allocator> builder { schema };
+        Parser {}.parse(source, builder);
+
+        if (!builder.finish())
+            throw ParseError { { ErrorCode::InvalidValue, source.size() },
+                               builder.error() };
+        return builder.take();
+    }
+}
+
+#endif /* KONCPP_SCHEMA__HH */
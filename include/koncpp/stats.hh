@@ -0,0 +1,166 @@
+/**
+ * @file koncpp/stats.hh
+ * @copyright Copyright (C) 2025-2026 Kei <RQuarx@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef KONCPP_STATS__HH
+#define KONCPP_STATS__HH
+#include <chrono>
+#include <cstddef>
+
+
+namespace koncpp
+{
+    /**
+     * @brief Counters collected while parsing a single document.
+     *
+     * The counters are only filled in when koncpp is built with the @c stats
+     * option, which defines @c KONCPP_STATS . Otherwise every field stays
+     * zero and the parser pays nothing for them.
+     *
+     * The phases do not overlap and add up to @c total .
+     */
+    struct ParseStats
+    {
+        using Duration = std::chrono::nanoseconds;
+
+        Duration total {};
+        Duration scan {};     /* skipping spaces, comments and indentation */
+        Duration parse {};    /* the grammar, everything not counted below */
+        Duration unescape {}; /* reading and unescaping quoted strings */
+        Duration number {};   /* converting numbers */
+        Duration build {};    /* inside the handler's callbacks */
+
+        std::size_t bytes {};
+        std::size_t tokens {};
+        std::size_t allocations {};
+        std::size_t allocated_bytes {};
+
+
+        void
+        allocated(std::size_t size) noexcept
+        {
+            allocations++;
+            allocated_bytes += size;
+        }
+
+
+        [[nodiscard]]
+        auto operator==(const ParseStats &rhs) const noexcept -> bool
+            = default;
+    };
+
+
+    /**
+     * @brief Adds the time until it is destroyed to a @c ParseStats phase.
+     */
+    class StatsTimer
+    {
+    public:
+        explicit StatsTimer(ParseStats::Duration &phase) noexcept
+            : m_phase(phase), m_start(Clock::now())
+        {
+        }
+
+        StatsTimer(const StatsTimer &)                     = delete;
+        auto operator=(const StatsTimer &) -> StatsTimer & = delete;
+
+        ~StatsTimer()
+        {
+            m_phase += std::chrono::duration_cast<ParseStats::Duration>(
+                Clock::now() - m_start);
+        }
+
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        ParseStats::Duration &m_phase;
+        Clock::time_point     m_start;
+    };
+
+
+    /**
+     * @brief Counts an allocation if a container grows before this is
+     *        destroyed.
+     *
+     * Several reallocations in the lifetime of one counter are counted as a
+     * single allocation of the final capacity.
+     */
+    template <typename T_Container>
+    class GrowthCounter
+    {
+    public:
+        GrowthCounter(ParseStats *stats, const T_Container &container) noexcept
+            : m_stats(stats), m_container(container),
+              m_capacity(container.capacity())
+        {
+        }
+
+        GrowthCounter(const GrowthCounter &)                     = delete;
+        auto operator=(const GrowthCounter &) -> GrowthCounter & = delete;
+
+        ~GrowthCounter()
+        {
+            if (m_stats != nullptr && m_container.capacity() != m_capacity)
+                m_stats->allocated(m_container.capacity()
+                                   * sizeof(typename T_Container::value_type));
+        }
+
+
+    private:
+        ParseStats        *m_stats;
+        const T_Container &m_container;
+        std::size_t        m_capacity;
+    };
+}
+
+
+/* clang-format off */
+
+#define KONCPP_STATS_CONCAT_(a, b) a##b
+#define KONCPP_STATS_CONCAT(a, b)  KONCPP_STATS_CONCAT_(a, b)
+
+#ifdef KONCPP_STATS
+    /* Code that only exists in statistics builds. */
+    #define KONCPP_STATS_ONLY(...) __VA_ARGS__
+
+    /* Times the rest of the enclosing scope into @p stats . @p phase . */
+    #define KONCPP_STATS_TIME(stats, phase)                              \
+        const ::koncpp::StatsTimer KONCPP_STATS_CONCAT(koncpp_timer_,    \
+                                                       __LINE__) {       \
+            (stats).phase                                                \
+        }
+
+    /* Counts the growth of @p container in the rest of the scope. */
+    #define KONCPP_STATS_GROWTH(stats, container)                        \
+        const ::koncpp::GrowthCounter KONCPP_STATS_CONCAT(koncpp_growth_, \
+                                                          __LINE__) {     \
+            (stats), (container)                                         \
+        }
+
+    #define KONCPP_STATS_ADD(stats, field, amount) \
+        ((stats).field += (amount))
+#else
+    #define KONCPP_STATS_ONLY(...)
+    #define KONCPP_STATS_TIME(stats, phase)
+    #define KONCPP_STATS_GROWTH(stats, container)
+    #define KONCPP_STATS_ADD(stats, field, amount) ((void)0)
+#endif
+
+/* clang-format on */
+
+#endif /* KONCPP_STATS__HH */
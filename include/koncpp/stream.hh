@@ -0,0 +1,438 @@
+/**
+ * @file koncpp/stream.hh
+ * @copyright Copyright (C) 2025-2026 Kei <RQuarx@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef KONCPP_STREAM__HH
+#define KONCPP_STREAM__HH
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "koncpp/.defs.hh"
+#include "koncpp/parser.hh"
+
+
+namespace koncpp
+{
+    namespace detail
+    {
+        /**
+         * @brief Finds where top-level members end in kon that arrives in
+         *        chunks.
+         *
+         * A top-level member ends where a line starting with a letter
+         * follows it, outside of strings, comments and brackets. Lines
+         * starting with anything else, such as an indented member or an
+         * adjacent string, continue it.
+         */
+        class KONCPP_PUBLIC Splitter
+        {
+        public:
+            void feed(std::string_view chunk);
+
+            /**
+             * @brief Marks the end of the input, everything fed is complete.
+             */
+            void finish();
+
+
+            /**
+             * @brief Returns the text of the first complete member, with the
+             *        comments and blank lines that follow it, or nothing.
+             *
+             * The view is valid until the next call to @c feed() .
+             */
+            [[nodiscard]]
+            auto
+            complete() const noexcept -> std::string_view
+            {
+                if (m_ends.empty()) return {};
+                return std::string_view { m_buffer }.substr(
+                    m_start, m_ends.front() - m_start);
+            }
+
+
+            /**
+             * @brief Drops the text returned by @c complete() .
+             */
+            void
+            consume() noexcept
+            {
+                m_start = m_ends.front();
+                m_ends.pop_front();
+            }
+
+
+            /**
+             * @brief Returns the offset of @c complete() in the input.
+             */
+            [[nodiscard]]
+            auto
+            offset() const noexcept -> std::size_t
+            {
+                return m_offset + m_start;
+            }
+
+
+        private:
+            enum class State : std::uint8_t
+            {
+                Code,
+                String,
+                LineComment,
+                BlockComment
+            };
+
+            std::string             m_buffer;
+            std::size_t             m_start {};  /* of the first member */
+            std::deque<std::size_t> m_ends;      /* of the complete ones */
+            std::size_t             m_pos {};    /* how far it was scanned */
+            std::size_t             m_offset {}; /* of m_buffer in the input */
+            std::size_t             m_depth {};  /* of brackets */
+            State                   m_state { State::Code };
+            bool                    m_finished {};
+
+
+            void mf_scan();
+        };
+    }
+
+
+    /**
+     * @brief Parses kon that arrives in chunks, one top-level member at a
+     *        time.
+     *
+     * A member is available from @c next() once the key of the member
+     * after it has been fed, or the input has been finished. Only the text
+     * of the members that are not complete yet is kept.
+     *
+     * Every member is parsed on its own, so the members yielded never
+     * depend on how the input was split into chunks. A dotted key is not
+     * merged into an object written before it: @c a.b: @c 1 after @c a:
+     * is a second member named @c a , holding only @c b . A key written
+     * twice is yielded twice, rather than rejected as @c parse() does.
+     *
+     * @tparam T_Allocator The allocator used by the parsed values.
+     */
+    template <typename T_Allocator = std::allocator<char>>
+    class StreamParser
+    {
+    public:
+        using Member = typename Value<T_Allocator>::Member;
+
+
+        StreamParser() = default;
+        explicit StreamParser(std::size_t tab_width) : m_parser(tab_width) {}
+
+
+        /**
+         * @throws ParseError if a member completed by @p chunk is not valid
+         *         kon. Its offset is counted from the start of the input.
+         *         Nothing can be fed afterwards.
+         */
+        void
+        feed(std::string_view chunk)
+        {
+            m_splitter.feed(chunk);
+            mf_parse();
+        }
+
+
+        /**
+         * @brief Marks the end of the input, completing the last member.
+         * @throws ParseError as @c feed() does.
+         */
+        void
+        finish()
+        {
+            m_splitter.finish();
+            mf_parse();
+        }
+
+
+        /**
+         * @brief Returns the next complete member, if there is one.
+         */
+        [[nodiscard]]
+        auto
+        next() -> std::optional<Member>
+        {
+            if (m_members.empty()) return std::nullopt;
+
+            auto member { std::move(m_members.front()) };
+            m_members.pop_front();
+            return member;
+        }
+
+
+    private:
+        Parser             m_parser;
+        detail::Splitter   m_splitter;
+        std::deque<Member> m_members;
+
+
+        void
+        mf_parse()
+        {
+            using Object = typename Value<T_Allocator>::Object;
+
+            for (auto text { m_splitter.complete() }; !text.empty();
+                 text = m_splitter.complete())
+            {
+                Builder<T_Allocator> builder;
+                if (auto result { m_parser.try_parse(text, builder) }; !result)
+                {
+                    auto error { result.error() };
+                    error.offset += m_splitter.offset();
+                    throw ParseError { error };
+                }
+
+                /* one member, or none for a leading comment */
+                auto document { builder.take() };
+                for (auto &member : document.template get<Object>())
+                    m_members.push_back(std::move(member));
+
+                m_splitter.consume();
+            }
+        }
+    };
+
+
+    /**
+     * @brief The members of a document parsed by @c parse_stream() , as
+     *        they are completed.
+     *
+     * The parse runs in the coroutine awaiting @c next() until it needs
+     * more input. It is then suspended in the awaitable of the reader, and
+     * resumes wherever that awaitable resumes it, such as on the thread of
+     * an event loop once data has arrived. A member is handed to the
+     * awaiting coroutine directly, without going through an executor.
+     */
+    template <typename T_Allocator = std::allocator<char>>
+    class MemberStream
+    {
+    public:
+        using Member = typename Value<T_Allocator>::Member;
+
+        struct promise_type;
+        using Handle = std::coroutine_handle<promise_type>;
+
+
+        /* Returns to the coroutine awaiting next(). */
+        struct Yield
+        {
+            [[nodiscard]]
+            auto
+            await_ready() const noexcept -> bool
+            {
+                return false;
+            }
+
+
+            auto
+            await_suspend(Handle self) noexcept -> std::coroutine_handle<>
+            {
+                return self.promise().consumer;
+            }
+
+
+            void
+            await_resume() const noexcept
+            {
+            }
+        };
+
+
+        struct promise_type
+        {
+            std::optional<Member>   current;
+            std::exception_ptr      error;
+            std::coroutine_handle<> consumer { std::noop_coroutine() };
+
+
+            auto
+            get_return_object() noexcept -> MemberStream
+            {
+                return MemberStream { Handle::from_promise(*this) };
+            }
+
+
+            auto
+            initial_suspend() const noexcept -> std::suspend_always
+            {
+                return {};
+            }
+
+
+            auto
+            final_suspend() const noexcept -> Yield
+            {
+                return {};
+            }
+
+
+            auto
+            yield_value(Member member) -> Yield
+            {
+                current = std::move(member);
+                return {};
+            }
+
+
+            void
+            return_void() const noexcept
+            {
+            }
+
+
+            void
+            unhandled_exception() noexcept
+            {
+                error = std::current_exception();
+            }
+        };
+
+
+        /* Resumes the parse until it yields a member or ends. */
+        struct Next
+        {
+            Handle handle;
+
+
+            [[nodiscard]]
+            auto
+            await_ready() const noexcept -> bool
+            {
+                return !handle || handle.done();
+            }
+
+
+            auto
+            await_suspend(std::coroutine_handle<> consumer) noexcept
+                -> std::coroutine_handle<>
+            {
+                handle.promise().consumer = consumer;
+                return handle;
+            }
+
+
+            auto
+            await_resume() -> std::optional<Member>
+            {
+                if (!handle) return std::nullopt;
+
+                auto &promise { handle.promise() };
+                if (promise.error)
+                    std::rethrow_exception(std::exchange(promise.error, {}));
+                return std::exchange(promise.current, std::nullopt);
+            }
+        };
+
+
+        MemberStream(MemberStream &&other) noexcept
+            : m_handle(std::exchange(other.m_handle, {}))
+        {
+        }
+
+        auto
+        operator=(MemberStream &&other) noexcept -> MemberStream &
+        {
+            if (this != &other)
+            {
+                if (m_handle) m_handle.destroy();
+                m_handle = std::exchange(other.m_handle, {});
+            }
+            return *this;
+        }
+
+        ~MemberStream()
+        {
+            if (m_handle) m_handle.destroy();
+        }
+
+
+        /**
+         * @brief Returns an awaitable for the next member, which is empty
+         *        once the input has ended.
+         *
+         * Only one @c next() may be awaited at a time.
+         *
+         * @throws ParseError , or what the reader threw, when awaited.
+         */
+        [[nodiscard]]
+        auto
+        next() const noexcept -> Next
+        {
+            return Next { m_handle };
+        }
+
+
+    private:
+        Handle m_handle;
+
+
+        explicit MemberStream(Handle handle) noexcept : m_handle(handle) {}
+    };
+
+
+    /**
+     * @brief Parses the kon returned by @p read , yielding each top-level
+     *        member as soon as it is complete.
+     *
+     * @p read is called for every chunk of input and returns an awaitable
+     * of something convertible to @c std::string_view . An empty chunk
+     * ends the input. A chunk only has to stay valid until @p read is
+     * called again.
+     *
+     * @code
+     * auto members { koncpp::parse_stream(
+     *     [&] { return socket.async_read_some(buffer); }) };
+     *
+     * while (auto member { co_await members.next() })
+     *     handle(member->key, member->value);
+     * @endcode
+     *
+     * @see StreamParser for how members are split.
+     */
+    template <typename T_Allocator = std::allocator<char>, typename T_Reader>
+    auto
+    parse_stream(T_Reader read) -> MemberStream<T_Allocator>
+    {
+        StreamParser<T_Allocator> parser;
+
+        while (true)
+        {
+            /* the chunk may own its bytes, as a std::string does */
+            const auto             owned { co_await read() };
+            const std::string_view chunk { owned };
+            if (chunk.empty()) break;
+
+            parser.feed(chunk);
+            while (auto member { parser.next() }) co_yield std::move(*member);
+        }
+
+        parser.finish();
+        while (auto member { parser.next() }) co_yield std::move(*member);
+    }
+}
+
+#endif /* KONCPP_STREAM__HH */
@@ -0,0 +1,128 @@
+/**
+ * @file koncpp/trace.hh
+ * @copyright Copyright (C) 2025-2026 Kei <RQuarx@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef KONCPP_TRACE__HH
+#define KONCPP_TRACE__HH
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+#include "koncpp/.defs.hh"
+#include "koncpp/types/base.hh"
+
+
+/**
+ * A timeline of what koncpp does, written as Chrome trace events.
+ *
+ * While tracing is on, every parse and reload is recorded as a complete
+ * event with the thread it ran on. The file can be opened directly in
+ * chrome://tracing or https://ui.perfetto.dev, without a tracing service.
+ */
+namespace koncpp::trace
+{
+    struct TraceError : public Exception
+    {
+        using Exception::Exception;
+    };
+
+
+    namespace detail
+    {
+        extern KONCPP_PUBLIC std::atomic<bool> enabled;
+    }
+
+
+    /**
+     * @brief Starts writing events to @p path , replacing its contents.
+     *
+     * Tracing is process-wide. Starting it again first stops the current
+     * trace.
+     *
+     * @throws TraceError if @p path cannot be opened.
+     */
+    KONCPP_PUBLIC void start(const std::filesystem::path &path);
+
+
+    /**
+     * @brief Finishes the trace file and stops recording.
+     *
+     * Spans that are still open when tracing stops are dropped.
+     */
+    KONCPP_PUBLIC void stop();
+
+
+    [[nodiscard]]
+    inline auto
+    enabled() noexcept -> bool
+    {
+        return detail::enabled.load(std::memory_order_relaxed);
+    }
+
+
+    /**
+     * @brief Records the lifetime of the object as one event.
+     *
+     * When tracing is off, constructing a span costs a single branch.
+     * @p name , @p category and argument keys must outlive the span and need
+     * no escaping in JSON, string literals are the intended use.
+     */
+    class KONCPP_PUBLIC Span
+    {
+    public:
+        explicit Span(const char *name, const char *category = "koncpp")
+        {
+            if (enabled()) mf_begin(name, category);
+        }
+
+        ~Span()
+        {
+            if (m_name != nullptr) mf_end();
+        }
+
+        Span(const Span &)                     = delete;
+        auto operator=(const Span &) -> Span & = delete;
+
+
+        /**
+         * @brief Attaches a number to the event, shown in its details.
+         */
+        void
+        arg(const char *key, std::int64_t value)
+        {
+            if (m_name != nullptr) mf_arg(key, value);
+        }
+
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        const char       *m_name {};
+        const char       *m_category {};
+        Clock::time_point m_start;
+        std::string       m_args;
+
+
+        void mf_begin(const char *name, const char *category) noexcept;
+        void mf_arg(const char *key, std::int64_t value);
+        void mf_end() noexcept;
+    };
+}
+
+#endif /* KONCPP_TRACE__HH */
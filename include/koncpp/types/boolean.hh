@@ -52,9 +52,12 @@ namespace koncpp::types
         };
 
     public:
-        Boolean() noexcept;
-        Boolean(const Boolean &other) noexcept;
-        Boolean(Boolean &&other) noexcept;
+        Boolean() noexcept : m_value(Value::Null) {}
+        Boolean(const Boolean &other) noexcept : m_value(other.m_value) {}
+        Boolean(Boolean &&other) noexcept : m_value(other.m_value)
+        {
+            if (this != &other) other.m_value = Value::Null;
+        }
 
         template <typename T_Type>
         Boolean(T_Type value)
@@ -64,8 +67,26 @@ namespace koncpp::types
         }
 
 
-        auto operator=(const Boolean &other) noexcept -> Boolean &;
-        auto operator=(Boolean &&other) noexcept -> Boolean &;
+        auto
+        operator=(const Boolean &other) noexcept -> Boolean &
+        {
+            m_value = other.m_value;
+            return *this;
+        }
+
+
+        auto
+        operator=(Boolean &&other) noexcept -> Boolean &
+        {
+            if (this != &other)
+            {
+                m_value       = other.m_value;
+                other.m_value = Value::Null;
+            }
+
+            return *this;
+        }
+
 
         template <typename T_Type>
         auto
@@ -82,7 +103,12 @@ namespace koncpp::types
 
 
         [[nodiscard]]
-        auto get() const noexcept -> std::optional<bool>;
+        auto
+        get() const noexcept -> std::optional<bool>
+        {
+            if (m_value == Value::Null) return Null;
+            return m_value == Value::True;
+        }
 
 
         template <typename T_Type>
@@ -94,18 +120,54 @@ namespace koncpp::types
         }
 
 
-        operator bool() const noexcept;
+        operator bool() const noexcept { return m_value == Value::True; }
+
+        auto
+        operator!() const noexcept -> bool
+        {
+            return m_value != Value::True;
+        }
+
+
+        auto
+        operator==(const Boolean &rhs) const noexcept -> bool
+        {
+            return m_value == rhs.m_value;
+        }
 
-        auto operator!() const noexcept -> bool;
+        auto
+        operator!=(const Boolean &rhs) const noexcept -> bool
+        {
+            return m_value != rhs.m_value;
+        }
 
-        auto operator==(const Boolean &rhs) const noexcept -> bool;
-        auto operator!=(const Boolean &rhs) const noexcept -> bool;
 
-        auto operator&&(const Boolean &rhs) const noexcept -> Boolean;
-        auto operator||(const Boolean &rhs) const noexcept -> Boolean;
+        auto
+        operator&&(const Boolean &rhs) const noexcept -> Boolean
+        {
+            return { static_cast<bool>(*this) && static_cast<bool>(rhs) };
+        }
 
-        auto operator&=(const Boolean &rhs) -> Boolean &;
-        auto operator|=(const Boolean &rhs) -> Boolean &;
+        auto
+        operator||(const Boolean &rhs) const noexcept -> Boolean
+        {
+            return { static_cast<bool>(*this) || static_cast<bool>(rhs) };
+        }
+
+
+        auto
+        operator&=(const Boolean &rhs) -> Boolean &
+        {
+            *this = static_cast<bool>(*this) && static_cast<bool>(rhs);
+            return *this;
+        }
+
+        auto
+        operator|=(const Boolean &rhs) -> Boolean &
+        {
+            *this = static_cast<bool>(*this) || static_cast<bool>(rhs);
+            return *this;
+        }
 
 
     private:
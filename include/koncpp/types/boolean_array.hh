@@ -0,0 +1,168 @@
+/**
+ * @file koncpp/types/boolean_array.hh
+ * @copyright Copyright (C) 2025-2026 Kei <RQuarx@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef KONCPP_TYPES__BOOLEAN_ARRAY__HH
+#define KONCPP_TYPES__BOOLEAN_ARRAY__HH
+#include <algorithm>
+#include <optional>
+#include <utility>
+
+#include "koncpp/bitmap.hh"
+#include "koncpp/types/boolean.hh"
+
+
+namespace koncpp::types
+{
+    /**
+     * @brief An array of booleans packed into two bitmaps, SYNTAX.md §2.6.
+     *
+     * Bit @c i of @c values() is the value of element @c i , and bit @c i
+     * of @c validity() is clear if the element is null. The value bits of
+     * null elements are always clear, so whole words can be combined
+     * without masking them.
+     *
+     * An element takes two bits, where a boxed @c Boolean in an array takes
+     * a whole @c Value .
+     */
+    class BooleanArray
+    {
+    public:
+        BooleanArray() = default;
+
+
+        void
+        push_back(std::optional<bool> value)
+        {
+            m_values.push_back(value.value_or(false));
+            m_validity.push_back(value.has_value());
+        }
+
+
+        void
+        reserve(std::size_t size)
+        {
+            m_values.reserve(size);
+            m_validity.reserve(size);
+        }
+
+
+        [[nodiscard]]
+        auto
+        size() const noexcept -> std::size_t
+        {
+            return m_values.size();
+        }
+
+
+        [[nodiscard]]
+        auto
+        empty() const noexcept -> bool
+        {
+            return m_values.empty();
+        }
+
+
+        [[nodiscard]]
+        auto
+        get(std::size_t index) const noexcept -> std::optional<bool>
+        {
+            if (!m_validity.test(index)) return std::nullopt;
+            return m_values.test(index);
+        }
+
+
+        /**
+         * @brief Returns element @p index as a boxed @c Boolean .
+         */
+        [[nodiscard]]
+        auto
+        operator[](std::size_t index) const noexcept -> Boolean
+        {
+            if (const auto value { get(index) }) return Boolean { *value };
+            return {};
+        }
+
+
+        [[nodiscard]]
+        auto
+        values() const noexcept -> const Bitmap &
+        {
+            return m_values;
+        }
+
+
+        [[nodiscard]]
+        auto
+        validity() const noexcept -> const Bitmap &
+        {
+            return m_validity;
+        }
+
+
+        [[nodiscard]]
+        auto
+        null_count() const noexcept -> std::size_t
+        {
+            return size() - m_validity.count();
+        }
+
+
+        /**
+         * @brief Returns the heap bytes held by both bitmaps.
+         */
+        [[nodiscard]]
+        auto
+        capacity_bytes() const noexcept -> std::size_t
+        {
+            return (m_values.capacity() + m_validity.capacity())
+                 / Bitmap::WordBits * sizeof(Bitmap::Word);
+        }
+
+
+        [[nodiscard]]
+        auto
+        operator==(const BooleanArray &rhs) const noexcept -> bool
+            = default;
+
+
+    protected:
+        explicit BooleanArray(Bitmap values)
+            : m_values(std::move(values)), m_validity(m_values.size(), true)
+        {
+        }
+
+
+        /* Clears the value bits of null elements. Whether both bitmaps are
+           the same size is left to the caller. */
+        BooleanArray(Bitmap values, Bitmap validity) noexcept
+            : m_values(std::move(values)), m_validity(std::move(validity))
+        {
+            const auto valid { m_validity.words() };
+            const auto words { m_values.words() };
+            const auto count { std::min(words.size(), valid.size()) };
+            for (std::size_t w { 0 }; w < count; w++) words[w] &= valid[w];
+        }
+
+
+    private:
+        Bitmap m_values;
+        Bitmap m_validity;
+    };
+}
+
+#endif /* KONCPP_TYPES__BOOLEAN_ARRAY__HH */
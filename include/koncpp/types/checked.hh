@@ -0,0 +1,209 @@
+/**
+ * @file koncpp/types/checked.hh
+ * @copyright Copyright (C) 2025-2026 Kei <RQuarx@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef KONCPP_TYPES__CHECKED__HH
+#define KONCPP_TYPES__CHECKED__HH
+#include <cmath>
+#include <expected>
+#include <limits>
+
+#include "koncpp/error.hh"
+#include "koncpp/types/float.hh"
+#include "koncpp/types/integer.hh"
+
+
+/**
+ * Arithmetic that reports failures as an @c ErrorCode instead of throwing.
+ *
+ * Unlike the operators, these functions also reject null operands and
+ * integer overflow, and never allocate.
+ */
+namespace koncpp::types
+{
+    namespace detail
+    {
+        template <typename T_Type, typename T_Func>
+        [[nodiscard]]
+        constexpr auto
+        checked(std::optional<T_Type> lhs,
+                std::optional<T_Type> rhs,
+                T_Func                func) noexcept
+            -> std::expected<T_Type, ErrorCode>
+        {
+            if (!lhs || !rhs) return std::unexpected { ErrorCode::NullOperand };
+            return func(*lhs, *rhs);
+        }
+
+
+        /* Finite operands must not produce an infinite result. */
+        [[nodiscard]]
+        inline auto
+        finite(double lhs, double rhs, double result) noexcept
+            -> std::expected<double, ErrorCode>
+        {
+            if (std::isinf(result) && std::isfinite(lhs) && std::isfinite(rhs))
+                return std::unexpected { ErrorCode::Overflow };
+            return result;
+        }
+    }
+
+
+    template <IntType T_Int>
+    [[nodiscard]]
+    auto
+    checked_add(const Integer<T_Int> &lhs, const Integer<T_Int> &rhs) noexcept
+        -> std::expected<Integer<T_Int>, ErrorCode>
+    {
+        return detail::checked(
+            lhs.get(), rhs.get(),
+            [](T_Int a, T_Int b) -> std::expected<T_Int, ErrorCode>
+            {
+                T_Int result {};
+                if (__builtin_add_overflow(a, b, &result))
+                    return std::unexpected { ErrorCode::Overflow };
+                return result;
+            });
+    }
+
+
+    template <IntType T_Int>
+    [[nodiscard]]
+    auto
+    checked_sub(const Integer<T_Int> &lhs, const Integer<T_Int> &rhs) noexcept
+        -> std::expected<Integer<T_Int>, ErrorCode>
+    {
+        return detail::checked(
+            lhs.get(), rhs.get(),
+            [](T_Int a, T_Int b) -> std::expected<T_Int, ErrorCode>
+            {
+                T_Int result {};
+                if (__builtin_sub_overflow(a, b, &result))
+                    return std::unexpected { ErrorCode::Overflow };
+                return result;
+            });
+    }
+
+
+    template <IntType T_Int>
+    [[nodiscard]]
+    auto
+    checked_mul(const Integer<T_Int> &lhs, const Integer<T_Int> &rhs) noexcept
+        -> std::expected<Integer<T_Int>, ErrorCode>
+    {
+        return detail::checked(
+            lhs.get(), rhs.get(),
+            [](T_Int a, T_Int b) -> std::expected<T_Int, ErrorCode>
+            {
+                T_Int result {};
+                if (__builtin_mul_overflow(a, b, &result))
+                    return std::unexpected { ErrorCode::Overflow };
+                return result;
+            });
+    }
+
+
+    template <IntType T_Int>
+    [[nodiscard]]
+    auto
+    checked_div(const Integer<T_Int> &lhs, const Integer<T_Int> &rhs) noexcept
+        -> std::expected<Integer<T_Int>, ErrorCode>
+    {
+        return detail::checked(
+            lhs.get(), rhs.get(),
+            [](T_Int a, T_Int b) -> std::expected<T_Int, ErrorCode>
+            {
+                if (b == 0)
+                    return std::unexpected { ErrorCode::DivisionByZero };
+                if constexpr (std::is_signed_v<T_Int>)
+                    if (a == std::numeric_limits<T_Int>::min() && b == -1)
+                        return std::unexpected { ErrorCode::Overflow };
+                return a / b;
+            });
+    }
+
+
+    template <IntType T_Int>
+    [[nodiscard]]
+    auto
+    checked_mod(const Integer<T_Int> &lhs, const Integer<T_Int> &rhs) noexcept
+        -> std::expected<Integer<T_Int>, ErrorCode>
+    {
+        return detail::checked(
+            lhs.get(), rhs.get(),
+            [](T_Int a, T_Int b) -> std::expected<T_Int, ErrorCode>
+            {
+                if (b == 0)
+                    return std::unexpected { ErrorCode::DivisionByZero };
+                /* the result is 0, but computing it traps */
+                if constexpr (std::is_signed_v<T_Int>)
+                    if (b == -1) return T_Int { 0 };
+                return a % b;
+            });
+    }
+
+
+    [[nodiscard]]
+    inline auto
+    checked_add(const Float &lhs, const Float &rhs) noexcept
+        -> std::expected<Float, ErrorCode>
+    {
+        return detail::checked(lhs.get(), rhs.get(),
+                               [](double a, double b)
+                               { return detail::finite(a, b, a + b); });
+    }
+
+
+    [[nodiscard]]
+    inline auto
+    checked_sub(const Float &lhs, const Float &rhs) noexcept
+        -> std::expected<Float, ErrorCode>
+    {
+        return detail::checked(lhs.get(), rhs.get(),
+                               [](double a, double b)
+                               { return detail::finite(a, b, a - b); });
+    }
+
+
+    [[nodiscard]]
+    inline auto
+    checked_mul(const Float &lhs, const Float &rhs) noexcept
+        -> std::expected<Float, ErrorCode>
+    {
+        return detail::checked(lhs.get(), rhs.get(),
+                               [](double a, double b)
+                               { return detail::finite(a, b, a * b); });
+    }
+
+
+    [[nodiscard]]
+    inline auto
+    checked_div(const Float &lhs, const Float &rhs) noexcept
+        -> std::expected<Float, ErrorCode>
+    {
+        return detail::checked(
+            lhs.get(), rhs.get(),
+            [](double a, double b) -> std::expected<double, ErrorCode>
+            {
+                if (b == 0)
+                    return std::unexpected { ErrorCode::DivisionByZero };
+                return detail::finite(a, b, a / b);
+            });
+    }
+}
+
+#endif /* KONCPP_TYPES__CHECKED__HH */
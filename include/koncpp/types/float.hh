@@ -20,69 +20,228 @@ namespace koncpp::types
      *
      * It supports standard arithmetic, and comparison operations.
      * Attempting to operate on a null @c Float will throw an @c FloatError.
+     *
+     * The operators are defined inline so that loops over @c Float compile
+     * down to plain floating point instructions.
      */
     class KONCPP_PUBLIC Float : public BaseType
     {
     public:
-        Float() noexcept;
-
-        Float(double value) noexcept;
-        Float(const Float &other) noexcept;
-        Float(Float &&other) noexcept;
-
-
-        auto operator=(double value) noexcept -> Float &;
-        auto operator=(const Float &other) noexcept -> Float &;
-        auto operator=(Float &&other) noexcept -> Float;
-
-
-        [[nodiscard]]
-        auto type() const noexcept -> ValueType override;
-
+        Float() noexcept : m_value(Null) {}
 
-        [[nodiscard]]
-        auto get() const noexcept -> std::optional<double>;
-
-
-        void set(double value) noexcept;
+        Float(double value) noexcept : m_value(value) {}
+        Float(const Float &other) noexcept : m_value(other.m_value) {}
+        Float(Float &&other) noexcept : m_value(other.m_value)
+        {
+            if (&other != this) other.m_value.reset();
+        }
 
 
-        auto operator+() const noexcept -> Float;
-        auto operator-() const noexcept -> Float;
+        auto
+        operator=(double value) noexcept -> Float &
+        {
+            m_value = value;
+            return *this;
+        }
 
 
-        auto operator++() noexcept -> Float &;
-        auto operator++(int) noexcept -> Float;
-        auto operator--() noexcept -> Float &;
-        auto operator--(int) noexcept -> Float;
+        auto
+        operator=(const Float &other) noexcept -> Float &
+        {
+            m_value = other.m_value;
+            return *this;
+        }
 
 
-        auto operator+(const Float &rhs) const noexcept -> Float;
-        auto operator-(const Float &rhs) const noexcept -> Float;
-        auto operator*(const Float &rhs) const noexcept -> Float;
-        auto operator/(const Float &rhs) const -> Float;
+        auto
+        operator=(Float &&other) noexcept -> Float
+        {
+            if (&other != this)
+            {
+                m_value = other.m_value;
+                other.m_value.reset();
+            }
 
+            return *this;
+        }
 
-        auto operator+=(const Float &rhs) noexcept -> Float &;
-        auto operator-=(const Float &rhs) noexcept -> Float &;
-        auto operator*=(const Float &rhs) noexcept -> Float &;
-        auto operator/=(const Float &rhs) -> Float &;
 
-
-        auto operator==(const Float &rhs) const noexcept -> bool;
-        auto operator!=(const Float &rhs) const noexcept -> bool;
-        auto operator<(const Float &rhs) const noexcept -> bool;
-        auto operator>(const Float &rhs) const noexcept -> bool;
-        auto operator<=(const Float &rhs) const noexcept -> bool;
-        auto operator>=(const Float &rhs) const noexcept -> bool;
+        [[nodiscard]]
+        auto type() const noexcept -> ValueType override;
 
 
-        explicit(true) operator float() const noexcept;
-        explicit(true) operator double() const noexcept;
+        [[nodiscard]]
+        auto
+        get() const noexcept -> std::optional<double>
+        {
+            return m_value;
+        }
+
+
+        void
+        set(double value) noexcept
+        {
+            m_value = value;
+        }
+
+
+        auto
+        operator+() const noexcept -> Float
+        {
+            return *this;
+        }
+
+        auto
+        operator-() const noexcept -> Float
+        {
+            return -*m_value;
+        }
+
+
+        auto
+        operator++() noexcept -> Float &
+        {
+            m_value = *m_value + 1;
+            return *this;
+        }
+
+        auto
+        operator++(int) noexcept -> Float
+        {
+            Float tmp { *this };
+            ++(*this);
+            return tmp;
+        }
+
+        auto
+        operator--() noexcept -> Float &
+        {
+            m_value = *m_value - 1;
+            return *this;
+        }
+
+        auto
+        operator--(int) noexcept -> Float
+        {
+            Float tmp { *this };
+            --(*this);
+            return tmp;
+        }
+
+
+        auto
+        operator+(const Float &rhs) const noexcept -> Float
+        {
+            return *m_value + *rhs.m_value;
+        }
+
+        auto
+        operator-(const Float &rhs) const noexcept -> Float
+        {
+            return *m_value - *rhs.m_value;
+        }
+
+        auto
+        operator*(const Float &rhs) const noexcept -> Float
+        {
+            return *m_value * *rhs.m_value;
+        }
+
+        auto
+        operator/(const Float &rhs) const -> Float
+        {
+            if (*rhs.m_value == 0) mf_division_by_zero();
+            return *m_value / *rhs.m_value;
+        }
+
+
+        auto
+        operator+=(const Float &rhs) noexcept -> Float &
+        {
+            m_value = *m_value + *rhs.m_value;
+            return *this;
+        }
+
+        auto
+        operator-=(const Float &rhs) noexcept -> Float &
+        {
+            m_value = *m_value - *rhs.m_value;
+            return *this;
+        }
+
+        auto
+        operator*=(const Float &rhs) noexcept -> Float &
+        {
+            m_value = *m_value * *rhs.m_value;
+            return *this;
+        }
+
+        auto
+        operator/=(const Float &rhs) -> Float &
+        {
+            if (*rhs.m_value == 0) mf_division_by_zero();
+            m_value = *m_value / *rhs.m_value;
+            return *this;
+        }
+
+
+        auto
+        operator==(const Float &rhs) const noexcept -> bool
+        {
+            return m_value == rhs.m_value;
+        }
+
+        auto
+        operator!=(const Float &rhs) const noexcept -> bool
+        {
+            return m_value != rhs.m_value;
+        }
+
+        auto
+        operator<(const Float &rhs) const noexcept -> bool
+        {
+            return m_value < rhs.m_value;
+        }
+
+        auto
+        operator>(const Float &rhs) const noexcept -> bool
+        {
+            return m_value > rhs.m_value;
+        }
+
+        auto
+        operator<=(const Float &rhs) const noexcept -> bool
+        {
+            return m_value <= rhs.m_value;
+        }
+
+        auto
+        operator>=(const Float &rhs) const noexcept -> bool
+        {
+            return m_value >= rhs.m_value;
+        }
+
+
+        explicit(true)
+        operator float() const noexcept
+        {
+            return static_cast<float>(*m_value);
+        }
+
+        explicit(true)
+        operator double() const noexcept
+        {
+            return *m_value;
+        }
 
 
     private:
         std::optional<double> m_value;
+
+
+        /* Kept out of line so the throw does not bloat inlined callers. */
+        [[noreturn]]
+        static void mf_division_by_zero();
     };
 }
 
@@ -18,6 +18,8 @@
 
 #ifndef KONCPP_TYPES__INTEGER__HH
 #define KONCPP_TYPES__INTEGER__HH
+#include <utility>
+
 #include "koncpp/types/base.hh"
 
 
@@ -62,6 +64,7 @@ namespace koncpp::types
     {
     public:
         Integer() noexcept : m_value(0) {}
+        Integer(std::nullopt_t) noexcept : m_value(Null) {}
 
         template <typename T_Other>
         Integer(T_Other value) noexcept
@@ -395,20 +398,19 @@ namespace koncpp::types
         void
         mf_assign_safely(T_Other value) noexcept
         {
-            using C = std::common_type_t<T_Other, T_Int>;
-
-            if constexpr (std::is_unsigned_v<T_Int>)
-                if (value < 0)
-                {
-                    m_value = Null;
-                    return;
-                }
-
-            if (value > C(std::numeric_limits<T_Int>::max())
-                || value < C(std::numeric_limits<T_Int>::min()))
+            /* compared by value, as a common type would wrap one sign */
+            if constexpr (std::is_integral_v<T_Other>)
             {
-                m_value = Null;
+                if (std::in_range<T_Int>(+value))
+                    m_value = static_cast<T_Int>(value);
+                else
+                    m_value = Null;
             }
+            else if (value < static_cast<T_Other>(
+                         std::numeric_limits<T_Int>::min())
+                     || value > static_cast<T_Other>(
+                         std::numeric_limits<T_Int>::max()))
+                m_value = Null;
             else
                 m_value = static_cast<T_Int>(value);
         }
@@ -118,6 +118,18 @@ namespace koncpp::types
         }
 
 
+        /**
+         * @brief Returns a view of the stored string without copying it.
+         */
+        [[nodiscard]]
+        auto
+        view() const noexcept -> std::optional<std::string_view>
+        {
+            if (!m_string) return Null;
+            return std::string_view { *m_string };
+        }
+
+
         void
         set(BaseString string)
         {
@@ -264,6 +276,17 @@ namespace koncpp::types
         }
 
 
+        /**
+         * @brief Returns the capacity of the storage, or 0 if null.
+         */
+        [[nodiscard]]
+        auto
+        capacity() const noexcept -> SizeType
+        {
+            return m_string ? m_string->capacity() : 0;
+        }
+
+
     private:
         std::optional<BaseString> m_string;
     };
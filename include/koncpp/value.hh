@@ -1,32 +1,627 @@
+/**
+ * @file koncpp/value.hh
+ * @copyright Copyright (C) 2025-2026 Kei <RQuarx@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
 #ifndef KONCPP_VALUE__HH
 #define KONCPP_VALUE__HH
-#include <cstdint>
+#include <algorithm>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
 
-#include <SDL3/SDL.h>
+#include "koncpp/memory.hh"
+#include "koncpp/path.hh"
+#include "koncpp/types/base.hh"
+#include "koncpp/types/boolean.hh"
+#include "koncpp/types/boolean_array.hh"
+#include "koncpp/types/float.hh"
+#include "koncpp/types/integer.hh"
+#include "koncpp/types/string.hh"
 
 
 namespace koncpp
 {
-    enum class ValueType : std::uint8_t
+    struct ValueError : public Exception
     {
-        Null,
-        Integer,
-        Float,
-        Boolean,
-        String,
-        Array,
-        Object,
+        using Exception::Exception;
     };
 
 
-    template <typename T_Allocator>
+    /**
+     * @brief A node of a Kei Object Notation document.
+     *
+     * A @c Value holds exactly one of the kon data types: null, a signed or
+     * unsigned @c Integer , a @c Float , a @c Boolean , a @c String ,
+     * an @c Array of values sharing a single type, or an @c Object of
+     * key-value members kept in insertion order.
+     *
+     * An array of booleans may also be held packed, as a
+     * @c types::BooleanArray . It is an array to @c type() , @c size() and
+     * @c operator==() , but has no elements to return references to: read
+     * and extend it through @c get<types::BooleanArray>() instead.
+     *
+     * @tparam T_Allocator The allocator used for strings, keys, and children.
+     */
+    template <typename T_Allocator = std::allocator<char>>
     class Value
     {
+        template <typename T_Type>
+        using Rebind = typename std::allocator_traits<
+            T_Allocator>::template rebind_alloc<T_Type>;
+
     public:
-        Value(ValueType type);
+        struct Member;
+
+        using BaseString
+            = std::basic_string<char, std::char_traits<char>, T_Allocator>;
+        using StringType = types::String<T_Allocator>;
+        using Array      = std::vector<Value, Rebind<Value>>;
+        using Object     = std::vector<Member, Rebind<Member>>;
+        using SizeType   = std::size_t;
+
+
+        Value() noexcept = default;
+
+        Value(ValueType type)
+        {
+            switch (type)
+            {
+            case ValueType::Null:    break;
+            case ValueType::Integer: m_storage = types::Integer<> {}; break;
+            case ValueType::Float:   m_storage = types::Float {}; break;
+            case ValueType::Boolean: m_storage = types::Boolean {}; break;
+            case ValueType::String:  m_storage = StringType {}; break;
+            case ValueType::Array:   m_storage = Array {}; break;
+            case ValueType::Object:  m_storage = Object {}; break;
+            }
+        }
+
+        Value(types::Integer<types::Signed> value) : m_storage(std::move(value))
+        {
+        }
+
+        Value(types::Integer<types::Unsigned> value)
+            : m_storage(std::move(value))
+        {
+        }
+
+        Value(types::Float value) : m_storage(std::move(value)) {}
+        Value(types::Boolean value) : m_storage(std::move(value)) {}
+        Value(StringType value) : m_storage(std::move(value)) {}
+        Value(Array value) : m_storage(std::move(value)) {}
+        Value(types::BooleanArray value) : m_storage(std::move(value)) {}
+        Value(Object value) : m_storage(std::move(value)) {}
+
+        Value(const Value &)     = default;
+        Value(Value &&) noexcept = default;
+
+        auto operator=(const Value &) -> Value &     = default;
+        auto operator=(Value &&) noexcept -> Value & = default;
+
+
+        [[nodiscard]]
+        auto
+        type() const noexcept -> ValueType
+        {
+            switch (m_storage.index())
+            {
+            case 1:
+            case 2:  return ValueType::Integer;
+            case 3:  return ValueType::Float;
+            case 4:  return ValueType::Boolean;
+            case 5:  return ValueType::String;
+            case 6:  return ValueType::Array;
+            case 7:  return ValueType::Object;
+            case 8:  return ValueType::Array;
+            default: return ValueType::Null;
+            }
+        }
+
+
+        [[nodiscard]]
+        auto
+        is_null() const noexcept -> bool
+        {
+            return m_storage.index() == 0;
+        }
+
+
+        template <typename T_Type>
+        [[nodiscard]]
+        auto
+        holds() const noexcept -> bool
+        {
+            return std::holds_alternative<T_Type>(m_storage);
+        }
+
+
+        /**
+         * @brief Returns the stored value as @p T_Type .
+         * @throws ValueError if the value does not hold a @p T_Type .
+         */
+        template <typename T_Type>
+        [[nodiscard]]
+        auto
+        get() -> T_Type &
+        {
+            if (auto *ptr { std::get_if<T_Type>(&m_storage) }; ptr != nullptr)
+                return *ptr;
+            throw ValueError { "value does not hold the requested type" };
+        }
+
+
+        template <typename T_Type>
+        [[nodiscard]]
+        auto
+        get() const -> const T_Type &
+        {
+            if (const auto *ptr { std::get_if<T_Type>(&m_storage) };
+                ptr != nullptr)
+                return *ptr;
+            throw ValueError { "value does not hold the requested type" };
+        }
+
+
+        template <typename T_Type>
+        [[nodiscard]]
+        auto
+        get_if() noexcept -> T_Type *
+        {
+            return std::get_if<T_Type>(&m_storage);
+        }
+
+
+        template <typename T_Type>
+        [[nodiscard]]
+        auto
+        get_if() const noexcept -> const T_Type *
+        {
+            return std::get_if<T_Type>(&m_storage);
+        }
+
+
+        /**
+         * @brief Looks up the member @p key of an object.
+         * @returns A pointer to the member's value, or @c nullptr if the
+         *          value is not an object or has no such member.
+         */
+        [[nodiscard]]
+        auto
+        find(std::string_view key) noexcept -> Value *
+        {
+            return const_cast<Value *>(std::as_const(*this).find(key));
+        }
+
+
+        [[nodiscard]]
+        auto
+        find(std::string_view key) const noexcept -> const Value *
+        {
+            return find(Key { key });
+        }
+
+
+        /**
+         * @brief Looks up the member @p key , comparing hashes before names.
+         */
+        [[nodiscard]]
+        auto
+        find(Key key) noexcept -> Value *
+        {
+            return const_cast<Value *>(std::as_const(*this).find(key));
+        }
+
+
+        [[nodiscard]]
+        auto
+        find(Key key) const noexcept -> const Value *
+        {
+            const auto *object { get_if<Object>() };
+            if (object == nullptr) return nullptr;
+
+            for (const auto &member : *object)
+                if (member.hash == key.hash && member.key == key.name)
+                    return &member.value;
+            return nullptr;
+        }
+
+
+        /**
+         * @brief Looks up the value at @p path through nested objects.
+         */
+        [[nodiscard]]
+        auto
+        find(const Path &path) noexcept -> Value *
+        {
+            return const_cast<Value *>(std::as_const(*this).find(path));
+        }
+
+
+        [[nodiscard]]
+        auto
+        find(const Path &path) const noexcept -> const Value *
+        {
+            const auto *node { this };
+            for (std::size_t i { 0 }; i < path.size() && node != nullptr; i++)
+                node = node->find(path[i]);
+            return node;
+        }
+
+
+        [[nodiscard]]
+        auto
+        at(std::string_view key) -> Value &
+        {
+            if (auto *ptr { find(key) }; ptr != nullptr) return *ptr;
+            throw ValueError { "no member named '{}'", key };
+        }
+
+
+        [[nodiscard]]
+        auto
+        at(std::string_view key) const -> const Value &
+        {
+            if (const auto *ptr { find(key) }; ptr != nullptr) return *ptr;
+            throw ValueError { "no member named '{}'", key };
+        }
+
+
+        [[nodiscard]]
+        auto
+        at(Key key) -> Value &
+        {
+            if (auto *ptr { find(key) }; ptr != nullptr) return *ptr;
+            throw ValueError { "no member named '{}'", key.name };
+        }
+
+
+        [[nodiscard]]
+        auto
+        at(Key key) const -> const Value &
+        {
+            if (const auto *ptr { find(key) }; ptr != nullptr) return *ptr;
+            throw ValueError { "no member named '{}'", key.name };
+        }
+
+
+        [[nodiscard]]
+        auto
+        at(const Path &path) -> Value &
+        {
+            if (auto *ptr { find(path) }; ptr != nullptr) return *ptr;
+            throw ValueError { "no value at '{}'", path.text() };
+        }
+
+
+        [[nodiscard]]
+        auto
+        at(const Path &path) const -> const Value &
+        {
+            if (const auto *ptr { find(path) }; ptr != nullptr) return *ptr;
+            throw ValueError { "no value at '{}'", path.text() };
+        }
+
+
+        /**
+         * @brief Same as @c at() . Unlike @c std::map , a missing member is
+         *        not inserted.
+         * @throws ValueError if there is no such member.
+         */
+        [[nodiscard]]
+        auto
+        operator[](Key key) -> Value &
+        {
+            return at(key);
+        }
+
+
+        [[nodiscard]]
+        auto
+        operator[](Key key) const -> const Value &
+        {
+            return at(key);
+        }
+
+
+        [[nodiscard]]
+        auto
+        operator[](const Path &path) -> Value &
+        {
+            return at(path);
+        }
+
+
+        [[nodiscard]]
+        auto
+        operator[](const Path &path) const -> const Value &
+        {
+            return at(path);
+        }
+
+
+        /**
+         * @throws ValueError if the value is not an array, or is a packed
+         *         one.
+         */
+        [[nodiscard]]
+        auto
+        at(SizeType index) -> Value &
+        {
+            return get<Array>().at(index);
+        }
+
+
+        [[nodiscard]]
+        auto
+        at(SizeType index) const -> const Value &
+        {
+            return get<Array>().at(index);
+        }
+
+
+        /**
+         * @brief Inserts or replaces the member @p key of an object.
+         *
+         * A null value is turned into an empty object first.
+         *
+         * @returns A reference to the inserted value.
+         * @throws ValueError if the value is neither null nor an object.
+         */
+        auto
+        insert(std::string_view key, Value value) -> Value &
+        {
+            if (is_null()) m_storage = Object {};
+
+            const Key hashed { key };
+            if (auto *ptr { find(hashed) }; ptr != nullptr)
+                return *ptr = std::move(value);
+
+            auto &object { get<Object>() };
+            object.push_back(Member { hashed, std::move(value) });
+            return object.back().value;
+        }
+
+
+        /**
+         * @brief Removes the member @p key of an object.
+         * @returns false if there was no such member.
+         */
+        auto
+        erase(std::string_view key) -> bool
+        {
+            auto *object { get_if<Object>() };
+            if (object == nullptr) return false;
+
+            const auto it { std::ranges::find(*object, key, &Member::key) };
+            if (it == object->end()) return false;
+
+            object->erase(it);
+            return true;
+        }
+
+
+        /**
+         * @brief Appends @p value to an array.
+         *
+         * A null value is turned into an empty array first.
+         *
+         * @throws ValueError if the value is neither null nor an array, or if
+         *         @p value has a different type than the existing items. A
+         *         packed array is not extended this way.
+         */
+        auto
+        push_back(Value value) -> Value &
+        {
+            if (is_null()) m_storage = Array {};
+
+            auto &array { get<Array>() };
+            if (!array.empty() && array.front().type() != value.type())
+                throw ValueError { "arrays must contain a single data type" };
+
+            array.push_back(std::move(value));
+            return array.back();
+        }
+
+
+        [[nodiscard]]
+        auto
+        size() const noexcept -> SizeType
+        {
+            if (const auto *array { get_if<Array>() }; array != nullptr)
+                return array->size();
+            if (const auto *packed { get_if<types::BooleanArray>() })
+                return packed->size();
+            if (const auto *object { get_if<Object>() }; object != nullptr)
+                return object->size();
+            return 0;
+        }
+
+
+        /**
+         * @brief Walks the tree and reports what it is made of.
+         *
+         * With an @c AccountingAllocator , @c MemoryUsage::bytes matches what
+         * the tree holds in its account, except for the bitmaps of packed
+         * arrays, which are counted but use the default allocator.
+         */
+        [[nodiscard]]
+        auto
+        memory_usage() const -> MemoryUsage
+        {
+            MemoryUsage usage;
+            mf_measure(usage);
+            return usage;
+        }
+
+
+        /**
+         * @brief Compares the values, a packed array being equal to an array
+         *        of the same booleans.
+         */
+        [[nodiscard]]
+        auto
+        operator==(const Value &rhs) const -> bool
+        {
+            if (const auto *packed { get_if<types::BooleanArray>() })
+                return rhs.mf_equals(*packed);
+            if (const auto *packed { rhs.get_if<types::BooleanArray>() })
+                return mf_equals(*packed);
+
+            if (m_storage.index() != rhs.m_storage.index()) return false;
+
+            return std::visit(
+                [&rhs]<typename T_Type>(const T_Type &lhs) -> bool
+                {
+                    const auto &other { std::get<T_Type>(rhs.m_storage) };
+
+                    if constexpr (std::is_same_v<T_Type, std::monostate>)
+                        return true;
+                    else if constexpr (std::is_same_v<T_Type, Array>
+                                       || std::is_same_v<T_Type, Object>
+                                       || std::is_same_v<T_Type,
+                                                         types::BooleanArray>)
+                        return lhs == other;
+                    else
+                        return lhs.get() == other.get();
+                },
+                m_storage);
+        }
+
+
+    private:
+        /**
+         * @brief Returns the heap bytes of a string with @p capacity .
+         *
+         * Strings that fit in the small string buffer allocate nothing,
+         * others allocate one more byte than their capacity.
+         */
+        [[nodiscard]]
+        static auto
+        mf_string_bytes(std::size_t capacity) noexcept -> std::size_t
+        {
+            static const auto small { BaseString {}.capacity() };
+            return capacity > small ? capacity + 1 : 0;
+        }
+
+
+        [[nodiscard]]
+        auto
+        mf_equals(const types::BooleanArray &packed) const -> bool
+        {
+            if (const auto *other { get_if<types::BooleanArray>() })
+                return *other == packed;
+
+            const auto *array { get_if<Array>() };
+            if (array == nullptr || array->size() != packed.size())
+                return false;
+
+            for (std::size_t i { 0 }; i < packed.size(); i++)
+            {
+                const auto *item { (*array)[i].template get_if<
+                    types::Boolean>() };
+                if (item == nullptr || *item != packed[i]) return false;
+            }
+            return true;
+        }
+
+
+        void
+        mf_measure(MemoryUsage &usage) const
+        {
+            usage.nodes[std::to_underlying(type())]++;
+
+            if (const auto *string { get_if<StringType>() })
+            {
+                if (const auto view { string->view() })
+                    usage.strings[MemoryUsage::bucket(view->size())]++;
+                usage.bytes += mf_string_bytes(string->capacity());
+            }
+            else if (const auto *array { get_if<Array>() })
+            {
+                usage.bytes += array->capacity() * sizeof(Value);
+                for (const auto &item : *array) item.mf_measure(usage);
+            }
+            else if (const auto *packed { get_if<types::BooleanArray>() })
+                usage.bytes += packed->capacity_bytes();
+            else if (const auto *object { get_if<Object>() })
+            {
+                usage.bytes += object->capacity() * sizeof(Member);
+                for (const auto &member : *object)
+                {
+                    usage.strings[MemoryUsage::bucket(member.key.size())]++;
+                    usage.bytes += mf_string_bytes(member.key.capacity());
+                    member.value.mf_measure(usage);
+                }
+            }
+        }
 
 
     private:
+        std::variant<std::monostate,
+                     types::Integer<types::Signed>,
+                     types::Integer<types::Unsigned>,
+                     types::Float,
+                     types::Boolean,
+                     StringType,
+                     Array,
+                     Object,
+                     types::BooleanArray>
+            m_storage;
+    };
+
+
+    /**
+     * @brief A member of an object.
+     *
+     * Lookups compare @c hash before @c key , so the hash is computed
+     * whenever a member is made, and must be updated along with the key.
+     */
+    template <typename T_Allocator>
+    struct Value<T_Allocator>::Member
+    {
+        BaseString key;
+        Value      value;
+
+        /* hash_key() of the key */
+        std::uint64_t hash;
+
+
+        Member(BaseString key, Value value)
+            : key(std::move(key)),
+              value(std::move(value)),
+              hash(hash_key(this->key))
+        {
+        }
+
+        /**
+         * @brief Copies the name of @p key , reusing its hash.
+         */
+        Member(Key key, Value value)
+            : key(key.name.begin(), key.name.end()),
+              value(std::move(value)),
+              hash(key.hash)
+        {
+        }
+
+
+        [[nodiscard]]
+        auto operator==(const Member &rhs) const -> bool = default;
     };
 }
 
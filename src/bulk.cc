@@ -0,0 +1,1170 @@
+/**
+ * @file bulk.cc
+ * @copyright Copyright (C) 2025-2026 Kei <RQuarx@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+#include "koncpp/bulk.hh"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define KONCPP_BULK_X86
+#define KONCPP_AVX2   __attribute__((target("avx2")))
+#define KONCPP_AVX512 __attribute__((target("avx512f")))
+#define KONCPP_AVX512_POPCNT \
+    __attribute__((target("avx512f,avx512vpopcntdq")))
+#include <immintrin.h>
+#endif
+
+using koncpp::Bitmap;
+using koncpp::ValueError;
+using koncpp::bulk::Column;
+using koncpp::bulk::Compare;
+using koncpp::bulk::Isa;
+
+namespace bulk  = koncpp::bulk;
+namespace types = koncpp::types;
+
+
+namespace
+{
+    using Word = Bitmap::Word;
+
+    constexpr auto WordBits { Bitmap::WordBits };
+
+
+    auto
+    detect() noexcept -> Isa
+    {
+#ifdef KONCPP_BULK_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) return Isa::Avx512;
+        if (__builtin_cpu_supports("avx2")) return Isa::Avx2;
+#endif
+        return Isa::Scalar;
+    }
+
+
+    auto
+    supported() noexcept -> Isa
+    {
+        static const Isa isa { detect() };
+        return isa;
+    }
+
+
+    /* A separate extension from AVX-512F, missing on older CPUs. */
+    auto
+    has_vector_popcount() noexcept -> bool
+    {
+#ifdef KONCPP_BULK_X86
+        static const bool supported {
+            __builtin_cpu_supports("avx512vpopcntdq") != 0
+        };
+        return supported;
+#else
+        return false;
+#endif
+    }
+
+
+    auto
+    selected() noexcept -> std::atomic<Isa> &
+    {
+        static std::atomic<Isa> isa { supported() };
+        return isa;
+    }
+
+
+    auto
+    test(const Word *words, std::size_t index) noexcept -> bool
+    {
+        return ((words[index / WordBits] >> (index % WordBits)) & 1) != 0;
+    }
+
+
+    /* Integer kernels wrap around, like the hardware does. */
+    template <typename T_Type>
+    auto
+    wrapping_add(T_Type lhs, T_Type rhs) noexcept -> T_Type
+    {
+        if constexpr (std::is_integral_v<T_Type>)
+            return static_cast<T_Type>(static_cast<types::Unsigned>(lhs)
+                                       + static_cast<types::Unsigned>(rhs));
+        else
+            return lhs + rhs;
+    }
+
+
+    template <typename T_Type>
+    auto
+    wrapping_mul(T_Type lhs, T_Type rhs) noexcept -> T_Type
+    {
+        if constexpr (std::is_integral_v<T_Type>)
+            return static_cast<T_Type>(static_cast<types::Unsigned>(lhs)
+                                       * static_cast<types::Unsigned>(rhs));
+        else
+            return lhs * rhs;
+    }
+
+
+    /* NaN never wins, so it is ignored by min and max. */
+    template <bool T_Max, typename T_Type>
+    auto
+    better(T_Type candidate, T_Type current) noexcept -> bool
+    {
+        if constexpr (T_Max)
+            return candidate > current;
+        else
+            return candidate < current;
+    }
+
+
+    template <bool T_Max, typename T_Type>
+    constexpr auto
+    fill() noexcept -> T_Type
+    {
+        if constexpr (std::is_floating_point_v<T_Type>)
+            return T_Max ? -std::numeric_limits<T_Type>::infinity()
+                         : std::numeric_limits<T_Type>::infinity();
+        else
+            return T_Max ? std::numeric_limits<T_Type>::lowest()
+                         : std::numeric_limits<T_Type>::max();
+    }
+
+
+    template <typename T_Type>
+    auto
+    matches(T_Type lhs, Compare op, T_Type rhs) noexcept -> bool
+    {
+        switch (op)
+        {
+        case Compare::Equal:        return lhs == rhs;
+        case Compare::NotEqual:     return lhs != rhs;
+        case Compare::Less:         return lhs < rhs;
+        case Compare::LessEqual:    return lhs <= rhs;
+        case Compare::Greater:      return lhs > rhs;
+        case Compare::GreaterEqual: return lhs >= rhs;
+        }
+
+        return false;
+    }
+
+
+    template <Compare T_Op>
+    using Constant = std::integral_constant<Compare, T_Op>;
+
+
+    /* Calls @p func with @p op as a compile-time constant. */
+    template <typename T_Func>
+    auto
+    with_op(Compare op, T_Func &&func)
+    {
+        using enum Compare;
+
+        switch (op)
+        {
+        case Equal:        return func(Constant<Equal> {});
+        case NotEqual:     return func(Constant<NotEqual> {});
+        case Less:         return func(Constant<Less> {});
+        case LessEqual:    return func(Constant<LessEqual> {});
+        case Greater:      return func(Constant<Greater> {});
+        case GreaterEqual: return func(Constant<GreaterEqual> {});
+        }
+
+        return func(Constant<Equal> {});
+    }
+
+
+    /*
+     * Scalar kernels. They are the fallback on every platform, and finish
+     * the tail the vector kernels leave behind.
+     */
+
+    template <typename T_Type>
+    auto
+    sum_scalar(const T_Type *values, std::size_t size) noexcept -> T_Type
+    {
+        T_Type result {};
+        for (std::size_t i { 0 }; i < size; i++)
+            result = wrapping_add(result, values[i]);
+        return result;
+    }
+
+
+    template <bool T_Max, typename T_Type>
+    auto
+    extreme_scalar(const T_Type *values,
+                   const Word   *valid,
+                   std::size_t   first,
+                   std::size_t   size,
+                   T_Type        result) noexcept -> T_Type
+    {
+        for (std::size_t i { first }; i < size; i++)
+            if (test(valid, i) && better<T_Max>(values[i], result))
+                result = values[i];
+        return result;
+    }
+
+
+    template <typename T_Type>
+    void
+    compare_scalar(const T_Type *values,
+                   std::size_t   first,
+                   std::size_t   size,
+                   Compare       op,
+                   T_Type        value,
+                   Word         *out) noexcept
+    {
+        for (std::size_t i { first }; i < size; i++)
+            if (matches(values[i], op, value))
+                out[i / WordBits] |= Word { 1 } << (i % WordBits);
+    }
+
+
+    template <typename T_Type>
+    void
+    add_scalar(const T_Type *lhs,
+               const T_Type *rhs,
+               T_Type       *out,
+               std::size_t   first,
+               std::size_t   size) noexcept
+    {
+        for (std::size_t i { first }; i < size; i++)
+            out[i] = wrapping_add(lhs[i], rhs[i]);
+    }
+
+
+    template <typename T_Type>
+    void
+    scale_scalar(const T_Type *values,
+                 T_Type        factor,
+                 T_Type       *out,
+                 std::size_t   first,
+                 std::size_t   size) noexcept
+    {
+        for (std::size_t i { first }; i < size; i++)
+            out[i] = wrapping_mul(values[i], factor);
+    }
+
+
+#ifdef KONCPP_BULK_X86
+    template <Compare T_Op>
+    constexpr auto
+    float_predicate() noexcept -> int
+    {
+        switch (T_Op)
+        {
+        case Compare::Equal:        return _CMP_EQ_OQ;
+        case Compare::NotEqual:     return _CMP_NEQ_UQ;
+        case Compare::Less:         return _CMP_LT_OQ;
+        case Compare::LessEqual:    return _CMP_LE_OQ;
+        case Compare::Greater:      return _CMP_GT_OQ;
+        case Compare::GreaterEqual: return _CMP_GE_OQ;
+        }
+
+        return _CMP_EQ_OQ;
+    }
+
+
+    template <Compare T_Op>
+    constexpr auto
+    int_predicate() noexcept -> int
+    {
+        switch (T_Op)
+        {
+        case Compare::Equal:        return _MM_CMPINT_EQ;
+        case Compare::NotEqual:     return _MM_CMPINT_NE;
+        case Compare::Less:         return _MM_CMPINT_LT;
+        case Compare::LessEqual:    return _MM_CMPINT_LE;
+        case Compare::Greater:      return _MM_CMPINT_NLE;
+        case Compare::GreaterEqual: return _MM_CMPINT_NLT;
+        }
+
+        return _MM_CMPINT_EQ;
+    }
+
+
+    /* Intrinsics take their predicate as an immediate, even at -O0. */
+    template <Compare T_Op>
+    constexpr int FloatPredicate { float_predicate<T_Op>() };
+
+    template <Compare T_Op>
+    constexpr int IntPredicate { int_predicate<T_Op>() };
+
+
+    /*
+     * AVX2 kernels. Each returns how many leading elements it processed,
+     * the rest is left to the scalar kernels.
+     */
+
+    KONCPP_AVX2 auto
+    sum_avx2(const double *values, std::size_t size) noexcept -> double
+    {
+        auto        lo { _mm256_setzero_pd() };
+        auto        hi { _mm256_setzero_pd() };
+        std::size_t i { 0 };
+
+        for (; i + 8 <= size; i += 8)
+        {
+            lo = _mm256_add_pd(lo, _mm256_loadu_pd(values + i));
+            hi = _mm256_add_pd(hi, _mm256_loadu_pd(values + i + 4));
+        }
+
+        alignas(32) double lanes[4];
+        _mm256_store_pd(lanes, _mm256_add_pd(lo, hi));
+
+        return lanes[0] + lanes[1] + lanes[2] + lanes[3]
+             + sum_scalar(values + i, size - i);
+    }
+
+
+    KONCPP_AVX2 auto
+    sum_avx2(const types::Unsigned *values, std::size_t size) noexcept
+        -> types::Unsigned
+    {
+        auto        acc { _mm256_setzero_si256() };
+        std::size_t i { 0 };
+
+        for (; i + 4 <= size; i += 4)
+            acc = _mm256_add_epi64(
+                acc,
+                _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i *>(values + i)));
+
+        alignas(32) types::Unsigned lanes[4];
+        _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), acc);
+
+        return lanes[0] + lanes[1] + lanes[2] + lanes[3]
+             + sum_scalar(values + i, size - i);
+    }
+
+
+    /* Expands four validity bits into four 64-bit lane masks. */
+    KONCPP_AVX2 auto
+    lane_mask_avx2(Word bits) noexcept -> __m256i
+    {
+        const auto lanes { _mm256_setr_epi64x(1, 2, 4, 8) };
+        const auto splat { _mm256_set1_epi64x(static_cast<long long>(bits)) };
+        return _mm256_cmpeq_epi64(_mm256_and_si256(splat, lanes), lanes);
+    }
+
+
+    template <bool T_Max>
+    KONCPP_AVX2 auto
+    extreme_avx2(const double *values,
+                 const Word   *valid,
+                 std::size_t   size) noexcept -> double
+    {
+        const auto  fills { _mm256_set1_pd(fill<T_Max, double>()) };
+        auto        acc { fills };
+        std::size_t i { 0 };
+
+        for (; i + 4 <= size; i += 4)
+        {
+            const auto mask { _mm256_castsi256_pd(
+                lane_mask_avx2(valid[i / WordBits] >> (i % WordBits))) };
+            const auto lanes { _mm256_blendv_pd(
+                fills, _mm256_loadu_pd(values + i), mask) };
+
+            /* the second operand is returned when either one is NaN */
+            if constexpr (T_Max)
+                acc = _mm256_max_pd(lanes, acc);
+            else
+                acc = _mm256_min_pd(lanes, acc);
+        }
+
+        alignas(32) double lanes[4];
+        _mm256_store_pd(lanes, acc);
+
+        auto result { fill<T_Max, double>() };
+        for (const auto lane : lanes)
+            if (better<T_Max>(lane, result)) result = lane;
+
+        return extreme_scalar<T_Max>(values, valid, i, size, result);
+    }
+
+
+    template <Compare T_Op>
+    KONCPP_AVX2 auto
+    compare_avx2(const double *values,
+                 std::size_t   size,
+                 double        value,
+                 Word         *out) noexcept -> std::size_t
+    {
+        const auto  rhs { _mm256_set1_pd(value) };
+        std::size_t i { 0 };
+
+        for (; i + 4 <= size; i += 4)
+        {
+            const auto bits { _mm256_movemask_pd(
+                _mm256_cmp_pd(_mm256_loadu_pd(values + i),
+                              rhs,
+                              FloatPredicate<T_Op>)) };
+            out[i / WordBits] |= static_cast<Word>(bits) << (i % WordBits);
+        }
+
+        return i;
+    }
+
+
+    /* AVX2 has no unsigned comparison, so both sides get their sign bit
+       flipped and are compared as signed. */
+    template <Compare T_Op, bool T_Unsigned>
+    KONCPP_AVX2 auto
+    compare_avx2(const types::Unsigned *values,
+                 std::size_t            size,
+                 types::Unsigned        value,
+                 Word                  *out) noexcept -> std::size_t
+    {
+        using enum Compare;
+
+        const auto flip { T_Unsigned ? _mm256_set1_epi64x(
+                                           std::numeric_limits<long long>::min())
+                                     : _mm256_setzero_si256() };
+        const auto rhs { _mm256_xor_si256(
+            _mm256_set1_epi64x(static_cast<long long>(value)), flip) };
+
+        std::size_t i { 0 };
+
+        for (; i + 4 <= size; i += 4)
+        {
+            const auto lhs { _mm256_xor_si256(
+                _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i *>(values + i)),
+                flip) };
+
+            __m256i mask;
+            if constexpr (T_Op == Equal || T_Op == NotEqual)
+                mask = _mm256_cmpeq_epi64(lhs, rhs);
+            else if constexpr (T_Op == Greater || T_Op == LessEqual)
+                mask = _mm256_cmpgt_epi64(lhs, rhs);
+            else
+                mask = _mm256_cmpgt_epi64(rhs, lhs);
+
+            auto bits { static_cast<Word>(
+                _mm256_movemask_pd(_mm256_castsi256_pd(mask))) };
+            if constexpr (T_Op == NotEqual || T_Op == LessEqual
+                          || T_Op == GreaterEqual)
+                bits ^= 0xF;
+
+            out[i / WordBits] |= bits << (i % WordBits);
+        }
+
+        return i;
+    }
+
+
+    KONCPP_AVX2 auto
+    add_avx2(const double *lhs,
+             const double *rhs,
+             double       *out,
+             std::size_t   size) noexcept -> std::size_t
+    {
+        std::size_t i { 0 };
+        for (; i + 4 <= size; i += 4)
+            _mm256_storeu_pd(out + i,
+                             _mm256_add_pd(_mm256_loadu_pd(lhs + i),
+                                           _mm256_loadu_pd(rhs + i)));
+        return i;
+    }
+
+
+    KONCPP_AVX2 auto
+    add_avx2(const types::Unsigned *lhs,
+             const types::Unsigned *rhs,
+             types::Unsigned       *out,
+             std::size_t            size) noexcept -> std::size_t
+    {
+        std::size_t i { 0 };
+        for (; i + 4 <= size; i += 4)
+        {
+            const auto a { _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(lhs + i)) };
+            const auto b { _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(rhs + i)) };
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i),
+                                _mm256_add_epi64(a, b));
+        }
+        return i;
+    }
+
+
+    KONCPP_AVX2 auto
+    scale_avx2(const double *values,
+               double        factor,
+               double       *out,
+               std::size_t   size) noexcept -> std::size_t
+    {
+        const auto  scale { _mm256_set1_pd(factor) };
+        std::size_t i { 0 };
+
+        for (; i + 4 <= size; i += 4)
+            _mm256_storeu_pd(out + i,
+                             _mm256_mul_pd(_mm256_loadu_pd(values + i), scale));
+        return i;
+    }
+
+
+    /*
+     * AVX-512 kernels. Masked loads and stores cover the tail, so these
+     * always process every element.
+     */
+
+    KONCPP_AVX512 auto
+    tail_mask(std::size_t index, std::size_t size) noexcept -> __mmask8
+    {
+        return size - index >= 8 ? 0xFF : (1U << (size - index)) - 1;
+    }
+
+
+    KONCPP_AVX512 auto
+    sum_avx512(const double *values, std::size_t size) noexcept -> double
+    {
+        auto acc { _mm512_setzero_pd() };
+        for (std::size_t i { 0 }; i < size; i += 8)
+            acc = _mm512_add_pd(
+                acc, _mm512_maskz_loadu_pd(tail_mask(i, size), values + i));
+        return _mm512_reduce_add_pd(acc);
+    }
+
+
+    KONCPP_AVX512 auto
+    sum_avx512(const types::Unsigned *values, std::size_t size) noexcept
+        -> types::Unsigned
+    {
+        auto acc { _mm512_setzero_si512() };
+        for (std::size_t i { 0 }; i < size; i += 8)
+            acc = _mm512_add_epi64(
+                acc, _mm512_maskz_loadu_epi64(tail_mask(i, size), values + i));
+        return static_cast<types::Unsigned>(_mm512_reduce_add_epi64(acc));
+    }
+
+
+    /* Bits past the end of a bitmap are zero, so validity doubles as the
+       load mask. */
+    template <bool T_Max>
+    KONCPP_AVX512 auto
+    extreme_avx512(const double *values,
+                   const Word   *valid,
+                   std::size_t   size) noexcept -> double
+    {
+        auto acc { _mm512_set1_pd(fill<T_Max, double>()) };
+
+        for (std::size_t i { 0 }; i < size; i += 8)
+        {
+            const auto mask { static_cast<__mmask8>(valid[i / WordBits]
+                                                    >> (i % WordBits)) };
+            const auto lanes { _mm512_maskz_loadu_pd(mask, values + i) };
+
+            if constexpr (T_Max)
+                acc = _mm512_mask_max_pd(acc, mask, lanes, acc);
+            else
+                acc = _mm512_mask_min_pd(acc, mask, lanes, acc);
+        }
+
+        if constexpr (T_Max)
+            return _mm512_reduce_max_pd(acc);
+        else
+            return _mm512_reduce_min_pd(acc);
+    }
+
+
+    template <bool T_Max, typename T_Type>
+    KONCPP_AVX512 auto
+    extreme_avx512(const T_Type *values,
+                   const Word   *valid,
+                   std::size_t   size) noexcept -> T_Type
+    {
+        constexpr bool Signed { std::is_signed_v<T_Type> };
+
+        auto acc { _mm512_set1_epi64(
+            static_cast<long long>(fill<T_Max, T_Type>())) };
+
+        for (std::size_t i { 0 }; i < size; i += 8)
+        {
+            const auto mask { static_cast<__mmask8>(valid[i / WordBits]
+                                                    >> (i % WordBits)) };
+            const auto lanes { _mm512_maskz_loadu_epi64(mask, values + i) };
+
+            if constexpr (T_Max && Signed)
+                acc = _mm512_mask_max_epi64(acc, mask, acc, lanes);
+            else if constexpr (T_Max)
+                acc = _mm512_mask_max_epu64(acc, mask, acc, lanes);
+            else if constexpr (Signed)
+                acc = _mm512_mask_min_epi64(acc, mask, acc, lanes);
+            else
+                acc = _mm512_mask_min_epu64(acc, mask, acc, lanes);
+        }
+
+        if constexpr (T_Max && Signed)
+            return _mm512_reduce_max_epi64(acc);
+        else if constexpr (T_Max)
+            return _mm512_reduce_max_epu64(acc);
+        else if constexpr (Signed)
+            return _mm512_reduce_min_epi64(acc);
+        else
+            return _mm512_reduce_min_epu64(acc);
+    }
+
+
+    template <Compare T_Op>
+    KONCPP_AVX512 auto
+    compare_avx512(const double *values,
+                   std::size_t   size,
+                   double        value,
+                   Word         *out) noexcept -> std::size_t
+    {
+        const auto rhs { _mm512_set1_pd(value) };
+
+        for (std::size_t i { 0 }; i < size; i += 8)
+        {
+            const auto load { tail_mask(i, size) };
+            const auto bits { _mm512_mask_cmp_pd_mask(
+                load,
+                _mm512_maskz_loadu_pd(load, values + i),
+                rhs,
+                FloatPredicate<T_Op>) };
+            out[i / WordBits] |= static_cast<Word>(bits) << (i % WordBits);
+        }
+
+        return size;
+    }
+
+
+    template <Compare T_Op, bool T_Unsigned>
+    KONCPP_AVX512 auto
+    compare_avx512(const types::Unsigned *values,
+                   std::size_t            size,
+                   types::Unsigned        value,
+                   Word                  *out) noexcept -> std::size_t
+    {
+        const auto rhs { _mm512_set1_epi64(static_cast<long long>(value)) };
+
+        for (std::size_t i { 0 }; i < size; i += 8)
+        {
+            const auto load { tail_mask(i, size) };
+            const auto lhs { _mm512_maskz_loadu_epi64(load, values + i) };
+
+            __mmask8 bits;
+            if constexpr (T_Unsigned)
+                bits = _mm512_mask_cmp_epu64_mask(
+                    load, lhs, rhs, IntPredicate<T_Op>);
+            else
+                bits = _mm512_mask_cmp_epi64_mask(
+                    load, lhs, rhs, IntPredicate<T_Op>);
+
+            out[i / WordBits] |= static_cast<Word>(bits) << (i % WordBits);
+        }
+
+        return size;
+    }
+
+
+    KONCPP_AVX512 auto
+    add_avx512(const double *lhs,
+               const double *rhs,
+               double       *out,
+               std::size_t   size) noexcept -> std::size_t
+    {
+        for (std::size_t i { 0 }; i < size; i += 8)
+        {
+            const auto mask { tail_mask(i, size) };
+            _mm512_mask_storeu_pd(
+                out + i,
+                mask,
+                _mm512_add_pd(_mm512_maskz_loadu_pd(mask, lhs + i),
+                              _mm512_maskz_loadu_pd(mask, rhs + i)));
+        }
+        return size;
+    }
+
+
+    KONCPP_AVX512 auto
+    add_avx512(const types::Unsigned *lhs,
+               const types::Unsigned *rhs,
+               types::Unsigned       *out,
+               std::size_t            size) noexcept -> std::size_t
+    {
+        for (std::size_t i { 0 }; i < size; i += 8)
+        {
+            const auto mask { tail_mask(i, size) };
+            _mm512_mask_storeu_epi64(
+                out + i,
+                mask,
+                _mm512_add_epi64(_mm512_maskz_loadu_epi64(mask, lhs + i),
+                                 _mm512_maskz_loadu_epi64(mask, rhs + i)));
+        }
+        return size;
+    }
+
+
+    KONCPP_AVX512 auto
+    scale_avx512(const double *values,
+                 double        factor,
+                 double       *out,
+                 std::size_t   size) noexcept -> std::size_t
+    {
+        const auto scale { _mm512_set1_pd(factor) };
+
+        for (std::size_t i { 0 }; i < size; i += 8)
+        {
+            const auto mask { tail_mask(i, size) };
+            _mm512_mask_storeu_pd(
+                out + i,
+                mask,
+                _mm512_mul_pd(_mm512_maskz_loadu_pd(mask, values + i), scale));
+        }
+        return size;
+    }
+
+
+    KONCPP_AVX512_POPCNT auto
+    count_avx512(const Word *words, std::size_t size) noexcept -> std::size_t
+    {
+        auto acc { _mm512_setzero_si512() };
+        for (std::size_t i { 0 }; i < size; i += 8)
+            acc = _mm512_add_epi64(
+                acc,
+                _mm512_popcnt_epi64(
+                    _mm512_maskz_loadu_epi64(tail_mask(i, size), words + i)));
+        return static_cast<std::size_t>(_mm512_reduce_add_epi64(acc));
+    }
+
+
+    /* Nibble lookup table popcount over four words at a time. */
+    KONCPP_AVX2 auto
+    count_avx2(const Word *words, std::size_t size) noexcept -> std::size_t
+    {
+        const auto table { _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3,
+                                            1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3,
+                                            1, 2, 2, 3, 2, 3, 3, 4) };
+        const auto low { _mm256_set1_epi8(0x0F) };
+
+        auto        acc { _mm256_setzero_si256() };
+        std::size_t i { 0 };
+
+        for (; i + 4 <= size; i += 4)
+        {
+            const auto v { _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(words + i)) };
+            const auto lo { _mm256_shuffle_epi8(table,
+                                                _mm256_and_si256(v, low)) };
+            const auto hi { _mm256_shuffle_epi8(
+                table, _mm256_and_si256(_mm256_srli_epi16(v, 4), low)) };
+
+            /* sums the byte counts of each word into its lane */
+            acc = _mm256_add_epi64(
+                acc,
+                _mm256_sad_epu8(_mm256_add_epi8(lo, hi),
+                                _mm256_setzero_si256()));
+        }
+
+        alignas(32) std::uint64_t lanes[4];
+        _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), acc);
+
+        std::size_t result { lanes[0] + lanes[1] + lanes[2] + lanes[3] };
+        for (; i < size; i++) result += std::popcount(words[i]);
+        return result;
+    }
+
+
+    KONCPP_AVX2 auto
+    any_avx2(const Word *words, std::size_t size) noexcept -> bool
+    {
+        std::size_t i { 0 };
+        for (; i + 4 <= size; i += 4)
+        {
+            const auto v { _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(words + i)) };
+            if (_mm256_testz_si256(v, v) == 0) return true;
+        }
+
+        for (; i < size; i++)
+            if (words[i] != 0) return true;
+        return false;
+    }
+
+
+    KONCPP_AVX2 auto
+    all_avx2(const Word *words, std::size_t size) noexcept -> bool
+    {
+        const auto  ones { _mm256_set1_epi64x(-1) };
+        std::size_t i { 0 };
+
+        for (; i + 4 <= size; i += 4)
+        {
+            const auto v { _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(words + i)) };
+            if (_mm256_testc_si256(v, ones) == 0) return false;
+        }
+
+        for (; i < size; i++)
+            if (words[i] != ~Word {}) return false;
+        return true;
+    }
+#endif
+
+
+    /* Integer columns share the unsigned kernels, which wrap around. */
+    template <typename T_Type>
+    auto
+    as_unsigned(const T_Type *values) noexcept
+    {
+        if constexpr (std::is_integral_v<T_Type>)
+            return reinterpret_cast<const types::Unsigned *>(values);
+        else
+            return values;
+    }
+
+
+    template <typename T_Type>
+    auto
+    as_unsigned(T_Type *values) noexcept
+    {
+        if constexpr (std::is_integral_v<T_Type>)
+            return reinterpret_cast<types::Unsigned *>(values);
+        else
+            return values;
+    }
+
+
+    auto
+    intersect(const Bitmap &lhs, const Bitmap &rhs) -> Bitmap
+    {
+        Bitmap result { lhs.size() };
+
+        const auto a { lhs.words() };
+        const auto b { rhs.words() };
+        const auto out { result.words() };
+
+        for (std::size_t w { 0 }; w < out.size(); w++) out[w] = a[w] & b[w];
+        return result;
+    }
+
+
+    template <bool T_Max, typename T_Type>
+    auto
+    extreme(const Column<T_Type> &column) -> std::optional<T_Type>
+    {
+        if (column.validity().count() == 0) return std::nullopt;
+
+        const auto *values { column.values().data() };
+        const auto *valid { column.validity().words().data() };
+        const auto  size { column.size() };
+
+#ifdef KONCPP_BULK_X86
+        switch (bulk::isa())
+        {
+        case Isa::Avx512:
+            return extreme_avx512<T_Max>(values, valid, size);
+        case Isa::Avx2:
+            if constexpr (std::same_as<T_Type, double>)
+                return extreme_avx2<T_Max>(values, valid, size);
+            break;
+        case Isa::Scalar: break;
+        }
+#endif
+
+        return extreme_scalar<T_Max>(
+            values, valid, 0, size, fill<T_Max, T_Type>());
+    }
+}
+
+
+auto
+bulk::isa() noexcept -> Isa
+{
+    return selected().load(std::memory_order_relaxed);
+}
+
+
+auto
+bulk::set_isa(Isa isa) noexcept -> Isa
+{
+    isa = std::min(isa, supported());
+    selected().store(isa, std::memory_order_relaxed);
+    return isa;
+}
+
+
+template <bulk::Element T_Type>
+auto
+bulk::sum(const Column<T_Type> &column) -> std::optional<T_Type>
+{
+    if (column.validity().count() == 0) return std::nullopt;
+
+    /* null elements hold zero, so they can be summed along */
+    const auto *values { as_unsigned(column.values().data()) };
+    const auto  size { column.size() };
+
+    auto result { [&]
+                  {
+#ifdef KONCPP_BULK_X86
+                      switch (bulk::isa())
+                      {
+                      case Isa::Avx512: return sum_avx512(values, size);
+                      case Isa::Avx2:   return sum_avx2(values, size);
+                      case Isa::Scalar: break;
+                      }
+#endif
+                      return sum_scalar(values, size);
+                  }() };
+
+    return static_cast<T_Type>(result);
+}
+
+
+template <bulk::Element T_Type>
+auto
+bulk::min(const Column<T_Type> &column) -> std::optional<T_Type>
+{
+    return extreme<false>(column);
+}
+
+
+template <bulk::Element T_Type>
+auto
+bulk::max(const Column<T_Type> &column) -> std::optional<T_Type>
+{
+    return extreme<true>(column);
+}
+
+
+template <bulk::Element T_Type>
+auto
+bulk::scale(const Column<T_Type> &column, T_Type factor) -> Column<T_Type>
+{
+    const auto         *values { column.values().data() };
+    const auto          size { column.size() };
+    std::vector<T_Type> out(size);
+
+    std::size_t done { 0 };
+
+#ifdef KONCPP_BULK_X86
+    if constexpr (std::same_as<T_Type, double>)
+    {
+        switch (bulk::isa())
+        {
+        case Isa::Avx512:
+            done = scale_avx512(values, factor, out.data(), size);
+            break;
+        case Isa::Avx2:
+            done = scale_avx2(values, factor, out.data(), size);
+            break;
+        case Isa::Scalar: break;
+        }
+    }
+#endif
+
+    scale_scalar(values, factor, out.data(), done, size);
+    return { std::move(out), column.validity() };
+}
+
+
+template <bulk::Element T_Type>
+auto
+bulk::add(const Column<T_Type> &lhs, const Column<T_Type> &rhs)
+    -> Column<T_Type>
+{
+    if (lhs.size() != rhs.size())
+        throw ValueError { "cannot add columns of {} and {} elements",
+                           lhs.size(),
+                           rhs.size() };
+
+    const auto         *a { as_unsigned(lhs.values().data()) };
+    const auto         *b { as_unsigned(rhs.values().data()) };
+    const auto          size { lhs.size() };
+    std::vector<T_Type> out(size);
+
+    auto       *result { as_unsigned(out.data()) };
+    std::size_t done { 0 };
+
+#ifdef KONCPP_BULK_X86
+    switch (bulk::isa())
+    {
+    case Isa::Avx512: done = add_avx512(a, b, result, size); break;
+    case Isa::Avx2:   done = add_avx2(a, b, result, size); break;
+    case Isa::Scalar: break;
+    }
+#endif
+
+    add_scalar(a, b, result, done, size);
+    return { std::move(out), intersect(lhs.validity(), rhs.validity()) };
+}
+
+
+template <bulk::Element T_Type>
+auto
+bulk::compare(const Column<T_Type> &column, Compare op, T_Type value)
+    -> Bitmap
+{
+    const auto *values { column.values().data() };
+    const auto  size { column.size() };
+
+    Bitmap      result { size };
+    auto       *out { result.words().data() };
+    std::size_t done { 0 };
+
+#ifdef KONCPP_BULK_X86
+    constexpr bool Unsigned { std::same_as<T_Type, types::Unsigned> };
+
+    with_op(op,
+            [&](auto constant)
+            {
+                constexpr auto Op { decltype(constant)::value };
+                const auto    *raw { as_unsigned(values) };
+                const auto     rhs { static_cast<
+                        std::remove_cvref_t<decltype(*raw)>>(value) };
+
+                switch (bulk::isa())
+                {
+                case Isa::Avx512:
+                    if constexpr (std::same_as<T_Type, double>)
+                        done = compare_avx512<Op>(raw, size, rhs, out);
+                    else
+                        done = compare_avx512<Op, Unsigned>(
+                            raw, size, rhs, out);
+                    break;
+                case Isa::Avx2:
+                    if constexpr (std::same_as<T_Type, double>)
+                        done = compare_avx2<Op>(raw, size, rhs, out);
+                    else
+                        done = compare_avx2<Op, Unsigned>(raw, size, rhs, out);
+                    break;
+                case Isa::Scalar: break;
+                }
+            });
+#endif
+
+    compare_scalar(values, done, size, op, value, out);
+
+    /* null elements never match */
+    const auto valid { column.validity().words() };
+    for (std::size_t w { 0 }; w < valid.size(); w++) out[w] &= valid[w];
+
+    return result;
+}
+
+
+template <bulk::Element T_Type>
+auto
+bulk::filter(const Column<T_Type> &column, const Bitmap &mask)
+    -> Column<T_Type>
+{
+    if (column.size() != mask.size())
+        throw ValueError { "cannot filter {} elements with a {} bit mask",
+                           column.size(),
+                           mask.size() };
+
+    const auto selected { mask.count() };
+
+    std::vector<T_Type> values;
+    Bitmap              validity;
+    values.reserve(selected);
+    validity.reserve(selected);
+
+    const auto words { mask.words() };
+    for (std::size_t w { 0 }; w < words.size(); w++)
+        for (auto bits { words[w] }; bits != 0; bits &= bits - 1)
+        {
+            const auto index { (w * WordBits) + std::countr_zero(bits) };
+            values.push_back(column.values()[index]);
+            validity.push_back(column.validity().test(index));
+        }
+
+    return { std::move(values), std::move(validity) };
+}
+
+
+auto
+bulk::count(const Bitmap &bitmap) noexcept -> std::size_t
+{
+    const auto words { bitmap.words() };
+
+#ifdef KONCPP_BULK_X86
+    switch (bulk::isa())
+    {
+    case Isa::Avx512:
+        if (has_vector_popcount())
+            return count_avx512(words.data(), words.size());
+        [[fallthrough]];
+    case Isa::Avx2:   return count_avx2(words.data(), words.size());
+    case Isa::Scalar: break;
+    }
+#endif
+
+    return bitmap.count();
+}
+
+
+auto
+bulk::any(const Bitmap &bitmap) noexcept -> bool
+{
+    const auto words { bitmap.words() };
+
+#ifdef KONCPP_BULK_X86
+    if (bulk::isa() != Isa::Scalar)
+        return any_avx2(words.data(), words.size());
+#endif
+
+    return std::ranges::any_of(words, [](Word word) { return word != 0; });
+}
+
+
+auto
+bulk::all(const Bitmap &bitmap) noexcept -> bool
+{
+    auto words { bitmap.words() };
+
+    /* bits past the end are clear, so the last word is checked on its own */
+    if (const auto tail { bitmap.size() % WordBits }; tail != 0)
+    {
+        if (words.back() != (Word { 1 } << tail) - 1) return false;
+        words = words.first(words.size() - 1);
+    }
+
+#ifdef KONCPP_BULK_X86
+    if (bulk::isa() != Isa::Scalar)
+        return all_avx2(words.data(), words.size());
+#endif
+
+    return std::ranges::all_of(words,
+                               [](Word word) { return word == ~Word {}; });
+}
+
+
+#define KONCPP_INSTANTIATE(T_Type)                                           \
+    template auto bulk::sum(const Column<T_Type> &) -> std::optional<T_Type>; \
+    template auto bulk::min(const Column<T_Type> &) -> std::optional<T_Type>; \
+    template auto bulk::max(const Column<T_Type> &) -> std::optional<T_Type>; \
+    template auto bulk::scale(const Column<T_Type> &, T_Type)                \
+        -> Column<T_Type>;                                                   \
+    template auto bulk::add(const Column<T_Type> &, const Column<T_Type> &)  \
+        -> Column<T_Type>;                                                   \
+    template auto bulk::compare(const Column<T_Type> &, Compare, T_Type)     \
+        -> Bitmap;                                                           \
+    template auto bulk::filter(const Column<T_Type> &, const Bitmap &)       \
+        -> Column<T_Type>;
+
+KONCPP_INSTANTIATE(types::Signed)
+KONCPP_INSTANTIATE(types::Unsigned)
+KONCPP_INSTANTIATE(double)
+
+#undef KONCPP_INSTANTIATE
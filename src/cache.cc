@@ -0,0 +1,469 @@
+/**
+ * @file cache.cc
+ * @copyright Copyright (C) 2025-2026 Kei <RQuarx@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <random>
+
+#include "koncpp/cache.hh"
+#include "koncpp/index.hh"
+#include "koncpp/trace.hh"
+
+using koncpp::ParseCache;
+using koncpp::TapeRecorder;
+
+
+namespace
+{
+    /* The version is part of the magic, entries of older ones are
+       replaced. */
+    constexpr std::string_view Magic { "KONCACH\2", 8 };
+
+    /* magic, source size, source hash, tape size; then the source itself
+       and the tape */
+    constexpr std::size_t HeaderSize { Magic.size() + 3 * 8 };
+
+
+    enum class Op : std::uint8_t
+    {
+        Key,
+        BeginObject,
+        EndObject,
+        BeginArray,
+        EndArray,
+        Null,
+        Integer,
+        Unsigned,
+        Float,
+        True,
+        False,
+        String
+    };
+
+
+    void
+    put(std::string &tape, Op op)
+    {
+        tape.push_back(static_cast<char>(op));
+    }
+
+
+    template <typename T_Type>
+    void
+    put(std::string &tape, Op op, T_Type value)
+    {
+        char bytes[sizeof(value)];
+        std::memcpy(bytes, &value, sizeof(value));
+
+        tape.push_back(static_cast<char>(op));
+        tape.append(bytes, sizeof(value));
+    }
+
+
+    void
+    put(std::string &tape, Op op, std::string_view text)
+    {
+        put(tape, op, static_cast<std::uint32_t>(text.size()));
+        tape.append(text);
+    }
+
+
+    template <typename T_Type>
+    auto
+    read(const char *data) noexcept -> T_Type
+    {
+        T_Type value;
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+
+    /* The size of the operand of @p op , not counting a text's bytes. */
+    constexpr auto
+    operand_size(Op op) noexcept -> std::size_t
+    {
+        switch (op)
+        {
+        case Op::Key:
+        case Op::String:   return 4;
+        case Op::Integer:
+        case Op::Unsigned:
+        case Op::Float:    return 8;
+        default:           return 0;
+        }
+    }
+
+
+    /* Counts the events reported before a handler threw, see replay(). */
+    void
+    play(std::string_view tape, koncpp::Handler &handler, std::size_t &events)
+    {
+        using koncpp::types::Signed;
+        using koncpp::types::Unsigned;
+
+        const auto *data { tape.data() };
+        std::size_t pos { 0 };
+
+        const auto text = [&]
+        {
+            const auto size { read<std::uint32_t>(data + pos) };
+            const std::string_view result { data + pos + 4, size };
+            pos += 4 + size;
+            return result;
+        };
+
+        for (; pos < tape.size(); events++)
+        {
+            switch (static_cast<Op>(data[pos++]))
+            {
+            case Op::Key:         handler.key(text()); break;
+            case Op::BeginObject: handler.begin_object(); break;
+            case Op::EndObject:   handler.end_object(); break;
+            case Op::BeginArray:  handler.begin_array(); break;
+            case Op::EndArray:    handler.end_array(); break;
+            case Op::Null:        handler.null(); break;
+            case Op::True:        handler.boolean(true); break;
+            case Op::False:       handler.boolean(false); break;
+            case Op::String:      handler.string(text()); break;
+            case Op::Integer:
+                handler.integer(read<Signed>(data + pos));
+                pos += 8;
+                break;
+            case Op::Unsigned:
+                handler.unsigned_integer(read<Unsigned>(data + pos));
+                pos += 8;
+                break;
+            case Op::Float:
+                handler.floating(read<double>(data + pos));
+                pos += 8;
+                break;
+            }
+        }
+    }
+
+
+    /* Stops a parse at an event, to find out where in the source it is. */
+    class Stop : public koncpp::Handler
+    {
+    public:
+        explicit Stop(std::size_t event) : m_left(event) {}
+
+        void key(std::string_view) override { mf_event(); }
+
+        void begin_object() override { mf_event(); }
+        void end_object() override { mf_event(); }
+        void begin_array() override { mf_event(); }
+        void end_array() override { mf_event(); }
+
+        void null() override { mf_event(); }
+        void integer(koncpp::types::Signed) override { mf_event(); }
+        void unsigned_integer(koncpp::types::Unsigned) override { mf_event(); }
+        void floating(double) override { mf_event(); }
+        void boolean(bool) override { mf_event(); }
+        void string(std::string_view) override { mf_event(); }
+
+
+    private:
+        std::size_t m_left;
+
+
+        void
+        mf_event()
+        {
+            if (m_left-- == 0) throw koncpp::ValueError { "stop" };
+        }
+    };
+
+
+    /*
+     * Replays @p tape , recorded from @p source , turning a ValueError of
+     * @p handler into a ParseError at the same offset as a parse would.
+     */
+    void
+    replay_source(std::string_view tape,
+                  std::string_view source,
+                  koncpp::Handler &handler)
+    {
+        std::size_t events { 0 };
+
+        try
+        {
+            play(tape, handler, events);
+        }
+        catch (const koncpp::ValueError &e)
+        {
+            /* only failures pay for finding the offset again */
+            Stop       stop { events };
+            const auto found { koncpp::Parser {}.try_parse(source, stop) };
+
+            throw koncpp::ParseError {
+                { koncpp::ErrorCode::InvalidValue,
+                  found ? source.size() : found.error().offset },
+                e.what()
+            };
+        }
+    }
+
+
+    /* Makes a name no other process or thread uses at the same time. */
+    auto
+    temporary_name(const std::filesystem::path &entry) -> std::filesystem::path
+    {
+        static std::atomic<std::uint64_t> counter {};
+        thread_local const auto           seed { std::random_device {}() };
+
+        auto path { entry };
+        path += std::format(".{:08x}.{}.tmp", seed,
+                            counter.fetch_add(1, std::memory_order_relaxed));
+        return path;
+    }
+}
+
+
+void
+TapeRecorder::key(std::string_view key)
+{
+    put(m_tape, Op::Key, key);
+}
+
+
+void
+TapeRecorder::begin_object()
+{
+    put(m_tape, Op::BeginObject);
+}
+
+
+void
+TapeRecorder::end_object()
+{
+    put(m_tape, Op::EndObject);
+}
+
+
+void
+TapeRecorder::begin_array()
+{
+    put(m_tape, Op::BeginArray);
+}
+
+
+void
+TapeRecorder::end_array()
+{
+    put(m_tape, Op::EndArray);
+}
+
+
+void
+TapeRecorder::null()
+{
+    put(m_tape, Op::Null);
+}
+
+
+void
+TapeRecorder::integer(types::Signed value)
+{
+    put(m_tape, Op::Integer, value);
+}
+
+
+void
+TapeRecorder::unsigned_integer(types::Unsigned value)
+{
+    put(m_tape, Op::Unsigned, value);
+}
+
+
+void
+TapeRecorder::floating(double value)
+{
+    put(m_tape, Op::Float, value);
+}
+
+
+void
+TapeRecorder::boolean(bool value)
+{
+    put(m_tape, value ? Op::True : Op::False);
+}
+
+
+void
+TapeRecorder::string(std::string_view value)
+{
+    put(m_tape, Op::String, value);
+}
+
+
+auto
+koncpp::valid_tape(std::string_view tape) noexcept -> bool
+{
+    std::size_t depth { 0 };
+    std::size_t pos { 0 };
+
+    while (pos < tape.size())
+    {
+        const auto op { static_cast<Op>(tape[pos++]) };
+        if (op > Op::String) return false;
+
+        const auto size { operand_size(op) };
+        if (tape.size() - pos < size) return false;
+
+        if (op == Op::Key || op == Op::String)
+        {
+            const auto length { read<std::uint32_t>(tape.data() + pos) };
+            if (tape.size() - pos - size < length) return false;
+            pos += length;
+        }
+        pos += size;
+
+        if (op == Op::BeginObject || op == Op::BeginArray)
+            depth++;
+        else if (op == Op::EndObject || op == Op::EndArray)
+        {
+            if (depth == 0) return false;
+            depth--;
+        }
+    }
+
+    return depth == 0;
+}
+
+
+void
+koncpp::replay(std::string_view tape, Handler &handler)
+{
+    std::size_t events { 0 };
+    play(tape, handler, events);
+}
+
+
+ParseCache::ParseCache(std::filesystem::path directory)
+    : m_directory(std::move(directory))
+{
+    std::error_code error;
+    std::filesystem::create_directories(m_directory, error);
+    if (error)
+        throw Exception { "cannot create '{}': {}", m_directory.string(),
+                          error.message() };
+}
+
+
+void
+ParseCache::parse(std::string_view source, Handler &handler)
+{
+    koncpp::trace::Span span { "cache" };
+
+    const auto hash { hash_contents(source) };
+    const auto entry { mf_entry(source, hash) };
+
+    try
+    {
+        const detail::FileContents contents { entry };
+        const auto                 view { contents.view() };
+
+        if (view.size() >= HeaderSize + source.size()
+            && view.starts_with(Magic)
+            && read<std::uint64_t>(view.data() + 8) == source.size()
+            && read<std::uint64_t>(view.data() + 16) == hash
+            && read<std::uint64_t>(view.data() + 24)
+                   == view.size() - HeaderSize - source.size()
+            && view.substr(HeaderSize, source.size()) == source)
+        {
+            const auto tape { view.substr(HeaderSize + source.size()) };
+
+            if (valid_tape(tape))
+            {
+                span.arg("hit", 1);
+                m_hits.fetch_add(1, std::memory_order_relaxed);
+                replay_source(tape, source, handler);
+                return;
+            }
+        }
+    }
+    catch (const IndexError &)
+    {
+        /* not cached yet */
+    }
+
+    span.arg("hit", 0);
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+
+    /* replayed rather than forwarded, so that nothing of a source that
+       fails to parse reaches the handler */
+    TapeRecorder recorder;
+    Parser {}.parse(source, recorder);
+
+    /* stored only once the handler took it, a tape that cannot be built
+       is parsed again next time */
+    replay_source(recorder.tape(), source, handler);
+    mf_store(entry, source, hash, recorder.tape());
+}
+
+
+auto
+ParseCache::entry_path(std::string_view source) const -> std::filesystem::path
+{
+    return mf_entry(source, hash_contents(source));
+}
+
+
+auto
+ParseCache::mf_entry(std::string_view source, std::uint64_t hash) const
+    -> std::filesystem::path
+{
+    return m_directory / std::format("{:016x}-{:x}.kcache", hash,
+                                     source.size());
+}
+
+
+void
+ParseCache::mf_store(const std::filesystem::path &entry,
+                     std::string_view             source,
+                     std::uint64_t                hash,
+                     std::string_view             tape) const
+{
+    const auto temporary { temporary_name(entry) };
+
+    {
+        std::ofstream out { temporary, std::ios::binary | std::ios::trunc };
+        if (!out) return;
+
+        const std::uint64_t header[] { source.size(), hash, tape.size() };
+        out.write(Magic.data(), static_cast<std::streamsize>(Magic.size()));
+        out.write(reinterpret_cast<const char *>(header), sizeof(header));
+        out.write(source.data(), static_cast<std::streamsize>(source.size()));
+        out.write(tape.data(), static_cast<std::streamsize>(tape.size()));
+
+        if (!out.flush())
+        {
+            out.close();
+            std::error_code error;
+            std::filesystem::remove(temporary, error);
+            return;
+        }
+    }
+
+    /* readers see either the old entry or the complete new one */
+    std::error_code error;
+    std::filesystem::rename(temporary, entry, error);
+    if (error) std::filesystem::remove(temporary, error);
+}
@@ -0,0 +1,412 @@
+/**
+ * @file index.cc
+ * @copyright Copyright (C) 2025-2026 Kei <RQuarx@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <utility>
+
+#include "koncpp/index.hh"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using koncpp::IndexedFile;
+using koncpp::IndexError;
+using koncpp::SourceIndex;
+using koncpp::detail::FileContents;
+
+
+namespace
+{
+    /* The version is part of the magic, older indexes are rebuilt. */
+    constexpr std::string_view Magic { "KONIDX\0\2", 8 };
+
+    /* What hash_sample() reads, 64 KiB in all. */
+    constexpr std::size_t SampleBlocks { 16 };
+    constexpr std::size_t SampleBlockSize { 4096 };
+
+
+    /* Whether one of the dotted keys @p lhs and @p rhs leads to the
+       other, or they are the same. */
+    auto
+    related(std::string_view lhs, std::string_view rhs) noexcept -> bool
+    {
+        while (true)
+        {
+            const auto lhs_dot { lhs.find('.') };
+            const auto rhs_dot { rhs.find('.') };
+
+            if (lhs.substr(0, lhs_dot) != rhs.substr(0, rhs_dot)) return false;
+            if (lhs_dot == std::string_view::npos
+                || rhs_dot == std::string_view::npos)
+                return true;
+
+            lhs.remove_prefix(lhs_dot + 1);
+            rhs.remove_prefix(rhs_dot + 1);
+        }
+    }
+
+
+    auto
+    segments(std::string_view key) noexcept -> std::size_t
+    {
+        return static_cast<std::size_t>(std::ranges::count(key, '.')) + 1;
+    }
+
+
+    auto
+    mtime(const std::filesystem::path &file) -> std::int64_t
+    {
+        std::error_code error;
+        const auto      time { std::filesystem::last_write_time(file, error) };
+        if (error)
+            throw IndexError { "cannot stat '{}': {}", file.string(),
+                               error.message() };
+        return static_cast<std::int64_t>(time.time_since_epoch().count());
+    }
+
+
+    template <typename T_Type>
+    void
+    put(std::ostream &out, T_Type value)
+    {
+        out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+
+
+    template <typename T_Type>
+    auto
+    take(std::istream &in) -> T_Type
+    {
+        T_Type value {};
+        if (!in.read(reinterpret_cast<char *>(&value), sizeof(value)))
+            throw IndexError { "index is truncated" };
+        return value;
+    }
+}
+
+
+auto
+koncpp::hash_contents(std::string_view contents) noexcept -> std::uint64_t
+{
+    constexpr std::uint64_t Multiplier { 0xff51afd7ed558ccd };
+
+    std::uint64_t hash { 0x9e3779b97f4a7c15 ^ contents.size() };
+    std::size_t   pos { 0 };
+
+    for (; pos + 8 <= contents.size(); pos += 8)
+    {
+        std::uint64_t word {};
+        std::memcpy(&word, contents.data() + pos, 8);
+        hash = std::rotl((hash ^ word) * Multiplier, 29);
+    }
+
+    std::uint64_t tail {};
+    if (pos < contents.size())
+        std::memcpy(&tail, contents.data() + pos, contents.size() - pos);
+    hash = std::rotl((hash ^ tail) * Multiplier, 29);
+
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+
+auto
+koncpp::hash_sample(std::string_view contents) noexcept -> std::uint64_t
+{
+    constexpr auto Sampled { SampleBlocks * SampleBlockSize };
+    if (contents.size() <= Sampled) return hash_contents(contents);
+
+    const auto    stride { (contents.size() - SampleBlockSize)
+                        / (SampleBlocks - 1) };
+    std::uint64_t hash { contents.size() };
+
+    for (std::size_t i { 0 }; i < SampleBlocks; i++)
+    {
+        const auto block { hash_contents(
+            contents.substr(i * stride, SampleBlockSize)) };
+        hash = std::rotl(hash ^ block, 29) * 0xff51afd7ed558ccd;
+    }
+    return hash;
+}
+
+
+auto
+SourceIndex::build(std::string_view source) -> SourceIndex
+{
+    Parser     parser;
+    const auto ranges { parser.outline(source, 2) };
+
+    SourceIndex index;
+    index.entries.reserve(ranges.size());
+
+    for (const auto &range : ranges)
+        index.entries.push_back(
+            { .key    = std::string { range.key },
+              .begin  = range.begin,
+              .end    = range.end,
+              .parent = range.parent == std::string_view::npos
+                          ? NoParent
+                          : static_cast<std::uint32_t>(range.parent) });
+
+    return index;
+}
+
+
+auto
+SourceIndex::read(const std::filesystem::path &path) -> SourceIndex
+{
+    std::ifstream in { path, std::ios::binary };
+    if (!in) throw IndexError { "cannot open '{}'", path.string() };
+
+    char magic[Magic.size()] {};
+    if (!in.read(magic, sizeof(magic))
+        || std::string_view { magic, sizeof(magic) } != Magic)
+        throw IndexError { "'{}' is not a kon index", path.string() };
+
+    SourceIndex index;
+    index.stamp.size   = take<std::uint64_t>(in);
+    index.stamp.mtime  = take<std::int64_t>(in);
+    index.stamp.hash   = take<std::uint64_t>(in);
+    index.stamp.sample = take<std::uint64_t>(in);
+
+    const auto count { take<std::uint64_t>(in) };
+
+    for (std::uint64_t i { 0 }; i < count; i++)
+    {
+        Entry entry {};
+        entry.begin  = take<std::uint64_t>(in);
+        entry.end    = take<std::uint64_t>(in);
+        entry.parent = take<std::uint32_t>(in);
+
+        const auto size { take<std::uint32_t>(in) };
+        entry.key.resize(size);
+        if (!in.read(entry.key.data(), size))
+            throw IndexError { "index is truncated" };
+
+        if (entry.begin > entry.end || entry.end > index.stamp.size
+            || (entry.parent != NoParent && entry.parent >= i))
+            throw IndexError { "'{}' is corrupt", path.string() };
+
+        index.entries.push_back(std::move(entry));
+    }
+
+    return index;
+}
+
+
+void
+SourceIndex::write(const std::filesystem::path &path) const
+{
+    std::ofstream out { path, std::ios::binary | std::ios::trunc };
+    if (!out) throw IndexError { "cannot create '{}'", path.string() };
+
+    out.write(Magic.data(), static_cast<std::streamsize>(Magic.size()));
+    put(out, stamp.size);
+    put(out, stamp.mtime);
+    put(out, stamp.hash);
+    put(out, stamp.sample);
+    put(out, static_cast<std::uint64_t>(entries.size()));
+
+    for (const auto &entry : entries)
+    {
+        put(out, entry.begin);
+        put(out, entry.end);
+        put(out, entry.parent);
+        put(out, static_cast<std::uint32_t>(entry.key.size()));
+        out.write(entry.key.data(),
+                  static_cast<std::streamsize>(entry.key.size()));
+    }
+
+    if (!out.flush()) throw IndexError { "cannot write '{}'", path.string() };
+}
+
+
+auto
+koncpp::sidecar_path(const std::filesystem::path &file)
+    -> std::filesystem::path
+{
+    auto path { file };
+    path += ".kidx";
+    return path;
+}
+
+
+auto
+koncpp::write_index(const std::filesystem::path &file) -> SourceIndex
+{
+    const FileContents contents { file };
+    const auto         source { contents.view() };
+
+    auto index { SourceIndex::build(source) };
+    index.stamp = { .size   = source.size(),
+                    .mtime  = mtime(file),
+                    .hash   = hash_contents(source),
+                    .sample = hash_sample(source) };
+
+    index.write(sidecar_path(file));
+    return index;
+}
+
+
+auto
+koncpp::open_indexed(const std::filesystem::path &file, Verify verify)
+    -> IndexedFile
+{
+    auto         index { SourceIndex::read(sidecar_path(file)) };
+    const auto   time { mtime(file) };
+    FileContents contents { file };
+
+    const auto source { contents.view() };
+    if (index.stamp.size != source.size() || index.stamp.mtime != time
+        || (verify != Verify::Stamp
+            && index.stamp.sample != hash_sample(source))
+        || (verify == Verify::Contents
+            && index.stamp.hash != hash_contents(source)))
+        throw IndexError { "'{}' has changed since it was indexed",
+                           file.string() };
+
+    return IndexedFile { std::move(contents), std::move(index) };
+}
+
+
+IndexedFile::IndexedFile(detail::FileContents contents, SourceIndex index)
+    : m_contents(std::move(contents)), m_index(std::move(index))
+{
+    for (std::uint32_t i { 0 }; i < m_index.entries.size(); i++)
+    {
+        const auto &entry { m_index.entries[i] };
+        if (entry.parent != SourceIndex::NoParent) continue;
+
+        const std::string_view key { entry.key };
+        m_roots[key.substr(0, key.find('.'))].push_back(i);
+    }
+}
+
+
+auto
+IndexedFile::fragments(const Path &path) const -> std::vector<Fragment>
+{
+    const auto source { this->source() };
+    const auto text = [&](const SourceIndex::Entry &entry)
+    {
+        return source.substr(entry.begin, entry.end - entry.begin);
+    };
+
+    if (path.empty()) return { { source, {} } };
+
+    const auto it { m_roots.find(path[0].name) };
+    if (it == m_roots.end()) return {};
+
+    const auto &entries { m_index.entries };
+
+    std::vector<Fragment> result;
+    for (const auto index : it->second)
+    {
+        const auto &root { entries[index] };
+        if (!related(root.key, path.text())) continue;
+
+        /* the members of the root member's object are narrower, where
+           the path leads into one of them */
+        auto child { index + 1 };
+        if (path.size() <= segments(root.key) || child == entries.size()
+            || entries[child].parent != index)
+        {
+            result.push_back({ text(root), {} });
+            continue;
+        }
+
+        const auto rest { path.text().substr(root.key.size() + 1) };
+        for (; child < entries.size() && entries[child].parent == index;
+             child++)
+            if (related(entries[child].key, rest))
+                result.push_back({ text(entries[child]), root.key });
+    }
+
+    return result;
+}
+
+
+FileContents::FileContents(const std::filesystem::path &path)
+{
+#if defined(__unix__) || defined(__APPLE__)
+    const auto fd { ::open(path.c_str(), O_RDONLY | O_CLOEXEC) };
+    if (fd < 0) throw IndexError { "cannot open '{}'", path.string() };
+
+    struct stat info {};
+    if (::fstat(fd, &info) != 0)
+    {
+        ::close(fd);
+        throw IndexError { "cannot stat '{}'", path.string() };
+    }
+
+    m_size = static_cast<std::size_t>(info.st_size);
+    if (m_size > 0)
+    {
+        auto *data { ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0) };
+        if (data == MAP_FAILED)
+        {
+            ::close(fd);
+            throw IndexError { "cannot map '{}'", path.string() };
+        }
+
+        m_data   = static_cast<const char *>(data);
+        m_mapped = true;
+    }
+
+    ::close(fd);
+#else
+    std::ifstream in { path, std::ios::binary | std::ios::ate };
+    if (!in) throw IndexError { "cannot open '{}'", path.string() };
+
+    m_size = static_cast<std::size_t>(in.tellg());
+    auto buffer { std::make_unique<char[]>(m_size) };
+
+    in.seekg(0);
+    if (!in.read(buffer.get(), static_cast<std::streamsize>(m_size)))
+        throw IndexError { "cannot read '{}'", path.string() };
+    m_data = buffer.release();
+#endif
+}
+
+
+FileContents::~FileContents()
+{
+#if defined(__unix__) || defined(__APPLE__)
+    if (m_mapped) ::munmap(const_cast<char *>(m_data), m_size);
+#else
+    delete[] m_data;
+#endif
+}
+
+
+FileContents::FileContents(FileContents &&other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr)),
+      m_size(std::exchange(other.m_size, 0)),
+      m_mapped(std::exchange(other.m_mapped, false))
+{
+}
@@ -0,0 +1,940 @@
+/**
+ * @file json.cc
+ * @copyright Copyright (C) 2025-2026 Kei <RQuarx@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <array>
+#include <charconv>
+
+#include "koncpp/json.hh"
+#include "koncpp/trace.hh"
+
+using koncpp::JsonError;
+using koncpp::JsonWriter;
+using koncpp::KonWriter;
+using koncpp::detail::Sink;
+
+
+namespace
+{
+    constexpr std::string_view Hex { "0123456789abcdef" };
+
+
+    template <typename T_Number>
+    auto
+    format(T_Number value, std::array<char, 32> &buffer) -> std::string_view
+    {
+        const auto result { std::to_chars(buffer.data(),
+                                          buffer.data() + buffer.size(),
+                                          value) };
+        return { buffer.data(), result.ptr };
+    }
+
+
+    /* SYNTAX.md §2.8 and §5, like the parser's key(). */
+    auto
+    is_kon_key(std::string_view key) noexcept -> bool
+    {
+        if (key.empty()) return false;
+        if (!((key[0] >= 'A' && key[0] <= 'Z')
+              || (key[0] >= 'a' && key[0] <= 'z')))
+            return false;
+
+        return key.find_first_of(std::string_view { ".:{}[]/*\";, \t\r\n" })
+            == std::string_view::npos;
+    }
+
+
+    /* Reads a JSON document, RFC 8259. */
+    class Reader
+    {
+    public:
+        Reader(std::string_view source, koncpp::Handler &handler)
+            : m_src(source), m_handler(handler)
+        {
+        }
+
+
+        void
+        document()
+        {
+            skip();
+            value();
+            skip();
+
+            if (m_pos < m_src.size()) fail("unexpected content");
+        }
+
+
+        [[nodiscard]]
+        auto
+        position() const noexcept -> std::size_t
+        {
+            return m_pos;
+        }
+
+
+    private:
+        std::string_view m_src;
+        koncpp::Handler &m_handler;
+        std::string      m_buffer;
+        std::size_t      m_pos {};
+        std::size_t      m_nesting {};
+
+
+        /* A level of nesting, counted for as long as it lives. */
+        class Nested
+        {
+        public:
+            explicit Nested(Reader &reader) : m_reader(reader)
+            {
+                if (++m_reader.m_nesting > koncpp::MaxDepth)
+                    m_reader.fail("nesting too deep");
+            }
+
+            ~Nested()
+            {
+                m_reader.m_nesting--;
+            }
+
+            Nested(const Nested &)                     = delete;
+            auto operator=(const Nested &) -> Nested & = delete;
+
+
+        private:
+            Reader &m_reader;
+        };
+
+
+        [[noreturn]]
+        void
+        fail(std::string_view message) const
+        {
+            throw JsonError { message, m_pos };
+        }
+
+
+        [[nodiscard]]
+        auto
+        peek() const noexcept -> char
+        {
+            return m_pos < m_src.size() ? m_src[m_pos] : '\0';
+        }
+
+
+        void
+        expect(char c, std::string_view message)
+        {
+            if (peek() != c) fail(message);
+            m_pos++;
+        }
+
+
+        void
+        skip() noexcept
+        {
+            while (m_pos < m_src.size())
+            {
+                const auto c { m_src[m_pos] };
+                if (c != ' ' && c != '\t' && c != '\n' && c != '\r') break;
+                m_pos++;
+            }
+        }
+
+
+        void
+        value()
+        {
+            switch (peek())
+            {
+            case '{': object(); return;
+            case '[': array(); return;
+            case '"': m_handler.string(string()); return;
+            case 't': literal("true"); m_handler.boolean(true); return;
+            case 'f': literal("false"); m_handler.boolean(false); return;
+            case 'n': literal("null"); m_handler.null(); return;
+            default:  number(); return;
+            }
+        }
+
+
+        void
+        literal(std::string_view word)
+        {
+            if (!m_src.substr(m_pos).starts_with(word)) fail("invalid value");
+            m_pos += word.size();
+        }
+
+
+        void
+        object()
+        {
+            const Nested nested { *this };
+
+            m_pos++;
+            m_handler.begin_object();
+
+            skip();
+            if (peek() == '}')
+            {
+                m_pos++;
+                m_handler.end_object();
+                return;
+            }
+
+            while (true)
+            {
+                if (peek() != '"') fail("expected a key");
+                m_handler.key(string());
+
+                skip();
+                expect(':', "expected ':' after a key");
+                skip();
+                value();
+                skip();
+
+                if (peek() == '}') break;
+                expect(',', "expected ',' or '}'");
+                skip();
+            }
+
+            m_pos++;
+            m_handler.end_object();
+        }
+
+
+        void
+        array()
+        {
+            const Nested nested { *this };
+
+            m_pos++;
+            m_handler.begin_array();
+
+            skip();
+            if (peek() == ']')
+            {
+                m_pos++;
+                m_handler.end_array();
+                return;
+            }
+
+            while (true)
+            {
+                value();
+                skip();
+
+                if (peek() == ']') break;
+                expect(',', "expected ',' or ']'");
+                skip();
+            }
+
+            m_pos++;
+            m_handler.end_array();
+        }
+
+
+        /**
+         * Returns the unescaped body of the string at the current position,
+         * a view of the source if it has no escape sequences.
+         */
+        auto
+        string() -> std::string_view
+        {
+            const auto open { m_pos++ };
+            auto       start { m_pos };
+            bool       buffered { false };
+
+            while (true)
+            {
+                auto end { m_pos };
+                while (end < m_src.size() && m_src[end] != '"'
+                       && m_src[end] != '\\'
+                       && static_cast<unsigned char>(m_src[end]) >= 0x20)
+                    end++;
+
+                if (end >= m_src.size())
+                {
+                    m_pos = open;
+                    fail("unterminated string");
+                }
+
+                if (m_src[end] == '"')
+                {
+                    m_pos = end + 1;
+                    if (!buffered) return m_src.substr(start, end - start);
+
+                    m_buffer.append(m_src.substr(start, end - start));
+                    return m_buffer;
+                }
+
+                m_pos = end;
+                if (m_src[end] != '\\') fail("control character in a string");
+
+                if (!buffered)
+                {
+                    m_buffer.clear();
+                    buffered = true;
+                }
+
+                m_buffer.append(m_src.substr(start, end - start));
+                m_pos++;
+                escape();
+                start = m_pos;
+            }
+        }
+
+
+        void
+        escape()
+        {
+            const auto c { peek() };
+            m_pos++;
+
+            switch (c)
+            {
+            case '"':  m_buffer.push_back('"'); return;
+            case '\\': m_buffer.push_back('\\'); return;
+            case '/':  m_buffer.push_back('/'); return;
+            case 'b':  m_buffer.push_back('\b'); return;
+            case 'f':  m_buffer.push_back('\f'); return;
+            case 'n':  m_buffer.push_back('\n'); return;
+            case 'r':  m_buffer.push_back('\r'); return;
+            case 't':  m_buffer.push_back('\t'); return;
+            case 'u':  break;
+            default:   m_pos--; fail("invalid escape sequence");
+            }
+
+            auto code { hex() };
+
+            /* a surrogate pair */
+            if (code >= 0xD800 && code <= 0xDBFF
+                && m_src.substr(m_pos).starts_with("\\u"))
+            {
+                const auto save { m_pos };
+                m_pos += 2;
+
+                const auto low { hex() };
+                if (low >= 0xDC00 && low <= 0xDFFF)
+                    code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                else
+                    m_pos = save;
+            }
+
+            /* lone surrogates cannot be encoded */
+            if (code >= 0xD800 && code <= 0xDFFF) code = 0xFFFD;
+
+            append_utf8(code);
+        }
+
+
+        auto
+        hex() -> std::uint32_t
+        {
+            std::uint32_t code {};
+
+            for (int i { 0 }; i < 4; i++, m_pos++)
+            {
+                const auto digit { Hex.find(static_cast<char>(
+                    peek() >= 'A' && peek() <= 'F' ? peek() - 'A' + 'a'
+                                                   : peek())) };
+                if (peek() == '\0' || digit == std::string_view::npos)
+                    fail("invalid unicode escape");
+                code = (code << 4) | static_cast<std::uint32_t>(digit);
+            }
+
+            return code;
+        }
+
+
+        void
+        append_utf8(std::uint32_t code)
+        {
+            const auto byte = [](std::uint32_t value)
+            { return static_cast<char>(value); };
+
+            if (code < 0x80)
+                m_buffer.push_back(byte(code));
+            else if (code < 0x800)
+            {
+                m_buffer.push_back(byte(0xC0 | (code >> 6)));
+                m_buffer.push_back(byte(0x80 | (code & 0x3F)));
+            }
+            else if (code < 0x10000)
+            {
+                m_buffer.push_back(byte(0xE0 | (code >> 12)));
+                m_buffer.push_back(byte(0x80 | ((code >> 6) & 0x3F)));
+                m_buffer.push_back(byte(0x80 | (code & 0x3F)));
+            }
+            else
+            {
+                m_buffer.push_back(byte(0xF0 | (code >> 18)));
+                m_buffer.push_back(byte(0x80 | ((code >> 12) & 0x3F)));
+                m_buffer.push_back(byte(0x80 | ((code >> 6) & 0x3F)));
+                m_buffer.push_back(byte(0x80 | (code & 0x3F)));
+            }
+        }
+
+
+        void
+        number()
+        {
+            const auto start { m_pos };
+            const auto digits = [&]
+            {
+                const auto first { m_pos };
+                while (peek() >= '0' && peek() <= '9') m_pos++;
+                return m_pos > first;
+            };
+
+            if (peek() == '-') m_pos++;
+
+            if (peek() == '0')
+                m_pos++;
+            else if (!digits())
+            {
+                m_pos = start;
+                fail("expected a value");
+            }
+
+            bool is_float { false };
+
+            if (peek() == '.')
+            {
+                is_float = true;
+                m_pos++;
+                if (!digits()) fail("invalid number");
+            }
+
+            if (peek() == 'e' || peek() == 'E')
+            {
+                is_float = true;
+                m_pos++;
+                if (peek() == '-' || peek() == '+') m_pos++;
+                if (!digits()) fail("invalid number");
+            }
+
+            const auto *first { m_src.data() + start };
+            const auto *last { m_src.data() + m_pos };
+
+            if (!is_float)
+            {
+                koncpp::types::Signed value {};
+                if (std::from_chars(first, last, value).ec == std::errc {})
+                {
+                    m_handler.integer(value);
+                    return;
+                }
+
+                koncpp::types::Unsigned big {};
+                if (*first != '-'
+                    && std::from_chars(first, last, big).ec == std::errc {})
+                {
+                    m_handler.unsigned_integer(big);
+                    return;
+                }
+            }
+
+            double value {};
+            const auto result { std::from_chars(first, last, value) };
+            if (result.ec != std::errc {})
+            {
+                m_pos = start;
+                fail("number out of range");
+            }
+
+            m_handler.floating(value);
+        }
+    };
+}
+
+
+void
+Sink::flush()
+{
+    m_out.write(m_chunk.data(), static_cast<std::streamsize>(m_chunk.size()));
+    m_chunk.clear();
+}
+
+
+void
+JsonWriter::key(std::string_view key)
+{
+    std::size_t object { m_frames.size() };
+    while (m_frames[object - 1].kind == FrameKind::Dotted) object--;
+
+    const auto name_of = [&](std::size_t frame)
+    {
+        const auto begin { m_frames[frame].name };
+        const auto end { frame + 1 < m_frames.size() ? m_frames[frame + 1].name
+                                                     : m_names.size() };
+        return std::string_view { m_names }.substr(begin, end - begin);
+    };
+
+    /* the dotted frames above the object the key still leads through */
+    auto        kept { object };
+    std::size_t start { 0 };
+
+    for (auto dot { key.find('.') };
+         dot != std::string_view::npos && kept < m_frames.size()
+         && name_of(kept) == key.substr(start, dot - start);
+         dot = key.find('.', start))
+    {
+        kept++;
+        start = dot + 1;
+    }
+
+    mf_close_dotted(kept);
+
+    for (auto dot { key.find('.', start) }; dot != std::string_view::npos;
+         dot = key.find('.', start))
+    {
+        const auto segment { key.substr(start, dot - start) };
+
+        mf_member(segment);
+        m_sink.put('{');
+        m_frames.push_back({ .kind  = FrameKind::Dotted,
+                             .first = true,
+                             .name  = m_names.size() });
+        m_names.append(segment);
+
+        start = dot + 1;
+    }
+
+    mf_member(key.substr(start));
+}
+
+
+void
+JsonWriter::begin_object()
+{
+    mf_value();
+    m_sink.put('{');
+    m_frames.push_back({ .kind = FrameKind::Object, .first = true, .name = 0 });
+}
+
+
+void
+JsonWriter::end_object()
+{
+    std::size_t object { m_frames.size() };
+    while (m_frames[object - 1].kind == FrameKind::Dotted) object--;
+
+    mf_close_dotted(object);
+    m_frames.pop_back();
+
+    m_sink.put('}');
+    if (m_frames.empty()) m_sink.put('\n');
+}
+
+
+void
+JsonWriter::begin_array()
+{
+    mf_value();
+    m_sink.put('[');
+    m_frames.push_back({ .kind = FrameKind::Array, .first = true, .name = 0 });
+}
+
+
+void
+JsonWriter::end_array()
+{
+    m_frames.pop_back();
+    m_sink.put(']');
+}
+
+
+void
+JsonWriter::null()
+{
+    mf_value();
+    m_sink.put("null");
+}
+
+
+void
+JsonWriter::integer(types::Signed value)
+{
+    std::array<char, 32> buffer;
+    mf_value();
+    m_sink.put(format(value, buffer));
+}
+
+
+void
+JsonWriter::unsigned_integer(types::Unsigned value)
+{
+    std::array<char, 32> buffer;
+    mf_value();
+    m_sink.put(format(value, buffer));
+}
+
+
+void
+JsonWriter::floating(double value)
+{
+    std::array<char, 32> buffer;
+    mf_value();
+    m_sink.put(format(value, buffer));
+}
+
+
+void
+JsonWriter::boolean(bool value)
+{
+    mf_value();
+    m_sink.put(value ? "true" : "false");
+}
+
+
+void
+JsonWriter::string(std::string_view value)
+{
+    mf_value();
+    mf_string(value);
+}
+
+
+void
+JsonWriter::mf_member(std::string_view name)
+{
+    auto &frame { m_frames.back() };
+    if (!frame.first) m_sink.put(',');
+    frame.first = false;
+
+    mf_string(name);
+    m_sink.put(':');
+}
+
+
+void
+JsonWriter::mf_value()
+{
+    if (m_frames.empty() || m_frames.back().kind != FrameKind::Array) return;
+
+    auto &frame { m_frames.back() };
+    if (!frame.first) m_sink.put(',');
+    frame.first = false;
+}
+
+
+void
+JsonWriter::mf_close_dotted(std::size_t keep)
+{
+    while (m_frames.size() > keep)
+    {
+        m_names.resize(m_frames.back().name);
+        m_frames.pop_back();
+        m_sink.put('}');
+    }
+}
+
+
+void
+JsonWriter::mf_string(std::string_view value)
+{
+    m_sink.put('"');
+
+    std::size_t start { 0 };
+    for (std::size_t i { 0 }; i < value.size(); i++)
+    {
+        const auto c { static_cast<unsigned char>(value[i]) };
+        if (c >= 0x20 && c != '"' && c != '\\') continue;
+
+        m_sink.put(value.substr(start, i - start));
+        start = i + 1;
+
+        switch (c)
+        {
+        case '"':  m_sink.put("\\\""); break;
+        case '\\': m_sink.put("\\\\"); break;
+        case '\n': m_sink.put("\\n"); break;
+        case '\r': m_sink.put("\\r"); break;
+        case '\t': m_sink.put("\\t"); break;
+        default:
+            m_sink.put("\\u00");
+            m_sink.put(Hex[c >> 4]);
+            m_sink.put(Hex[c & 0xF]);
+        }
+    }
+
+    m_sink.put(value.substr(start));
+    m_sink.put('"');
+}
+
+
+void
+KonWriter::key(std::string_view key)
+{
+    if (m_frames.empty() || m_frames.back().kind == FrameKind::Array)
+        throw ValueError { "a key outside of an object" };
+    if (!is_kon_key(key))
+        throw ValueError { "'{}' is not a valid kon key", key };
+
+    auto &frame { m_frames.back() };
+
+    if (frame.kind == FrameKind::Inline)
+    {
+        m_sink.put(frame.first ? " " : "; ");
+        frame.first = false;
+        m_sink.put(key);
+        m_sink.put(':');
+        return;
+    }
+
+    /* the first member of a block ends the line of its key */
+    if (frame.first && frame.level > 0) m_sink.put('\n');
+    frame.first = false;
+
+    for (std::size_t i { 0 }; i < frame.level * IndentWidth; i++)
+        m_sink.put(' ');
+    m_sink.put(key);
+    m_sink.put(':');
+}
+
+
+void
+KonWriter::begin_object()
+{
+    if (m_frames.empty())
+    {
+        m_frames.push_back({ .kind  = FrameKind::Block,
+                             .first = true,
+                             .items = ValueKind::None,
+                             .level = 0 });
+        return;
+    }
+
+    const auto parent { m_frames.back() };
+    mf_begin(ValueKind::Object);
+
+    if (parent.kind == FrameKind::Block)
+    {
+        m_frames.push_back({ .kind  = FrameKind::Block,
+                             .first = true,
+                             .items = ValueKind::None,
+                             .level = parent.level + 1 });
+        return;
+    }
+
+    m_sink.put('{');
+    m_frames.push_back({ .kind  = FrameKind::Inline,
+                         .first = true,
+                         .items = ValueKind::None,
+                         .level = 0 });
+}
+
+
+void
+KonWriter::end_object()
+{
+    const auto frame { m_frames.back() };
+    m_frames.pop_back();
+
+    if (frame.kind == FrameKind::Inline)
+        m_sink.put(frame.first ? "}" : " }");
+    else if (frame.first && frame.level > 0)
+        m_sink.put(" {}\n");
+
+    /* a block's members end their own lines */
+    if (frame.kind == FrameKind::Inline) mf_end();
+}
+
+
+void
+KonWriter::begin_array()
+{
+    mf_begin(ValueKind::Array);
+    m_sink.put('[');
+    m_frames.push_back({ .kind  = FrameKind::Array,
+                         .first = true,
+                         .items = ValueKind::None,
+                         .level = 0 });
+}
+
+
+void
+KonWriter::end_array()
+{
+    const auto frame { m_frames.back() };
+    m_frames.pop_back();
+
+    m_sink.put(frame.first ? "]" : " ]");
+    mf_end();
+}
+
+
+void
+KonWriter::null()
+{
+    mf_begin(ValueKind::Null);
+    m_sink.put("null");
+    mf_end();
+}
+
+
+void
+KonWriter::integer(types::Signed value)
+{
+    std::array<char, 32> buffer;
+    mf_begin(ValueKind::Integer);
+    m_sink.put(format(value, buffer));
+    mf_end();
+}
+
+
+void
+KonWriter::unsigned_integer(types::Unsigned value)
+{
+    std::array<char, 32> buffer;
+    mf_begin(ValueKind::Integer);
+    m_sink.put(format(value, buffer));
+    mf_end();
+}
+
+
+void
+KonWriter::floating(double value)
+{
+    std::array<char, 32> buffer;
+    mf_begin(ValueKind::Float);
+
+    /* a float without a dot or an exponent would be read as an integer */
+    const auto text { format(value, buffer) };
+    m_sink.put(text);
+    if (text.find_first_of(".e") == std::string_view::npos) m_sink.put(".0");
+
+    mf_end();
+}
+
+
+void
+KonWriter::boolean(bool value)
+{
+    mf_begin(ValueKind::Boolean);
+    m_sink.put(value ? "true" : "false");
+    mf_end();
+}
+
+
+void
+KonWriter::string(std::string_view value)
+{
+    mf_begin(ValueKind::String);
+    mf_string(value);
+    mf_end();
+}
+
+
+void
+KonWriter::mf_begin(ValueKind kind)
+{
+    if (m_frames.empty())
+        throw ValueError { "a kon document must be an object" };
+
+    auto &frame { m_frames.back() };
+
+    if (frame.kind == FrameKind::Array)
+    {
+        if (frame.items == ValueKind::None)
+            frame.items = kind;
+        else if (frame.items != kind)
+            throw ValueError { "arrays must contain a single data type" };
+
+        m_sink.put(frame.first ? " " : ", ");
+        frame.first = false;
+        return;
+    }
+
+    if (kind != ValueKind::Object || frame.kind == FrameKind::Inline)
+        m_sink.put(' ');
+}
+
+
+void
+KonWriter::mf_end()
+{
+    if (!m_frames.empty() && m_frames.back().kind == FrameKind::Block)
+        m_sink.put('\n');
+}
+
+
+void
+KonWriter::mf_string(std::string_view value)
+{
+    m_sink.put('"');
+
+    std::size_t start { 0 };
+    for (std::size_t i { 0 }; i < value.size(); i++)
+    {
+        const auto c { value[i] };
+        if (c != '"' && c != '\\' && c != '\n' && c != '\r' && c != '\t')
+            continue;
+
+        m_sink.put(value.substr(start, i - start));
+        start = i + 1;
+
+        switch (c)
+        {
+        case '"':  m_sink.put("\\\""); break;
+        case '\\': m_sink.put("\\\\"); break;
+        case '\n': m_sink.put("\\n"); break;
+        case '\r': m_sink.put("\\r"); break;
+        default:   m_sink.put("\\t"); break;
+        }
+    }
+
+    m_sink.put(value.substr(start));
+    m_sink.put('"');
+}
+
+
+void
+koncpp::parse_json(std::string_view source, Handler &handler)
+{
+    koncpp::trace::Span span { "parse_json" };
+    span.arg("bytes", static_cast<std::int64_t>(source.size()));
+
+    Reader reader { source, handler };
+
+    try
+    {
+        reader.document();
+    }
+    catch (const ValueError &e)
+    {
+        throw JsonError { e.what(), reader.position() };
+    }
+}
+
+
+void
+koncpp::kon_to_json(std::string_view source, std::ostream &out)
+{
+    JsonWriter writer { out };
+    Parser {}.parse(source, writer);
+    writer.flush();
+}
+
+
+void
+koncpp::json_to_kon(std::string_view source, std::ostream &out)
+{
+    KonWriter writer { out };
+    parse_json(source, writer);
+    writer.flush();
+}
@@ -0,0 +1,687 @@
+/**
+ * @file loader.cc
+ * @copyright Copyright (C) 2025-2026 Kei <RQuarx@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include "koncpp/loader.hh"
+#include "koncpp/trace.hh"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
+
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+using koncpp::LoadError;
+using koncpp::LoadMethod;
+using koncpp::LoadOptions;
+using koncpp::detail::Consumer;
+
+
+namespace
+{
+    using Files  = std::span<const std::filesystem::path>;
+    using Errors = std::vector<std::exception_ptr>;
+
+
+    auto
+    thread_count(const LoadOptions &options) -> std::size_t
+    {
+        if (options.threads > 0) return options.threads;
+        return std::max(1U, std::thread::hardware_concurrency());
+    }
+
+
+    auto
+    read_error(const std::filesystem::path &path, int error)
+        -> std::exception_ptr
+    {
+        return std::make_exception_ptr(LoadError {
+            "cannot read '{}': {}", path.string(), std::strerror(error) });
+    }
+
+
+    /* Reads @p path in the calling thread. */
+    auto
+    read_file(const std::filesystem::path &path) -> std::string
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        const auto fd { ::open(path.c_str(), O_RDONLY | O_CLOEXEC) };
+        if (fd < 0) std::rethrow_exception(read_error(path, errno));
+
+        struct stat info {};
+        std::string contents;
+        auto        error { 0 };
+
+        if (::fstat(fd, &info) != 0)
+            error = errno;
+        else
+        {
+            contents.resize(static_cast<std::size_t>(info.st_size));
+
+            std::size_t done { 0 };
+            while (done < contents.size())
+            {
+                const auto count { ::pread(fd, contents.data() + done,
+                                           contents.size() - done,
+                                           static_cast<off_t>(done)) };
+                if (count < 0 && errno == EINTR) continue;
+                if (count < 0) error = errno;
+                if (count <= 0) break;
+                done += static_cast<std::size_t>(count);
+            }
+
+            /* the file shrank while it was read */
+            contents.resize(done);
+        }
+
+        ::close(fd);
+        if (error != 0) std::rethrow_exception(read_error(path, error));
+        return contents;
+#else
+        std::ifstream in { path, std::ios::binary };
+        if (!in)
+            throw LoadError { "cannot read '{}'", path.string() };
+        return { std::istreambuf_iterator<char> { in }, {} };
+#endif
+    }
+
+
+    /* Parsing threads, fed with the contents of files as they are read. */
+    class Workers
+    {
+    public:
+        Workers(std::size_t count, const Consumer &consume, Errors &errors)
+            : m_consume(consume), m_errors(errors)
+        {
+            for (std::size_t i { 0 }; i < count; i++)
+                m_threads.emplace_back([this] { mf_run(); });
+        }
+
+        ~Workers()
+        {
+            finish();
+        }
+
+        Workers(const Workers &)                     = delete;
+        auto operator=(const Workers &) -> Workers & = delete;
+
+
+        void
+        push(std::size_t index, std::string contents)
+        {
+            {
+                std::scoped_lock lock { m_mutex };
+                m_jobs.emplace_back(index, std::move(contents));
+            }
+            m_ready.notify_one();
+        }
+
+
+        /* Waits for the files pushed so far to be consumed. */
+        void
+        finish()
+        {
+            {
+                std::scoped_lock lock { m_mutex };
+                m_closed = true;
+            }
+            m_ready.notify_all();
+
+            for (auto &thread : m_threads)
+                if (thread.joinable()) thread.join();
+        }
+
+
+    private:
+        const Consumer &m_consume;
+        Errors         &m_errors;
+
+        std::mutex                                     m_mutex;
+        std::condition_variable                        m_ready;
+        std::deque<std::pair<std::size_t, std::string>> m_jobs;
+        bool                                           m_closed {};
+        std::vector<std::thread>                       m_threads;
+
+
+        void
+        mf_run()
+        {
+            while (true)
+            {
+                std::unique_lock lock { m_mutex };
+                m_ready.wait(lock,
+                             [this] { return m_closed || !m_jobs.empty(); });
+                if (m_jobs.empty()) return;
+
+                auto [index, contents] { std::move(m_jobs.front()) };
+                m_jobs.pop_front();
+                lock.unlock();
+
+                try
+                {
+                    m_consume(index, contents);
+                }
+                catch (...)
+                {
+                    m_errors[index] = std::current_exception();
+                }
+            }
+        }
+    };
+
+
+    /* Every thread reads the next file and parses it. */
+    void
+    load_threads(Files              files,
+                 const LoadOptions &options,
+                 const Consumer    &consume,
+                 Errors            &errors)
+    {
+        std::atomic<std::size_t> next {};
+
+        const auto run = [&]
+        {
+            for (auto index { next++ }; index < files.size(); index = next++)
+            {
+                try
+                {
+                    const auto contents { read_file(files[index]) };
+                    consume(index, contents);
+                }
+                catch (...)
+                {
+                    errors[index] = std::current_exception();
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        const auto count { std::min(thread_count(options), files.size()) };
+        for (std::size_t i { 1 }; i < count; i++) threads.emplace_back(run);
+
+        run();
+        for (auto &thread : threads) thread.join();
+    }
+
+
+#ifdef __linux__
+    /* A submission and a completion queue shared with the kernel. */
+    class Ring
+    {
+    public:
+        /**
+         * @throws LoadError if io_uring is not available, or cannot open
+         *         and read files.
+         */
+        explicit Ring(unsigned entries)
+        {
+            io_uring_params params {};
+
+            m_fd = static_cast<int>(
+                ::syscall(__NR_io_uring_setup, entries, &params));
+            if (m_fd < 0)
+                throw LoadError { "io_uring_setup: {}", std::strerror(errno) };
+
+            try
+            {
+                mf_map(params);
+                mf_probe();
+            }
+            catch (...)
+            {
+                mf_release();
+                throw;
+            }
+        }
+
+        ~Ring()
+        {
+            mf_release();
+        }
+
+        Ring(const Ring &)                     = delete;
+        auto operator=(const Ring &) -> Ring & = delete;
+
+
+        /* Returns a cleared entry to submit, there must be room for it. */
+        auto
+        next() noexcept -> io_uring_sqe &
+        {
+            const auto tail { *m_sq_tail };
+            const auto index { tail & *m_sq_mask };
+
+            auto &sqe { m_sqes[index] };
+            std::memset(&sqe, 0, sizeof(sqe));
+
+            m_sq_array[index] = index;
+            std::atomic_ref { *m_sq_tail }.store(tail + 1,
+                                                 std::memory_order_release);
+            m_pending++;
+            return sqe;
+        }
+
+
+        /*
+         * Submits the new entries and waits for a completion. The kernel
+         * may take fewer entries than it was given, the rest are submitted
+         * again.
+         */
+        void
+        submit()
+        {
+            while (m_pending > 0)
+            {
+                const auto count { ::syscall(__NR_io_uring_enter, m_fd,
+                                             m_pending, 1,
+                                             IORING_ENTER_GETEVENTS, nullptr,
+                                             0) };
+                if (count < 0 && errno == EINTR) continue;
+                if (count < 0)
+                    throw LoadError { "io_uring_enter: {}",
+                                      std::strerror(errno) };
+                if (count == 0)
+                    throw LoadError { "io_uring_enter: nothing submitted" };
+
+                m_pending   -= static_cast<unsigned>(count);
+                m_submitted += static_cast<std::size_t>(count);
+            }
+        }
+
+
+        template <typename T_Func>
+        void
+        reap(T_Func func)
+        {
+            auto       head { *m_cq_head };
+            const auto tail { std::atomic_ref { *m_cq_tail }.load(
+                std::memory_order_acquire) };
+
+            for (; head != tail; head++)
+            {
+                const auto &cqe { m_cqes[head & *m_cq_mask] };
+                const auto  data { cqe.user_data };
+                const auto  result { cqe.res };
+
+                std::atomic_ref { *m_cq_head }.store(head + 1,
+                                                     std::memory_order_release);
+                m_submitted--;
+                func(data, result);
+            }
+        }
+
+
+        /*
+         * Waits for every submitted entry to complete, passing each one to
+         * @p func , so that the kernel no longer uses their buffers. Entries
+         * that were never submitted are dropped.
+         */
+        template <typename T_Func>
+        void
+        drain(T_Func func) noexcept
+        {
+            reap(func);
+
+            while (m_submitted > 0)
+            {
+                if (::syscall(__NR_io_uring_enter, m_fd, 0, 1,
+                              IORING_ENTER_GETEVENTS, nullptr, 0)
+                        < 0
+                    && errno != EINTR)
+                    /* the buffers could still be written into if freed */
+                    std::terminate();
+
+                reap(func);
+            }
+        }
+
+
+    private:
+        int           m_fd { -1 };
+        void         *m_sq {};
+        void         *m_cq {};
+        io_uring_sqe *m_sqes {};
+        std::size_t   m_sq_size {};
+        std::size_t   m_cq_size {};
+        std::size_t   m_sqes_size {};
+        unsigned      m_pending {};   /* entries not submitted yet */
+        std::size_t   m_submitted {}; /* and not completed yet */
+
+        unsigned     *m_sq_tail {};
+        unsigned     *m_sq_mask {};
+        unsigned     *m_sq_array {};
+        unsigned     *m_cq_head {};
+        unsigned     *m_cq_tail {};
+        unsigned     *m_cq_mask {};
+        io_uring_cqe *m_cqes {};
+
+
+        static auto
+        map(std::size_t size, int fd, off_t offset) -> void *
+        {
+            auto *ptr { ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                               MAP_SHARED | MAP_POPULATE, fd, offset) };
+            if (ptr == MAP_FAILED)
+                throw LoadError { "io_uring mmap: {}", std::strerror(errno) };
+            return ptr;
+        }
+
+
+        void
+        mf_map(const io_uring_params &params)
+        {
+            m_sq_size = params.sq_off.array
+                      + params.sq_entries * sizeof(unsigned);
+            m_cq_size = params.cq_off.cqes
+                      + params.cq_entries * sizeof(io_uring_cqe);
+
+            if ((params.features & IORING_FEAT_SINGLE_MMAP) != 0)
+                m_sq_size = m_cq_size = std::max(m_sq_size, m_cq_size);
+
+            m_sq = map(m_sq_size, m_fd, IORING_OFF_SQ_RING);
+            m_cq = (params.features & IORING_FEAT_SINGLE_MMAP) != 0
+                     ? m_sq
+                     : map(m_cq_size, m_fd, IORING_OFF_CQ_RING);
+
+            m_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+            m_sqes      = static_cast<io_uring_sqe *>(
+                map(m_sqes_size, m_fd, IORING_OFF_SQES));
+
+            auto *sq { static_cast<char *>(m_sq) };
+            auto *cq { static_cast<char *>(m_cq) };
+
+            const auto field = [](char *ring, std::uint32_t offset)
+            { return reinterpret_cast<unsigned *>(ring + offset); };
+
+            m_sq_tail  = field(sq, params.sq_off.tail);
+            m_sq_mask  = field(sq, params.sq_off.ring_mask);
+            m_sq_array = field(sq, params.sq_off.array);
+            m_cq_head  = field(cq, params.cq_off.head);
+            m_cq_tail  = field(cq, params.cq_off.tail);
+            m_cq_mask  = field(cq, params.cq_off.ring_mask);
+            m_cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+        }
+
+
+        void
+        mf_release() noexcept
+        {
+            if (m_sqes != nullptr) ::munmap(m_sqes, m_sqes_size);
+            if (m_cq != nullptr && m_cq != m_sq) ::munmap(m_cq, m_cq_size);
+            if (m_sq != nullptr) ::munmap(m_sq, m_sq_size);
+            if (m_fd >= 0) ::close(m_fd);
+
+            m_sqes = nullptr;
+            m_cq   = nullptr;
+            m_sq   = nullptr;
+            m_fd   = -1;
+        }
+
+
+        /* Opening and reading files came after io_uring itself. */
+        void
+        mf_probe()
+        {
+            constexpr std::size_t Ops { 256 };
+
+            std::vector<char> buffer(sizeof(io_uring_probe)
+                                     + Ops * sizeof(io_uring_probe_op));
+            auto *probe { reinterpret_cast<io_uring_probe *>(buffer.data()) };
+
+            if (::syscall(__NR_io_uring_register, m_fd, IORING_REGISTER_PROBE,
+                          probe, Ops)
+                < 0)
+                throw LoadError { "io_uring probe: {}", std::strerror(errno) };
+
+            for (const auto op : { IORING_OP_OPENAT, IORING_OP_READ })
+                if (op >= probe->ops_len
+                    || (probe->ops[op].flags & IO_URING_OP_SUPPORTED) == 0)
+                    throw LoadError { "io_uring cannot open and read files" };
+        }
+    };
+
+
+    constexpr std::size_t MaxBatch { 4096 };
+
+
+    /* The stage of a file's operation, in the low bit of its user data. */
+    enum Stage : std::uint64_t
+    {
+        Open,
+        Read
+    };
+
+
+    /*
+     * Opens and reads up to @c options.batch files at a time through
+     * @p ring , from this thread, and hands each one to the workers once it
+     * is read.
+     */
+    void
+    load_ring(Ring              &ring,
+              Files              files,
+              const LoadOptions &options,
+              const Consumer    &consume,
+              Errors            &errors)
+    {
+        struct File
+        {
+            int         fd { -1 };
+            std::string contents;
+            std::size_t done {};
+        };
+
+        std::vector<File> state(files.size());
+        Workers           workers { thread_count(options), consume, errors };
+
+        const auto read = [&](std::size_t index)
+        {
+            auto &file { state[index] };
+            auto &sqe { ring.next() };
+
+            sqe.opcode    = IORING_OP_READ;
+            sqe.fd        = file.fd;
+            sqe.addr      = reinterpret_cast<std::uint64_t>(
+                file.contents.data() + file.done);
+            sqe.len       = static_cast<std::uint32_t>(std::min<std::size_t>(
+                file.contents.size() - file.done, 1 << 30));
+            sqe.off       = file.done;
+            sqe.user_data = (index << 1) | Read;
+        };
+
+        const auto done = [&](std::size_t index, int error)
+        {
+            auto &file { state[index] };
+            if (file.fd >= 0) ::close(file.fd);
+            file.fd = -1;
+
+            if (error != 0)
+                errors[index] = read_error(files[index], error);
+            else
+                workers.push(index, std::move(file.contents));
+        };
+
+        std::size_t next { 0 };
+        std::size_t in_flight { 0 };
+
+        const auto complete = [&](std::uint64_t data, int result)
+        {
+            const auto index { static_cast<std::size_t>(data >> 1) };
+            auto      &file { state[index] };
+
+            if (result < 0)
+            {
+                done(index, -result);
+                in_flight--;
+                return;
+            }
+
+            if ((data & 1) == Open)
+            {
+                file.fd = result;
+
+                struct stat info {};
+                if (::fstat(file.fd, &info) != 0)
+                {
+                    done(index, errno);
+                    in_flight--;
+                    return;
+                }
+                file.contents.resize(static_cast<std::size_t>(info.st_size));
+            }
+            else
+            {
+                file.done += static_cast<std::size_t>(result);
+
+                /* the file shrank while it was read */
+                if (result == 0) file.contents.resize(file.done);
+            }
+
+            if (file.done < file.contents.size())
+                read(index);
+            else
+            {
+                done(index, 0);
+                in_flight--;
+            }
+        };
+
+        const auto batch { std::clamp<std::size_t>(options.batch, 1,
+                                                   MaxBatch) };
+
+        try
+        {
+            while (next < files.size() || in_flight > 0)
+            {
+                for (; in_flight < batch && next < files.size(); next++)
+                {
+                    in_flight++;
+
+                    auto &sqe { ring.next() };
+                    sqe.opcode     = IORING_OP_OPENAT;
+                    sqe.fd         = AT_FDCWD;
+                    sqe.addr       = reinterpret_cast<std::uint64_t>(
+                        files[next].c_str());
+                    sqe.open_flags = O_RDONLY | O_CLOEXEC;
+                    sqe.user_data  = (next << 1) | Open;
+                }
+
+                ring.submit();
+                ring.reap(complete);
+            }
+        }
+        catch (...)
+        {
+            /* the kernel may still be reading into the files' contents */
+            ring.drain(
+                [](std::uint64_t data, int result)
+                {
+                    if ((data & 1) == Open && result >= 0) ::close(result);
+                });
+
+            for (const auto &file : state)
+                if (file.fd >= 0) ::close(file.fd);
+            throw;
+        }
+
+        workers.finish();
+    }
+#endif
+}
+
+
+auto
+koncpp::detail::list_files(const std::filesystem::path &directory,
+                           std::string_view             extension)
+    -> std::vector<std::filesystem::path>
+{
+    std::vector<std::filesystem::path> files;
+    std::error_code                    error;
+
+    for (std::filesystem::directory_iterator it { directory, error }, end;
+         !error && it != end; it.increment(error))
+        if (it->is_regular_file(error) && it->path().extension() == extension)
+            files.push_back(it->path());
+
+    if (error)
+        throw LoadError { "cannot list '{}': {}", directory.string(),
+                          error.message() };
+
+    std::ranges::sort(files);
+    return files;
+}
+
+
+auto
+koncpp::detail::load_files(std::span<const std::filesystem::path> files,
+                           const LoadOptions &options,
+                           const Consumer    &consume) -> LoadMethod
+{
+    trace::Span span { "load_files" };
+    span.arg("files", static_cast<std::int64_t>(files.size()));
+
+    Errors errors(files.size());
+    auto   method { LoadMethod::Threads };
+
+#ifdef __linux__
+    if (options.method != LoadMethod::Threads && !files.empty())
+    {
+        try
+        {
+            Ring ring { std::bit_ceil(static_cast<unsigned>(
+                std::clamp<std::size_t>(options.batch, 1, MaxBatch))) };
+
+            method = LoadMethod::IoUring;
+            load_ring(ring, files, options, consume, errors);
+        }
+        catch (const LoadError &)
+        {
+            if (options.method == LoadMethod::IoUring
+                || method == LoadMethod::IoUring)
+                throw;
+        }
+    }
+#else
+    if (options.method == LoadMethod::IoUring)
+        throw LoadError { "io_uring is only available on Linux" };
+#endif
+
+    if (method == LoadMethod::Threads)
+        load_threads(files, options, consume, errors);
+
+    for (const auto &error : errors)
+        if (error) std::rethrow_exception(error);
+
+    return method;
+}
@@ -0,0 +1,114 @@
+/**
+ * @file location.cc
+ * @copyright Copyright (C) 2025-2026 Kei <RQuarx@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "koncpp/location.hh"
+
+using koncpp::LineIndex;
+using koncpp::Location;
+
+
+namespace
+{
+    /* Calls @p func with the offset of every new line in @p text . */
+    template <typename T_Func>
+    void
+    for_each_newline(std::string_view text, T_Func func)
+    {
+        const auto *begin { text.data() };
+        const auto *end { begin + text.size() };
+
+        for (const auto *it { begin }; it < end; it++)
+        {
+            it = static_cast<const char *>(
+                std::memchr(it, '\n', static_cast<std::size_t>(end - it)));
+            if (it == nullptr) return;
+            func(static_cast<std::size_t>(it - begin));
+        }
+    }
+
+
+    /* UTF-8 continuation bytes do not start a new column. */
+    auto
+    column(std::string_view line) noexcept -> std::size_t
+    {
+        return 1
+             + static_cast<std::size_t>(std::ranges::count_if(
+                 line,
+                 [](char c)
+                 { return (static_cast<unsigned char>(c) & 0xC0) != 0x80; }));
+    }
+}
+
+
+LineIndex::LineIndex(std::string_view source) : m_source(source)
+{
+    m_starts.push_back(0);
+    for_each_newline(source,
+                     [this](std::size_t offset)
+                     { m_starts.push_back(offset + 1); });
+}
+
+
+auto
+LineIndex::locate(std::size_t offset) const noexcept -> Location
+{
+    offset = std::min(offset, m_source.size());
+
+    /* the last line starting at or before the offset */
+    const auto it { std::ranges::upper_bound(m_starts, offset) - 1 };
+    const auto start { *it };
+
+    return { .line   = static_cast<std::size_t>(it - m_starts.begin()) + 1,
+             .column = column(m_source.substr(start, offset - start)) };
+}
+
+
+auto
+LineIndex::line(std::size_t number) const noexcept -> std::string_view
+{
+    if (number == 0 || number > m_starts.size()) return {};
+
+    const auto start { m_starts[number - 1] };
+    const auto end { number < m_starts.size() ? m_starts[number] - 1
+                                              : m_source.size() };
+    return m_source.substr(start, end - start);
+}
+
+
+auto
+koncpp::locate(std::string_view source, std::size_t offset) noexcept
+    -> Location
+{
+    const auto prefix { source.substr(0, std::min(offset, source.size())) };
+
+    Location    result;
+    std::size_t start { 0 };
+
+    for_each_newline(prefix,
+                     [&](std::size_t newline)
+                     {
+                         result.line++;
+                         start = newline + 1;
+                     });
+
+    result.column = column(prefix.substr(start));
+    return result;
+}
@@ -0,0 +1,127 @@
+/**
+ * @file memory.cc
+ * @copyright Copyright (C) 2025-2026 Kei <RQuarx@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "koncpp/memory.hh"
+
+using koncpp::Arena;
+using koncpp::MemoryAccount;
+
+
+namespace
+{
+    /* Kept in the library so that every module sees the same account. */
+    thread_local MemoryAccount *current_account {};
+    thread_local Arena         *current_arena {};
+}
+
+
+auto
+MemoryAccount::current() noexcept -> MemoryAccount *
+{
+    return current_account;
+}
+
+
+void
+MemoryAccount::mf_set_current(MemoryAccount *account) noexcept
+{
+    current_account = account;
+}
+
+
+auto
+Arena::current() noexcept -> Arena *
+{
+    return current_arena;
+}
+
+
+void
+Arena::mf_set_current(Arena *arena) noexcept
+{
+    current_arena = arena;
+}
+
+
+Arena::~Arena()
+{
+    mf_release(0);
+}
+
+
+void
+Arena::reset() noexcept
+{
+    m_high_water = high_water();
+    m_current    = 0;
+    m_offset     = 0;
+    m_used       = 0;
+
+    std::size_t keep { 0 };
+    std::size_t kept { 0 };
+    while (keep < m_blocks.size()
+           && kept + m_blocks[keep].size <= m_retain_limit)
+        kept += m_blocks[keep++].size;
+
+    mf_release(keep);
+}
+
+
+void
+Arena::shrink_to_fit() noexcept
+{
+    mf_release(m_used == 0 ? 0 : m_current + 1);
+}
+
+
+auto
+Arena::mf_grow(std::size_t size, std::size_t alignment) -> void *
+{
+    /* enough for any padding the block's start needs */
+    const auto needed { size + alignment - 1 };
+
+    /* the blocks after the current one are unused since the last reset */
+    auto index { m_blocks.empty() || m_offset == 0 ? m_current
+                                                   : m_current + 1 };
+    while (index < m_blocks.size() && m_blocks[index].size < needed) index++;
+
+    if (index == m_blocks.size())
+    {
+        const auto block_size { std::max(BlockSize, needed) };
+        m_blocks.push_back(
+            { static_cast<char *>(::operator new(block_size)), block_size });
+        m_capacity += block_size;
+    }
+
+    m_current = index;
+    m_offset  = 0;
+    return allocate(size, alignment);
+}
+
+
+void
+Arena::mf_release(std::size_t keep) noexcept
+{
+    for (auto i { keep }; i < m_blocks.size(); i++)
+    {
+        ::operator delete(m_blocks[i].data);
+        m_capacity -= m_blocks[i].size;
+    }
+
+    m_blocks.resize(std::min(keep, m_blocks.size()));
+}
@@ -0,0 +1,1557 @@
+/**
+ * @file parser.cc
+ * @copyright Copyright (C) 2025-2026 Kei <RQuarx@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <optional>
+
+#include "koncpp/parser.hh"
+#include "koncpp/trace.hh"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+using koncpp::Error;
+using koncpp::ErrorCode;
+using koncpp::Handler;
+using koncpp::MaxDepth;
+using koncpp::MemberRange;
+using koncpp::ParseError;
+using koncpp::Parser;
+using koncpp::ParseStats;
+using koncpp::Path;
+using koncpp::ValueError;
+using koncpp::detail::Indentation;
+using koncpp::detail::ParseMode;
+
+namespace types = koncpp::types;
+
+
+/* What a parse reports, every member by default. */
+struct koncpp::detail::ParseMode
+{
+    /* only the members on the way to, or inside, these paths */
+    std::span<const Path> paths {};
+    bool                  project {};
+
+    /* or only the ranges of the members down to this depth */
+    std::vector<MemberRange> *outline {};
+    std::size_t               depth {};
+};
+
+
+namespace
+{
+    /*
+     * Returns the offset of the first '*' followed by a '/' at or after
+     * @p pos , the end of a block comment.
+     *
+     * Block comments often hold license headers full of '*', which would
+     * stop a search for the first character at every line. Both characters
+     * are compared at once instead, 16 bytes at a time where SSE2 is
+     * available, and by searching for the '/' with memchr otherwise.
+     */
+    auto
+    find_comment_end(std::string_view text, std::size_t pos) noexcept
+        -> std::size_t
+    {
+        const auto *data { text.data() };
+        const auto  size { text.size() };
+
+#ifdef __SSE2__
+        const auto star { _mm_set1_epi8('*') };
+        const auto slash { _mm_set1_epi8('/') };
+
+        /* the second load reads one byte ahead */
+        for (; pos + 17 <= size; pos += 16)
+        {
+            const auto first { _mm_loadu_si128(
+                reinterpret_cast<const __m128i *>(data + pos)) };
+            const auto second { _mm_loadu_si128(
+                reinterpret_cast<const __m128i *>(data + pos + 1)) };
+
+            const auto mask { static_cast<unsigned>(_mm_movemask_epi8(
+                _mm_and_si128(_mm_cmpeq_epi8(first, star),
+                              _mm_cmpeq_epi8(second, slash)))) };
+
+            if (mask != 0) return pos + std::countr_zero(mask);
+        }
+#endif
+
+        while (pos + 1 < size)
+        {
+            const auto *found { static_cast<const char *>(
+                std::memchr(data + pos + 1, '/', size - pos - 1)) };
+            if (found == nullptr) break;
+
+            const auto offset { static_cast<std::size_t>(found - data) };
+            if (found[-1] == '*') return offset - 1;
+            pos = offset;
+        }
+
+        return std::string_view::npos;
+    }
+
+
+    /* The new lines, spaces and tabs of a block of at most 64 bytes. */
+    struct Masks
+    {
+        std::uint64_t newline {};
+        std::uint64_t space {};
+        std::uint64_t tab {};
+    };
+
+
+    auto
+    classify(const char *data, std::size_t size) noexcept -> Masks
+    {
+        Masks masks;
+
+#ifdef __SSE2__
+        if (size == 64)
+        {
+            const auto newline { _mm_set1_epi8('\n') };
+            const auto space { _mm_set1_epi8(' ') };
+            const auto tab { _mm_set1_epi8('\t') };
+
+            for (std::size_t i { 0 }; i < 64; i += 16)
+            {
+                const auto bytes { _mm_loadu_si128(
+                    reinterpret_cast<const __m128i *>(data + i)) };
+
+                const auto bits = [&](__m128i c)
+                {
+                    return static_cast<std::uint64_t>(static_cast<unsigned>(
+                               _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, c))))
+                        << i;
+                };
+
+                masks.newline |= bits(newline);
+                masks.space |= bits(space);
+                masks.tab |= bits(tab);
+            }
+
+            return masks;
+        }
+#endif
+
+        for (std::size_t i { 0 }; i < size; i++)
+        {
+            const auto bit { std::uint64_t { 1 } << i };
+
+            if (data[i] == '\n')
+                masks.newline |= bit;
+            else if (data[i] == ' ')
+                masks.space |= bit;
+            else if (data[i] == '\t')
+                masks.tab |= bit;
+        }
+
+        return masks;
+    }
+
+
+    /*
+     * Fills @p lines with the indentation of every line of @p text from
+     * @p first on, SYNTAX.md §2.7.
+     *
+     * The text is classified 64 bytes at a time, and the whitespace after
+     * each new line is measured by counting bits, so deeply nested
+     * documents do not have their indentation scanned byte by byte. A run
+     * of whitespace that reaches the end of a block continues in the next.
+     */
+    void
+    measure_indentation(std::string_view          text,
+                        std::size_t               first,
+                        std::size_t               tab_width,
+                        std::vector<Indentation> &lines)
+    {
+        lines.clear();
+
+        Indentation line { first, first, 0 };
+        std::size_t tabs { 0 };
+        bool        open { true };
+
+        const auto close = [&]
+        {
+            const auto bytes { line.end - line.start };
+            line.width = bytes - tabs + tabs * tab_width;
+            lines.push_back(line);
+            open = false;
+        };
+
+        for (auto base { first }; base < text.size(); base += 64)
+        {
+            const auto size { std::min<std::size_t>(64, text.size() - base) };
+            const auto masks { classify(text.data() + base, size) };
+            const auto blank { masks.space | masks.tab };
+
+            auto        newlines { masks.newline };
+            std::size_t from { 0 };
+
+            while (true)
+            {
+                if (open && from < 64)
+                {
+                    const auto run { static_cast<std::size_t>(
+                        std::countr_one(blank >> from)) };
+                    const auto tab { masks.tab >> from };
+
+                    line.end += run;
+                    if (from + run < 64)
+                    {
+                        tabs += static_cast<std::size_t>(std::popcount(
+                            tab & ((std::uint64_t { 1 } << run) - 1)));
+                        close();
+                    }
+                    else
+                        tabs += static_cast<std::size_t>(std::popcount(tab));
+                }
+
+                if (newlines == 0) break;
+
+                from = static_cast<std::size_t>(std::countr_zero(newlines))
+                     + 1;
+                newlines &= newlines - 1;
+
+                line = { base + from, base + from, 0 };
+                tabs = 0;
+                open = true;
+            }
+        }
+
+        if (open) close();
+    }
+
+
+    /* Receives the events of an outline, which are only the root's. */
+    class Ignore : public Handler
+    {
+    public:
+        void key(std::string_view) override {}
+        void begin_object() override {}
+        void end_object() override {}
+        void begin_array() override {}
+        void end_array() override {}
+        void null() override {}
+        void integer(types::Signed) override {}
+        void unsigned_integer(types::Unsigned) override {}
+        void floating(double) override {}
+        void boolean(bool) override {}
+        void string(std::string_view) override {}
+    };
+
+
+    /* What a projected parse does with a member, see match(). */
+    enum class Match : std::uint8_t
+    {
+        Skip,
+        Descend, /* its value may hold a requested path */
+        Keep     /* it is inside a requested path */
+    };
+
+
+    /* The kind of a value, used to keep arrays single-typed. */
+    enum class Kind : std::uint8_t
+    {
+        None,
+        Null,
+        Integer,
+        Float,
+        Boolean,
+        String,
+        Array,
+        Object
+    };
+
+
+    constexpr auto
+    is_space(char c) noexcept -> bool
+    {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+
+    constexpr auto
+    is_alpha(char c) noexcept -> bool
+    {
+        return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+    }
+
+
+    constexpr auto
+    is_digit(char c) noexcept -> bool
+    {
+        return c >= '0' && c <= '9';
+    }
+
+
+    /* SYNTAX.md §5 */
+    constexpr auto
+    is_identifier(char c) noexcept -> bool
+    {
+        switch (c)
+        {
+        case '.':
+        case ':':
+        case '{':
+        case '}':
+        case '[':
+        case ']':
+        case '/':
+        case '*':
+        case '"':
+        case ';':
+        case ',':
+        case ' ':
+        case '\t':
+        case '\r':
+        case '\n': return false;
+        default:   return true;
+        }
+    }
+
+
+#ifdef KONCPP_STATS
+    /* Forwards every event, counting it as a token and timing the call. */
+    class TimedHandler : public Handler
+    {
+    public:
+        TimedHandler(Handler &handler, ParseStats &stats)
+            : m_handler(handler), m_stats(stats)
+        {
+        }
+
+
+        void
+        key(std::string_view key) override
+        {
+            mf_forward(&Handler::key, key);
+        }
+
+
+        void
+        begin_object() override
+        {
+            mf_forward(&Handler::begin_object);
+        }
+
+
+        void
+        end_object() override
+        {
+            mf_forward(&Handler::end_object);
+        }
+
+
+        void
+        begin_array() override
+        {
+            mf_forward(&Handler::begin_array);
+        }
+
+
+        void
+        end_array() override
+        {
+            mf_forward(&Handler::end_array);
+        }
+
+
+        void
+        null() override
+        {
+            mf_forward(&Handler::null);
+        }
+
+
+        void
+        integer(types::Signed value) override
+        {
+            mf_forward(&Handler::integer, value);
+        }
+
+
+        void
+        unsigned_integer(types::Unsigned value) override
+        {
+            mf_forward(&Handler::unsigned_integer, value);
+        }
+
+
+        void
+        floating(double value) override
+        {
+            mf_forward(&Handler::floating, value);
+        }
+
+
+        void
+        boolean(bool value) override
+        {
+            mf_forward(&Handler::boolean, value);
+        }
+
+
+        void
+        string(std::string_view value) override
+        {
+            mf_forward(&Handler::string, value);
+        }
+
+
+    private:
+        Handler    &m_handler;
+        ParseStats &m_stats;
+
+
+        template <typename... T_Args>
+        void
+        mf_forward(void (Handler::*event)(T_Args...), T_Args... args)
+        {
+            m_stats.tokens++;
+            KONCPP_STATS_TIME(m_stats, build);
+            (m_handler.*event)(args...);
+        }
+    };
+#endif
+
+
+    class State
+    {
+    public:
+        State(std::string_view          source,
+              Handler                  &handler,
+              std::string              &buffer,
+              std::vector<Indentation> &lines,
+              std::size_t               tab_width,
+              const ParseMode          &mode,
+              ParseStats               &stats)
+            : m_src(source), m_handler(handler), m_buffer(buffer),
+              m_lines(lines), m_tab_width(tab_width), m_paths(mode.paths),
+              m_outline(mode.outline), m_depth(mode.depth), m_stats(stats)
+        {
+            if (m_src.starts_with("\xEF\xBB\xBF")) m_pos = 3;
+
+            /* an empty path asks for the whole document, no path for
+               none of it */
+            m_filter = m_outline != nullptr
+                    || (mode.project
+                        && std::ranges::none_of(m_paths, &Path::empty));
+        }
+
+
+        /* Returns the first error in the source, nothing is reported to
+           the handler after it. */
+        auto
+        document() -> std::expected<void, Error>
+        {
+            {
+                KONCPP_STATS_TIME(m_stats, scan);
+                measure_indentation(m_src, m_pos, m_tab_width, m_lines);
+            }
+
+            m_handler.begin_object();
+            block(-1);
+            if (!failed() && m_pos < m_src.size())
+                fail(ErrorCode::UnexpectedContent, m_pos);
+            if (failed()) return std::unexpected { *m_error };
+
+            m_handler.end_object();
+            return {};
+        }
+
+
+        [[nodiscard]]
+        auto
+        position() const noexcept -> std::size_t
+        {
+            return m_pos;
+        }
+
+
+    private:
+        std::string_view m_src;
+        std::size_t      m_pos {};
+        Handler         &m_handler;
+        std::string     &m_buffer;
+
+        std::vector<Indentation> &m_lines;
+        std::size_t               m_line {};
+        std::size_t               m_tab_width;
+
+        /* The members of a projected parse that were descended into,
+           reported only once something inside them is kept. */
+        struct Frame
+        {
+            std::string_view key;
+            std::size_t      segments;
+            std::size_t      range; /* in m_outline */
+        };
+
+        std::span<const Path>         m_paths;
+        std::vector<MemberRange>     *m_outline;
+        std::size_t                   m_depth;
+        bool                          m_filter {};
+        std::vector<Frame>            m_frames;
+        std::size_t                   m_reported {};
+        std::vector<std::string_view> m_segments;
+
+        [[maybe_unused]] ParseStats &m_stats;
+
+        std::size_t          m_nesting {};
+        std::optional<Error> m_error;
+
+
+        /* A level of nesting, counted for as long as it lives. */
+        class Nested
+        {
+        public:
+            Nested(State &state, std::size_t at) : m_state(state)
+            {
+                if (++m_state.m_nesting > MaxDepth)
+                    m_state.fail(ErrorCode::NestingTooDeep, at);
+            }
+
+            ~Nested()
+            {
+                m_state.m_nesting--;
+            }
+
+            Nested(const Nested &)                     = delete;
+            auto operator=(const Nested &) -> Nested & = delete;
+
+
+        private:
+            State &m_state;
+        };
+
+
+        /*
+         * Records the first error. Nothing is thrown, so that rejecting
+         * input costs no more than parsing it: every function returns once
+         * failed() is set, and the rest of the source is given up so that
+         * the loops over it end.
+         */
+        void
+        fail(ErrorCode code, std::size_t offset) noexcept
+        {
+            if (!m_error) m_error = Error { code, offset };
+            m_pos = m_src.size();
+        }
+
+
+        [[nodiscard]]
+        auto
+        failed() const noexcept -> bool
+        {
+            return m_error.has_value();
+        }
+
+
+        [[nodiscard]]
+        auto
+        peek() const noexcept -> char
+        {
+            return m_pos < m_src.size() ? m_src[m_pos] : '\0';
+        }
+
+
+        [[nodiscard]]
+        auto
+        at_line_end() const noexcept -> bool
+        {
+            return m_pos >= m_src.size() || m_src[m_pos] == '\n';
+        }
+
+
+        void
+        expect(char c, ErrorCode code) noexcept
+        {
+            if (peek() == c)
+                m_pos++;
+            else
+                fail(code, m_pos);
+        }
+
+
+        /* Skips spaces and comments, but not new lines. */
+        void
+        skip_inline()
+        {
+            KONCPP_STATS_TIME(m_stats, scan);
+            pass_inline();
+        }
+
+
+        /*
+         * Skips as skip_inline() does, without timing it, for scanners that
+         * are timed as a whole.
+         */
+        void
+        pass_inline()
+        {
+            while (m_pos < m_src.size())
+            {
+                const auto c { m_src[m_pos] };
+
+                if (is_space(c))
+                    m_pos++;
+                else if (c == '/' && m_pos + 1 < m_src.size()
+                         && m_src[m_pos + 1] == '/')
+                {
+                    m_pos = m_src.find('\n', m_pos);
+                    if (m_pos == std::string_view::npos) m_pos = m_src.size();
+                }
+                else if (c == '/' && m_pos + 1 < m_src.size()
+                         && m_src[m_pos + 1] == '*')
+                {
+                    const auto end { find_comment_end(m_src, m_pos + 2) };
+                    if (end == std::string_view::npos)
+                    {
+                        fail(ErrorCode::UnterminatedComment, m_pos);
+                        return;
+                    }
+                    m_pos = end + 2;
+                }
+                else
+                    break;
+            }
+        }
+
+
+        /* Skips spaces, comments and new lines. */
+        void
+        skip_all()
+        {
+            for (skip_inline(); peek() == '\n'; skip_inline()) m_pos++;
+        }
+
+
+        /*
+         * Returns the indentation of the line starting at the current
+         * position. The parser only moves forward, so the lines are looked
+         * up in order.
+         */
+        auto
+        indentation() noexcept -> const Indentation &
+        {
+            while (m_lines[m_line].start < m_pos) m_line++;
+            return m_lines[m_line];
+        }
+
+
+        void
+        block(long parent_indent)
+        {
+            const Nested nested { *this, m_pos };
+            long         indent { -1 };
+
+            if (failed()) return;
+
+            while (m_pos < m_src.size())
+            {
+                const auto &line { indentation() };
+                const auto  width { static_cast<long>(line.width) };
+
+                m_pos = line.end;
+                skip_inline();
+                if (m_pos >= m_src.size()) return;
+                if (m_src[m_pos] == '\n')
+                {
+                    m_pos++;
+                    continue;
+                }
+
+                if (width <= parent_indent)
+                {
+                    m_pos = line.start;
+                    return;
+                }
+
+                if (indent < 0)
+                    indent = width;
+                else if (width != indent)
+                {
+                    fail(ErrorCode::InconsistentIndentation, m_pos);
+                    return;
+                }
+
+                if (m_filter)
+                    projected_member(indent);
+                else
+                    member(indent);
+            }
+        }
+
+
+        void
+        member(long indent)
+        {
+            const auto name { key() };
+
+            skip_inline();
+            expect(':', ErrorCode::ExpectedColon);
+            skip_inline();
+            if (failed()) return;
+
+            m_handler.key(name);
+
+            if (at_line_end())
+            {
+                if (m_pos < m_src.size()) m_pos++;
+
+                m_handler.begin_object();
+                block(indent);
+                if (!failed()) m_handler.end_object();
+                return;
+            }
+
+            value();
+
+            skip_inline();
+            if (!at_line_end())
+                fail(ErrorCode::ExpectedNewLine, m_pos);
+            if (m_pos < m_src.size()) m_pos++;
+        }
+
+
+        auto
+        key() -> std::string_view
+        {
+            const auto start { m_pos };
+
+            while (true)
+            {
+                if (!is_alpha(peek()))
+                {
+                    fail(ErrorCode::InvalidIdentifier, m_pos);
+                    return {};
+                }
+
+                while (m_pos < m_src.size() && is_identifier(m_src[m_pos]))
+                    m_pos++;
+
+                if (peek() != '.') break;
+                m_pos++;
+            }
+
+            return m_src.substr(start, m_pos - start);
+        }
+
+
+        auto
+        value() -> Kind
+        {
+            const auto c { peek() };
+
+            if (c == '"') return string();
+            if (c == '[') return array();
+            if (c == '{') return object();
+            if (c == '-' || c == '+' || is_digit(c)) return number();
+
+            if (is_alpha(c))
+            {
+                const auto start { m_pos };
+                while (m_pos < m_src.size() && is_identifier(m_src[m_pos]))
+                    m_pos++;
+
+                const auto word { m_src.substr(start, m_pos - start) };
+
+                if (word == "null")
+                {
+                    m_handler.null();
+                    return Kind::Null;
+                }
+                if (word == "true" || word == "false")
+                {
+                    m_handler.boolean(word == "true");
+                    return Kind::Boolean;
+                }
+
+                fail(ErrorCode::UnexpectedIdentifier, start);
+                return Kind::None;
+            }
+
+            fail(ErrorCode::ExpectedValue, m_pos);
+            return Kind::None;
+        }
+
+
+        /**
+         * Appends the body of a quoted string to the buffer, SYNTAX.md §2.5.
+         * Returns false if the body has no escape sequences, in which case
+         * nothing is appended and @p raw holds the body.
+         */
+        auto
+        string_body(std::string_view &raw, bool buffered) -> bool
+        {
+            KONCPP_STATS_TIME(m_stats, unescape);
+            KONCPP_STATS_GROWTH(&m_stats, m_buffer);
+
+            const auto open { m_pos++ };
+            auto       start { m_pos };
+
+            while (true)
+            {
+                const auto end { m_src.find_first_of("\"\\", m_pos) };
+                if (end == std::string_view::npos)
+                {
+                    fail(ErrorCode::UnterminatedString, open);
+                    return false;
+                }
+
+                if (m_src[end] == '"')
+                {
+                    m_pos = end + 1;
+
+                    if (!buffered)
+                    {
+                        raw = m_src.substr(start, end - start);
+                        return false;
+                    }
+
+                    m_buffer.append(m_src.substr(start, end - start));
+                    return true;
+                }
+
+                if (!buffered)
+                {
+                    m_buffer.clear();
+                    buffered = true;
+                }
+
+                m_buffer.append(m_src.substr(start, end - start));
+                m_pos = end + 1;
+
+                switch (peek())
+                {
+                case '\\': m_buffer.push_back('\\'); break;
+                case '"':  m_buffer.push_back('"'); break;
+                case 'n':  m_buffer.push_back('\n'); break;
+                case 'r':  m_buffer.push_back('\r'); break;
+                case 't':  m_buffer.push_back('\t'); break;
+                default:
+                    /* unknown escapes are kept raw */
+                    m_buffer.push_back('\\');
+                    start = m_pos;
+                    continue;
+                }
+
+                start = ++m_pos;
+            }
+        }
+
+
+        auto
+        string() -> Kind
+        {
+            std::string_view raw;
+            auto             buffered { string_body(raw, false) };
+
+            /* adjacent quoted strings concatenate */
+            while (true)
+            {
+                const auto save { m_pos };
+                skip_all();
+                if (failed()) return Kind::None;
+
+                if (peek() != '"')
+                {
+                    m_pos = save;
+                    break;
+                }
+
+                if (!buffered)
+                {
+                    KONCPP_STATS_GROWTH(&m_stats, m_buffer);
+                    m_buffer.assign(raw);
+                    buffered = true;
+                }
+                string_body(raw, true);
+            }
+
+            m_handler.string(buffered ? std::string_view { m_buffer } : raw);
+            return Kind::String;
+        }
+
+
+        auto
+        array() -> Kind
+        {
+            const Nested nested { *this, m_pos };
+            if (failed()) return Kind::None;
+
+            m_pos++;
+            m_handler.begin_array();
+
+            auto kind { Kind::None };
+
+            skip_all();
+            while (!failed() && peek() != ']')
+            {
+                const auto start { m_pos };
+                const auto item { value() };
+                if (failed()) return Kind::None;
+
+                if (kind == Kind::None)
+                    kind = item;
+                else if (item != kind)
+                {
+                    fail(ErrorCode::MixedArray, start);
+                    return Kind::None;
+                }
+
+                skip_all();
+                if (peek() == ']') break;
+
+                expect(',', ErrorCode::ExpectedArraySeparator);
+                skip_all();
+            }
+
+            if (failed()) return Kind::None;
+            m_pos++;
+            m_handler.end_array();
+            return Kind::Array;
+        }
+
+
+        auto
+        object() -> Kind
+        {
+            const Nested nested { *this, m_pos };
+            if (failed()) return Kind::None;
+
+            m_pos++;
+            if (!m_filter) m_handler.begin_object();
+
+            skip_all();
+            while (!failed() && peek() != '}')
+            {
+                if (m_filter)
+                    projected_object_member();
+                else
+                    object_member();
+
+                skip_all();
+                if (peek() == '}') break;
+
+                expect(';', ErrorCode::ExpectedObjectSeparator);
+                skip_all();
+            }
+
+            if (failed()) return Kind::None;
+            m_pos++;
+            if (!m_filter) m_handler.end_object();
+            return Kind::Object;
+        }
+
+
+        /* A member of an inline object. */
+        void
+        object_member()
+        {
+            const auto name { key() };
+
+            skip_all();
+            expect(':', ErrorCode::ExpectedColon);
+            skip_all();
+            if (failed()) return;
+
+            m_handler.key(name);
+            value();
+        }
+
+
+        /* Returns how the member @p name of the current object relates to
+           the requested paths. */
+        auto
+        match(std::string_view name) -> Match
+        {
+            if (m_outline != nullptr)
+                return m_frames.size() + 1 < m_depth ? Match::Descend
+                                                     : Match::Skip;
+
+            const auto depth { m_segments.size() };
+            split(name);
+
+            auto result { Match::Skip };
+            for (const auto &path : m_paths)
+            {
+                const auto shared { std::min(path.size(), m_segments.size()) };
+
+                std::size_t i { 0 };
+                while (i < shared && path[i].name == m_segments[i]) i++;
+                if (i < shared) continue;
+
+                if (path.size() <= m_segments.size())
+                {
+                    result = Match::Keep;
+                    break;
+                }
+                result = Match::Descend;
+            }
+
+            m_segments.resize(depth);
+            return result;
+        }
+
+
+        void
+        split(std::string_view name)
+        {
+            for (auto dot { name.find('.') }; dot != std::string_view::npos;
+                 dot = name.find('.'))
+            {
+                m_segments.push_back(name.substr(0, dot));
+                name.remove_prefix(dot + 1);
+            }
+            m_segments.push_back(name);
+        }
+
+
+        /* Descends into the object value of the member @p name , whose
+           range is @p range when outlining. */
+        void
+        enter(std::string_view name, std::size_t range)
+        {
+            const auto depth { m_segments.size() };
+            split(name);
+            m_frames.push_back({ name, m_segments.size() - depth, range });
+        }
+
+
+        /* Starts the range of the member @p name at @p start when
+           outlining. */
+        auto
+        record(std::string_view name, std::size_t start) -> std::size_t
+        {
+            if (m_outline == nullptr) return std::string_view::npos;
+
+            const auto parent { m_frames.empty() ? std::string_view::npos
+                                                 : m_frames.back().range };
+            m_outline->push_back({ name, start, start, parent });
+            return m_outline->size() - 1;
+        }
+
+
+        void
+        finish(std::size_t range)
+        {
+            if (range != std::string_view::npos)
+                (*m_outline)[range].end = m_pos;
+        }
+
+
+        void
+        leave()
+        {
+            if (m_reported == m_frames.size())
+            {
+                m_handler.end_object();
+                m_reported--;
+            }
+
+            m_segments.resize(m_segments.size() - m_frames.back().segments);
+            m_frames.pop_back();
+        }
+
+
+        /* Reports the objects leading to a member that is kept. */
+        void
+        report()
+        {
+            for (; m_reported < m_frames.size(); m_reported++)
+            {
+                m_handler.key(m_frames[m_reported].key);
+                m_handler.begin_object();
+            }
+        }
+
+
+        /* Parses a member that is kept with the projection turned off,
+           starting over from its key at @p start . */
+        template <typename T_Func>
+        void
+        keep(std::size_t start, T_Func parse)
+        {
+            report();
+
+            m_pos    = start;
+            m_filter = false;
+            parse();
+            m_filter = true;
+        }
+
+
+        /* member() for a document projected onto the requested paths. */
+        void
+        projected_member(long indent)
+        {
+            const auto start { m_pos };
+            const auto name { key() };
+
+            skip_inline();
+            expect(':', ErrorCode::ExpectedColon);
+            skip_inline();
+            if (failed()) return;
+
+            const auto result { match(name) };
+
+            if (result == Match::Keep)
+            {
+                keep(start, [&] { member(indent); });
+                return;
+            }
+
+            const auto range { record(name, start) };
+
+            if (at_line_end())
+            {
+                if (m_pos < m_src.size()) m_pos++;
+
+                if (result == Match::Skip)
+                    skip_block(indent);
+                else
+                {
+                    enter(name, range);
+                    block(indent);
+                    if (failed()) return;
+                    leave();
+                }
+
+                finish(range);
+                return;
+            }
+
+            if (result == Match::Descend && peek() == '{')
+            {
+                enter(name, range);
+                object();
+                if (failed()) return;
+                leave();
+            }
+            else
+                skip_value(true);
+
+            finish(range);
+            skip_inline();
+            if (!at_line_end())
+                fail(ErrorCode::ExpectedNewLine, m_pos);
+            if (m_pos < m_src.size()) m_pos++;
+        }
+
+
+        void
+        projected_object_member()
+        {
+            const auto start { m_pos };
+            const auto name { key() };
+
+            skip_all();
+            expect(':', ErrorCode::ExpectedColon);
+            skip_all();
+            if (failed()) return;
+
+            const auto result { match(name) };
+
+            if (result == Match::Keep)
+            {
+                keep(start, [&] { object_member(); });
+                return;
+            }
+
+            const auto range { record(name, start) };
+
+            if (result == Match::Descend && peek() == '{')
+            {
+                enter(name, range);
+                object();
+                if (failed()) return;
+                leave();
+            }
+            else
+                skip_value(false);
+
+            finish(range);
+        }
+
+
+        /*
+         * Skips the lines indented deeper than @p parent_indent , like
+         * block() but without looking at their members.
+         */
+        void
+        skip_block(long parent_indent)
+        {
+            while (m_pos < m_src.size())
+            {
+                const auto &line { indentation() };
+
+                m_pos = line.end;
+                skip_inline();
+                if (m_pos >= m_src.size()) return;
+
+                if (m_src[m_pos] != '\n')
+                {
+                    if (static_cast<long>(line.width) <= parent_indent)
+                    {
+                        m_pos = line.start;
+                        return;
+                    }
+                    skip_value(true);
+                }
+
+                if (m_pos < m_src.size()) m_pos++;
+            }
+        }
+
+
+        /*
+         * Skips a value by its structure alone, up to the ',', ';', ']' or
+         * '}' that ends it, or in a block up to the end of its line. Only
+         * strings and comments are looked into, to not be misled by the
+         * brackets within them.
+         */
+        void
+        skip_value(bool in_block)
+        {
+            KONCPP_STATS_TIME(m_stats, scan);
+
+            std::size_t depth { 0 };
+
+            while (m_pos < m_src.size())
+            {
+                switch (m_src[m_pos])
+                {
+                case '"': skip_string(); continue;
+                case '/':
+                    if (m_pos + 1 < m_src.size()
+                        && (m_src[m_pos + 1] == '/' || m_src[m_pos + 1] == '*'))
+                    {
+                        pass_inline();
+                        continue;
+                    }
+                    break;
+                case '[':
+                case '{': depth++; break;
+                case ']':
+                case '}':
+                    if (depth == 0) return;
+                    depth--;
+                    break;
+                case ',':
+                case ';':
+                    if (depth == 0) return;
+                    break;
+                case '\n':
+                    if (in_block && depth == 0) return;
+                    break;
+                default: break;
+                }
+
+                m_pos++;
+            }
+        }
+
+
+        /*
+         * Skips a quoted string, and those adjacent to it, unescaped. Only
+         * called by skip_value(), which times it.
+         */
+        void
+        skip_string()
+        {
+            while (true)
+            {
+                const auto open { m_pos++ };
+
+                while (true)
+                {
+                    const auto end { m_src.find_first_of("\"\\", m_pos) };
+                    if (end == std::string_view::npos)
+                    {
+                        fail(ErrorCode::UnterminatedString, open);
+                        return;
+                    }
+
+                    m_pos = end + (m_src[end] == '"' ? 1 : 2);
+                    if (m_src[end] == '"') break;
+                }
+
+                const auto save { m_pos };
+                for (pass_inline(); peek() == '\n'; pass_inline()) m_pos++;
+                if (failed()) return;
+
+                if (peek() != '"')
+                {
+                    m_pos = save;
+                    return;
+                }
+            }
+        }
+
+
+        auto
+        number() -> Kind
+        {
+            const auto start { m_pos };
+            if (peek() == '-' || peek() == '+') m_pos++;
+
+            const auto digits { m_pos };
+            while (is_digit(peek())) m_pos++;
+            if (m_pos == digits)
+            {
+                fail(ErrorCode::InvalidNumber, start);
+                return Kind::None;
+            }
+
+            bool is_float { false };
+
+            if (peek() == '.' && m_pos + 1 < m_src.size()
+                && is_digit(m_src[m_pos + 1]))
+            {
+                is_float = true;
+                for (m_pos++; is_digit(peek());) m_pos++;
+            }
+
+            if (peek() == 'e' || peek() == 'E')
+            {
+                is_float = true;
+                m_pos++;
+                if (peek() == '-' || peek() == '+') m_pos++;
+
+                const auto exponent { m_pos };
+                while (is_digit(peek())) m_pos++;
+                if (m_pos == exponent)
+                {
+                    fail(ErrorCode::InvalidNumber, start);
+                    return Kind::None;
+                }
+            }
+
+            /* std::from_chars does not accept a leading '+' */
+            const auto *first { m_src.data() + start
+                                + (m_src[start] == '+' ? 1 : 0) };
+            const auto *last { m_src.data() + m_pos };
+
+            if (is_float)
+            {
+                double value {};
+                if (!convert(first, last, value))
+                {
+                    fail(ErrorCode::InvalidNumber, start);
+                    return Kind::None;
+                }
+
+                m_handler.floating(value);
+                return Kind::Float;
+            }
+
+            types::Signed value {};
+            if (convert(first, last, value))
+            {
+                m_handler.integer(value);
+                return Kind::Integer;
+            }
+
+            types::Unsigned big {};
+            if (*first != '-' && convert(first, last, big))
+            {
+                m_handler.unsigned_integer(big);
+                return Kind::Integer;
+            }
+
+            fail(ErrorCode::IntegerOutOfRange, start);
+            return Kind::None;
+        }
+
+
+        template <typename T_Number>
+        auto
+        convert(const char *first, const char *last, T_Number &value) -> bool
+        {
+            KONCPP_STATS_TIME(m_stats, number);
+            return std::from_chars(first, last, value).ec == std::errc {};
+        }
+    };
+
+    /**
+     * Parses @p source , returning the first error if it is invalid. A
+     * @c ValueError from the handler is propagated, with @p position set to
+     * where it happened.
+     */
+    auto
+    run(std::string_view          source,
+        Handler                  &handler,
+        std::string              &buffer,
+        std::vector<Indentation> &lines,
+        std::size_t               tab_width,
+        const ParseMode          &mode,
+        ParseStats               &stats,
+        std::size_t              &position) -> std::expected<void, Error>
+    {
+        koncpp::trace::Span span { "parse" };
+        span.arg("bytes", static_cast<std::int64_t>(source.size()));
+
+        stats = {};
+
+#ifdef KONCPP_STATS
+        stats.bytes = source.size();
+
+        TimedHandler timed { handler, stats };
+        State        state {
+            source, timed, buffer, lines, tab_width, mode, stats
+        };
+
+        const auto start { std::chrono::steady_clock::now() };
+#else
+        State state { source, handler, buffer, lines, tab_width, mode, stats };
+#endif
+
+        std::expected<void, Error> result;
+
+        try
+        {
+            result = state.document();
+        }
+        catch (const ValueError &)
+        {
+            position = state.position();
+            throw;
+        }
+
+        if (!result) return result;
+
+#ifdef KONCPP_STATS
+        stats.total = std::chrono::duration_cast<ParseStats::Duration>(
+            std::chrono::steady_clock::now() - start);
+        stats.parse = stats.total - stats.scan - stats.unescape - stats.number
+                    - stats.build;
+#endif
+        return result;
+    }
+}
+
+
+void
+Parser::parse(std::string_view source, Handler &handler)
+{
+    ParseStats stats;
+    parse(source, handler, stats);
+}
+
+
+void
+Parser::parse(std::string_view source, Handler &handler, ParseStats &stats)
+{
+    mf_run(source, handler, {}, stats);
+}
+
+
+void
+Parser::parse(std::string_view      source,
+              Handler              &handler,
+              std::span<const Path> paths)
+{
+    ParseStats stats;
+    parse(source, handler, paths, stats);
+}
+
+
+void
+Parser::parse(std::string_view      source,
+              Handler              &handler,
+              std::span<const Path> paths,
+              ParseStats           &stats)
+{
+    mf_run(source, handler, { .paths = paths, .project = true }, stats);
+}
+
+
+auto
+Parser::outline(std::string_view source, std::size_t depth)
+    -> std::vector<MemberRange>
+{
+    std::vector<MemberRange> ranges;
+    if (depth == 0) return ranges;
+
+    Ignore     ignore;
+    ParseStats stats;
+    mf_run(source, ignore, { .outline = &ranges, .depth = depth }, stats);
+    return ranges;
+}
+
+
+void
+Parser::mf_run(std::string_view source,
+               Handler         &handler,
+               const ParseMode &mode,
+               ParseStats      &stats)
+{
+    std::size_t                position {};
+    std::expected<void, Error> result;
+
+    try
+    {
+        result = run(source, handler, m_buffer, m_lines, m_tab_width, mode,
+                     stats, position);
+    }
+    catch (const ValueError &e)
+    {
+        throw ParseError { { ErrorCode::InvalidValue, position }, e.what() };
+    }
+
+    if (!result) throw ParseError { result.error() };
+    mf_trim();
+}
+
+
+auto
+Parser::try_parse(std::string_view source, Handler &handler)
+    -> std::expected<void, Error>
+{
+    ParseStats stats;
+    return try_parse(source, handler, stats);
+}
+
+
+auto
+Parser::try_parse(std::string_view source,
+                  Handler         &handler,
+                  ParseStats      &stats) -> std::expected<void, Error>
+{
+    std::size_t                position {};
+    std::expected<void, Error> result;
+
+    try
+    {
+        result = run(source, handler, m_buffer, m_lines, m_tab_width, {},
+                     stats, position);
+    }
+    catch (const ValueError &)
+    {
+        return std::unexpected { Error { ErrorCode::InvalidValue, position } };
+    }
+
+    if (result) mf_trim();
+    return result;
+}
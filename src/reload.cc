@@ -0,0 +1,216 @@
+/**
+ * @file reload.cc
+ * @copyright Copyright (C) 2025-2026 Kei <RQuarx@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+#include "koncpp/reload.hh"
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+using koncpp::EpochDomain;
+using koncpp::FileWatcher;
+
+
+namespace
+{
+    constexpr std::chrono::milliseconds PollInterval { 100 };
+}
+
+
+EpochDomain::~EpochDomain()
+{
+    for (const auto &retired : m_retired) retired.deleter(retired.ptr);
+}
+
+
+auto
+EpochDomain::enter() -> Slot *
+{
+    std::scoped_lock lock { m_mutex };
+
+    auto it { std::ranges::find_if(
+        m_slots,
+        [](const Slot &slot)
+        { return slot.epoch.load(std::memory_order_relaxed) == 0; }) };
+
+    auto &slot { it != m_slots.end() ? *it : m_slots.emplace_back() };
+    slot.epoch.store(epoch(), std::memory_order_release);
+    return &slot;
+}
+
+
+void
+EpochDomain::leave(Slot *slot) noexcept
+{
+    std::scoped_lock lock { m_mutex };
+    slot->epoch.store(0, std::memory_order_release);
+}
+
+
+void
+EpochDomain::retire(void *ptr, void (*deleter)(void *))
+{
+    const auto next { m_epoch.fetch_add(1, std::memory_order_acq_rel) + 1 };
+
+    std::scoped_lock lock { m_mutex };
+    m_retired.push_back({ next, ptr, deleter });
+}
+
+
+void
+EpochDomain::collect()
+{
+    std::scoped_lock lock { m_mutex };
+
+    auto oldest { std::numeric_limits<std::uint64_t>::max() };
+    for (const auto &slot : m_slots)
+        if (const auto epoch { slot.epoch.load(std::memory_order_acquire) };
+            epoch != 0)
+            oldest = std::min(oldest, epoch);
+
+    const auto [first, last] { std::ranges::remove_if(
+        m_retired,
+        [oldest](const Retired &retired)
+        {
+            if (retired.epoch > oldest) return false;
+            retired.deleter(retired.ptr);
+            return true;
+        }) };
+    m_retired.erase(first, last);
+}
+
+
+auto
+EpochDomain::pending() const -> std::size_t
+{
+    std::scoped_lock lock { m_mutex };
+    return m_retired.size();
+}
+
+
+FileWatcher::~FileWatcher()
+{
+    stop();
+}
+
+
+void
+FileWatcher::start(std::filesystem::path path, std::function<void()> on_change)
+{
+    stop();
+
+    path = std::filesystem::absolute(path);
+
+#ifdef __linux__
+    const int fd { inotify_init1(IN_NONBLOCK | IN_CLOEXEC) };
+    if (fd < 0)
+        throw Exception { "inotify_init1: {}", std::strerror(errno) };
+
+    if (inotify_add_watch(fd,
+                          path.parent_path().c_str(),
+                          IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE)
+        < 0)
+    {
+        const auto error { errno };
+        close(fd);
+        throw Exception { "inotify_add_watch({}): {}",
+                          path.parent_path().string(),
+                          std::strerror(error) };
+    }
+
+    m_running = true;
+    m_thread  = std::thread {
+        [this, fd, name = path.filename().string(), on_change]
+        {
+            alignas(inotify_event) char buffer[4096];
+
+            pollfd pfd { .fd = fd, .events = POLLIN, .revents = 0 };
+
+            while (m_running.load(std::memory_order_acquire))
+            {
+                if (poll(&pfd, 1, PollInterval.count()) <= 0) continue;
+
+                bool    changed { false };
+                ssize_t len;
+                while ((len = read(fd, buffer, sizeof(buffer))) > 0)
+                {
+                    for (auto *ptr { buffer }; ptr < buffer + len;)
+                    {
+                        const auto *event {
+                            reinterpret_cast<const inotify_event *>(ptr)
+                        };
+                        if (event->len > 0 && name == event->name)
+                            changed = true;
+                        ptr += sizeof(inotify_event) + event->len;
+                    }
+                }
+
+                if (changed) on_change();
+            }
+
+            close(fd);
+        }
+    };
+#else
+    std::error_code ec;
+    auto            last { std::filesystem::last_write_time(path, ec) };
+
+    m_running = true;
+    m_thread  = std::thread {
+        [this, path, on_change, last]() mutable
+        {
+            while (m_running.load(std::memory_order_acquire))
+            {
+                std::this_thread::sleep_for(PollInterval);
+
+                std::error_code ec;
+                const auto      now { std::filesystem::last_write_time(path,
+                                                                       ec) };
+                if (ec || now == last) continue;
+
+                last = now;
+                on_change();
+            }
+        }
+    };
+#endif
+}
+
+
+void
+FileWatcher::stop() noexcept
+{
+    m_running.store(false, std::memory_order_release);
+    if (m_thread.joinable()) m_thread.join();
+}
+
+
+auto
+FileWatcher::running() const noexcept -> bool
+{
+    return m_running.load(std::memory_order_acquire);
+}
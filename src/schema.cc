@@ -0,0 +1,181 @@
+/**
+ * @file schema.cc
+ * @copyright Copyright (C) 2025-2026 Kei <RQuarx@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+
+#include "koncpp/schema.hh"
+
+using koncpp::Schema;
+using koncpp::Validator;
+
+
+Schema::Schema(std::vector<Rule> rules) : m_rules(std::move(rules))
+{
+    std::ranges::sort(m_rules, {}, &Rule::path);
+
+    m_index.reserve(m_rules.size());
+    for (std::uint32_t i { 0 }; i < m_rules.size(); i++)
+    {
+        auto &rule { m_rules[i] };
+
+        if (!m_index.emplace(rule.path, i).second)
+            throw SchemaError { "duplicate rule for '{}'", rule.path };
+
+        rule.slot = rule.required ? m_required++ : NoSlot;
+    }
+}
+
+
+auto
+Schema::find(std::string_view path) const noexcept -> const Rule *
+{
+    const auto it { m_index.find(path) };
+    if (it == m_index.end()) return nullptr;
+    return &m_rules[it->second];
+}
+
+
+auto
+Schema::rules() const noexcept -> const std::vector<Rule> &
+{
+    return m_rules;
+}
+
+
+auto
+Schema::required_count() const noexcept -> std::uint32_t
+{
+    return m_required;
+}
+
+
+auto
+Schema::type_name(const Rule &rule) noexcept -> std::string_view
+{
+    switch (rule.type)
+    {
+    case ValueType::Null:    return "any";
+    case ValueType::Integer: return rule.is_unsigned ? "uint" : "int";
+    case ValueType::Float:   return "float";
+    case ValueType::Boolean: return "bool";
+    case ValueType::String:  return "string";
+    case ValueType::Array:   return "array";
+    case ValueType::Object:  return "object";
+    }
+
+    return "any";
+}
+
+
+void
+Schema::mf_parse_type(std::string_view name, Rule &rule)
+{
+    if (name == "any")
+        rule.type = ValueType::Null;
+    else if (name == "int")
+        rule.type = ValueType::Integer;
+    else if (name == "uint")
+    {
+        rule.type        = ValueType::Integer;
+        rule.is_unsigned = true;
+    }
+    else if (name == "float")
+        rule.type = ValueType::Float;
+    else if (name == "bool")
+        rule.type = ValueType::Boolean;
+    else if (name == "string")
+        rule.type = ValueType::String;
+    else if (name == "array")
+        rule.type = ValueType::Array;
+    else if (name == "object")
+        rule.type = ValueType::Object;
+    else
+        throw SchemaError { "'{}': unknown type '{}'", rule.path, name };
+}
+
+
+Validator::Validator(const Schema &schema)
+    : m_schema(&schema), m_seen((schema.required_count() + 63) / 64)
+{
+}
+
+
+auto
+Validator::finish() -> bool
+{
+    for (const auto &rule : m_schema->rules())
+    {
+        if (rule.slot == Schema::NoSlot) continue;
+        if ((m_seen[rule.slot / 64] >> (rule.slot % 64) & 1) != 0) continue;
+
+        m_error = std::format("missing required key '{}'", rule.path);
+        return false;
+    }
+
+    return true;
+}
+
+
+void
+Validator::reset() noexcept
+{
+    std::ranges::fill(m_seen, 0);
+    m_error.clear();
+}
+
+
+auto
+Validator::error() const noexcept -> std::string_view
+{
+    return m_error;
+}
+
+
+auto
+Validator::mf_mark(std::string_view path) -> const Schema::Rule *
+{
+    const auto *rule { m_schema->find(path) };
+
+    if (rule != nullptr && rule->slot != Schema::NoSlot)
+        m_seen[rule->slot / 64] |= std::uint64_t { 1 } << (rule->slot % 64);
+
+    return rule;
+}
+
+
+auto
+Validator::mf_fail(const Schema::Rule &rule) -> bool
+{
+    m_error = std::format("'{}': expected a value of type '{}'",
+                          rule.path,
+                          Schema::type_name(rule));
+    return false;
+}
+
+
+auto
+Validator::mf_check_range(const Schema::Rule &rule, bool below, bool above)
+    -> bool
+{
+    if (below)
+        m_error = std::format("'{}': value is below the minimum", rule.path);
+    else if (above)
+        m_error = std::format("'{}': value is above the maximum", rule.path);
+
+    return !below && !above;
+}
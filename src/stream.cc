@@ -0,0 +1,167 @@
+/**
+ * @file stream.cc
+ * @copyright Copyright (C) 2025-2026 Kei <RQuarx@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+
+#include "koncpp/stream.hh"
+
+using koncpp::detail::Splitter;
+
+
+namespace
+{
+    /* Identifiers start with a letter, SYNTAX.md §2.8. */
+    constexpr auto
+    starts_key(char c) noexcept -> bool
+    {
+        return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+    }
+}
+
+
+void
+Splitter::feed(std::string_view chunk)
+{
+    /* drop the consumed members once they are most of the buffer */
+    if (m_start > 0 && m_start >= m_buffer.size() / 2)
+    {
+        m_buffer.erase(0, m_start);
+        m_pos    -= m_start;
+        m_offset += m_start;
+        for (auto &end : m_ends) end -= m_start;
+        m_start = 0;
+    }
+
+    m_buffer.append(chunk);
+    mf_scan();
+}
+
+
+void
+Splitter::finish()
+{
+    m_finished = true;
+    mf_scan();
+
+    const auto last { m_ends.empty() ? m_start : m_ends.back() };
+    if (m_buffer.size() > last) m_ends.push_back(m_buffer.size());
+}
+
+
+void
+Splitter::mf_scan()
+{
+    const std::string_view text { m_buffer };
+
+    /* whether the byte after m_pos is known, or never will be */
+    const auto ahead = [&] { return m_pos + 1 < text.size() || m_finished; };
+
+    while (m_pos < text.size())
+    {
+        switch (m_state)
+        {
+        case State::String:
+        {
+            const auto end { text.find_first_of("\"\\", m_pos) };
+            if (end == std::string_view::npos)
+            {
+                m_pos = text.size();
+                return;
+            }
+
+            m_pos = end;
+            if (text[end] == '"')
+            {
+                m_state = State::Code;
+                m_pos++;
+            }
+            else if (ahead())
+                m_pos += 2; /* escapes are always two bytes */
+            else
+                return;
+            continue;
+        }
+
+        case State::LineComment:
+        {
+            const auto end { text.find('\n', m_pos) };
+            if (end == std::string_view::npos)
+            {
+                m_pos = text.size();
+                return;
+            }
+
+            /* the new line itself may end the member */
+            m_state = State::Code;
+            m_pos   = end;
+            continue;
+        }
+
+        case State::BlockComment:
+        {
+            const auto end { text.find("*/", m_pos) };
+            if (end == std::string_view::npos)
+            {
+                /* keep a trailing '*' to be matched with the next chunk */
+                m_pos = std::max(m_pos, text.size() - 1);
+                return;
+            }
+
+            m_state = State::Code;
+            m_pos   = end + 2;
+            continue;
+        }
+
+        case State::Code: break;
+        }
+
+        switch (text[m_pos])
+        {
+        case '"': m_state = State::String; break;
+        case '[':
+        case '{': m_depth++; break;
+        case ']':
+        case '}':
+            /* unbalanced brackets are left to the parser */
+            if (m_depth > 0) m_depth--;
+            break;
+
+        case '/':
+            if (!ahead()) return;
+            if (m_pos + 1 < text.size() && text[m_pos + 1] == '/')
+                m_state = State::LineComment;
+            else if (m_pos + 1 < text.size() && text[m_pos + 1] == '*')
+            {
+                m_state = State::BlockComment;
+                m_pos++;
+            }
+            break;
+
+        case '\n':
+            if (!ahead()) return;
+            if (m_depth == 0 && m_pos + 1 < text.size()
+                && starts_key(text[m_pos + 1]))
+                m_ends.push_back(m_pos + 1);
+            break;
+
+        default: break;
+        }
+
+        m_pos++;
+    }
+}
@@ -0,0 +1,200 @@
+/**
+ * @file trace.cc
+ * @copyright Copyright (C) 2025-2026 Kei <RQuarx@protonmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstdio>
+#include <format>
+#include <iterator>
+#include <mutex>
+
+#include "koncpp/trace.hh"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+namespace trace = koncpp::trace;
+
+using trace::Span;
+
+
+std::atomic<bool> trace::detail::enabled { false };
+
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    /* Events are buffered and written in chunks of about this size. */
+    constexpr std::size_t FlushSize { 64 * 1024 };
+
+
+    struct Sink
+    {
+        std::mutex        mutex;
+        std::FILE        *file {};
+        std::string       buffer;
+        bool              first { true };
+        Clock::time_point epoch;
+    };
+
+
+    auto
+    sink() -> Sink &
+    {
+        static Sink instance;
+        return instance;
+    }
+
+
+    auto
+    process_id() noexcept -> long
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        return static_cast<long>(::getpid());
+#else
+        return 0;
+#endif
+    }
+
+
+    /* Small sequential ids read better in the viewer than native ones. */
+    auto
+    thread_id() noexcept -> std::uint32_t
+    {
+        static std::atomic<std::uint32_t> next { 1 };
+        thread_local const std::uint32_t  id { next.fetch_add(
+            1, std::memory_order_relaxed) };
+        return id;
+    }
+
+
+    void
+    flush(Sink &sink) noexcept
+    {
+        if (sink.file == nullptr) return;
+        std::fwrite(sink.buffer.data(), 1, sink.buffer.size(), sink.file);
+        sink.buffer.clear();
+    }
+
+
+    /* Must be called with the sink locked. */
+    void
+    close(Sink &sink) noexcept
+    {
+        if (sink.file == nullptr) return;
+
+        trace::detail::enabled.store(false, std::memory_order_relaxed);
+
+        sink.buffer.append("\n]}\n");
+        flush(sink);
+        std::fclose(sink.file);
+        sink.file = nullptr;
+    }
+
+
+    auto
+    micros(Clock::duration duration) noexcept -> double
+    {
+        return std::chrono::duration<double, std::micro> { duration }.count();
+    }
+}
+
+
+void
+trace::start(const std::filesystem::path &path)
+{
+    auto            &out { sink() };
+    std::scoped_lock lock { out.mutex };
+
+    close(out);
+
+    out.file = std::fopen(path.string().c_str(), "wb");
+    if (out.file == nullptr)
+        throw TraceError { "cannot open '{}' for tracing", path.string() };
+
+    out.buffer.assign(R"({"displayTimeUnit":"ns","traceEvents":[)");
+    out.first = true;
+    out.epoch = Clock::now();
+
+    detail::enabled.store(true, std::memory_order_relaxed);
+}
+
+
+void
+trace::stop()
+{
+    auto            &out { sink() };
+    std::scoped_lock lock { out.mutex };
+
+    close(out);
+}
+
+
+void
+Span::mf_begin(const char *name, const char *category) noexcept
+{
+    m_name     = name;
+    m_category = category;
+    m_start    = Clock::now();
+}
+
+
+void
+Span::mf_arg(const char *key, std::int64_t value)
+{
+    if (!m_args.empty()) m_args.push_back(',');
+    std::format_to(std::back_inserter(m_args), R"("{}":{})", key, value);
+}
+
+
+void
+Span::mf_end() noexcept
+{
+    const auto end { Clock::now() };
+    const auto tid { thread_id() };
+
+    auto            &out { sink() };
+    std::scoped_lock lock { out.mutex };
+
+    /* tracing stopped, and maybe restarted, while the span was open */
+    if (out.file == nullptr || m_start < out.epoch) return;
+
+    try
+    {
+        std::format_to(
+            std::back_inserter(out.buffer),
+            R"({}{{"name":"{}","cat":"{}","ph":"X","ts":{:.3f},"dur":{:.3f},)"
+            R"("pid":{},"tid":{},"args":{{{}}}}})",
+            out.first ? "\n" : ",\n",
+            m_name,
+            m_category,
+            micros(m_start - out.epoch),
+            micros(end - m_start),
+            process_id(),
+            tid,
+            m_args);
+        out.first = false;
+    }
+    catch (...)
+    {
+        /* losing an event is better than throwing from a destructor */
+        return;
+    }
+
+    if (out.buffer.size() >= FlushSize) flush(out);
+}
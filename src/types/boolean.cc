@@ -21,107 +21,8 @@
 using koncpp::types::Boolean;
 
 
-Boolean::Boolean() noexcept : m_value(Value::Null) {}
-Boolean::Boolean(const Boolean &other) noexcept : m_value(other.m_value) {}
-Boolean::Boolean(Boolean &&other) noexcept
-{
-    if (this != &other)
-    {
-        m_value       = other.m_value;
-        other.m_value = Value::Null;
-    }
-}
-
-
-auto
-Boolean::operator=(const Boolean &other) noexcept -> Boolean &
-{
-    m_value = other.m_value;
-    return *this;
-}
-
-
-auto
-Boolean::operator=(Boolean &&other) noexcept -> Boolean &
-{
-    if (this != &other)
-    {
-        m_value       = other.m_value;
-        other.m_value = Value::Null;
-    }
-
-    return *this;
-}
-
-
 auto
 Boolean::type() const noexcept -> ValueType
 {
     return ValueType::Boolean;
 }
-
-
-auto
-Boolean::get() const noexcept -> std::optional<bool>
-{
-    if (m_value == Value::Null) return Null;
-    return static_cast<bool>(m_value);
-}
-
-
-Boolean::
-operator bool() const noexcept
-{
-    return m_value == Value::True;
-}
-
-
-auto
-Boolean::operator!() const noexcept -> bool
-{
-    return m_value != Value::True;
-}
-
-
-auto
-Boolean::operator==(const Boolean &rhs) const noexcept -> bool
-{
-    return m_value == rhs.m_value;
-}
-
-
-auto
-Boolean::operator!=(const Boolean &rhs) const noexcept -> bool
-{
-    return m_value != rhs.m_value;
-}
-
-
-auto
-Boolean::operator&&(const Boolean &rhs) const noexcept -> Boolean
-{
-    return { static_cast<bool>(*this) && static_cast<bool>(rhs) };
-}
-
-
-auto
-Boolean::operator||(const Boolean &rhs) const noexcept -> Boolean
-{
-    return { static_cast<bool>(*this) || static_cast<bool>(rhs) };
-}
-
-
-auto
-Boolean::operator&=(const Boolean &rhs) -> Boolean &
-{
-    *this = static_cast<bool>(*this) && static_cast<bool>(rhs);
-    return *this;
-}
-
-
-auto
-Boolean::operator|=(const Boolean &rhs) -> Boolean &
-{
-    *this = static_cast<bool>(*this) || static_cast<bool>(rhs);
-    return *this;
-}
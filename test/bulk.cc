@@ -0,0 +1,328 @@
+#include <koncpp/bulk.hh>
+#include <koncpp/parser.hh>
+
+#include "_.hh"
+
+
+namespace test
+{
+    using namespace koncpp;
+    using namespace koncpp::types;
+    using namespace koncpp::bulk;
+
+    using Doc = Value<>;
+
+
+    /* Every third element is null, the others count up from @p first . */
+    template <typename T_Type>
+    auto
+    make_column(std::size_t size, T_Type first) -> Column<T_Type>
+    {
+        Column<T_Type> column;
+        for (std::size_t i { 0 }; i < size; i++)
+        {
+            if (i % 3 == 2)
+                column.push_back(std::nullopt);
+            else
+                column.push_back(first + static_cast<T_Type>(i));
+        }
+        return column;
+    }
+
+
+    TEST(conversion, {
+        Doc array;
+        array.push_back(Integer { 4 });
+        array.push_back(Integer { -2 });
+        array.push_back(Integer { Null });
+
+        const auto signed_column { Column<Signed>::from(array) };
+        TEST_ASSERT(signed_column.size() == 3)
+        TEST_ASSERT(signed_column.null_count() == 1)
+        TEST_ASSERT(*signed_column.get(1) == -2)
+        TEST_ASSERT(!signed_column.get(2))
+        TEST_ASSERT(signed_column.values()[2] == 0)
+        TEST_ASSERT(signed_column.to_value() == array)
+
+        /* SYNTAX.md §2.2.2 */
+        const auto unsigned_column { Column<Unsigned>::from(array) };
+        TEST_ASSERT(unsigned_column.null_count() == 2)
+        TEST_ASSERT(*unsigned_column.get(0) == 4)
+
+        const auto floats { Column<double>::from(array) };
+        TEST_ASSERT(*floats.get(1) == -2.0)
+
+        Doc strings;
+        strings.push_back(Doc::StringType { "a" });
+        TEST_THROWS((void)Column<double>::from(strings), ValueError)
+    })
+
+
+    TEST(aggregates, {
+        const auto column { make_column<Signed>(100, -10) };
+
+        Signed expected {};
+        for (std::size_t i { 0 }; i < 100; i++)
+            if (i % 3 != 2) expected += -10 + static_cast<Signed>(i);
+
+        TEST_ASSERT(*sum(column) == expected)
+        TEST_ASSERT(*min(column) == -10)
+        TEST_ASSERT(*max(column) == 89)
+
+        Column<double> nulls;
+        nulls.push_back(std::nullopt);
+        TEST_ASSERT(!sum(nulls))
+        TEST_ASSERT(!min(nulls))
+        TEST_ASSERT(!max(Column<double> {}))
+
+        Column<double> nan;
+        nan.push_back(1.0);
+        nan.push_back(std::numeric_limits<double>::quiet_NaN());
+        nan.push_back(-3.0);
+        TEST_ASSERT(*min(nan) == -3.0)
+        TEST_ASSERT(*max(nan) == 1.0)
+    })
+
+
+    TEST(elementwise, {
+        const auto lhs { make_column<double>(37, 1.0) };
+        auto       rhs { Column<double> { std::vector<double>(37, 0.5) } };
+
+        const auto total { add(lhs, rhs) };
+        TEST_ASSERT(total.null_count() == lhs.null_count())
+        TEST_ASSERT(*total.get(0) == 1.5)
+        TEST_ASSERT(!total.get(2))
+        TEST_ASSERT(total.values()[2] == 0.0)
+
+        constexpr auto infinity { std::numeric_limits<double>::infinity() };
+
+        const auto scaled { scale(lhs, infinity) };
+        TEST_ASSERT(!scaled.get(5))
+        TEST_ASSERT(scaled.values()[5] == 0.0)
+
+        const auto counts { make_column<Unsigned>(9, 1) };
+        const auto twice { scale(counts, Unsigned { 2 }) };
+        TEST_ASSERT(*twice.get(7) == 16)
+
+        TEST_THROWS((void)add(lhs, Column<double> {}), ValueError)
+    })
+
+
+    TEST(selection, {
+        const auto column { make_column<Signed>(70, -35) };
+
+        const auto negative { compare(column, Compare::Less, Signed { 0 }) };
+        TEST_ASSERT(negative.size() == 70)
+        TEST_ASSERT(negative.test(0))
+        TEST_ASSERT(!negative.test(2))
+        TEST_ASSERT(!negative.test(35))
+
+        const auto selected { filter(column, negative) };
+        TEST_ASSERT(selected.size() == negative.count())
+        TEST_ASSERT(selected.null_count() == 0)
+        TEST_ASSERT(*max(selected) == -1)
+
+        /* unsigned comparisons must not be done as signed */
+        Column<Unsigned> big;
+        big.push_back(1);
+        big.push_back(std::numeric_limits<Unsigned>::max());
+        const auto above { compare(big, Compare::Greater, Unsigned { 1 }) };
+        TEST_ASSERT(above.count() == 1)
+
+        TEST_THROWS((void)filter(column, Bitmap { 3 }), ValueError)
+    })
+
+
+    /* Every fifth element is null, the others alternate from true. */
+    auto
+    make_booleans(std::size_t size) -> BooleanColumn
+    {
+        BooleanColumn column;
+        for (std::size_t i { 0 }; i < size; i++)
+        {
+            if (i % 5 == 4)
+                column.push_back(std::nullopt);
+            else
+                column.push_back(i % 2 == 0);
+        }
+        return column;
+    }
+
+
+    TEST(booleans, {
+        Doc array;
+        array.push_back(Boolean { true });
+        array.push_back(Boolean { false });
+        array.push_back(Boolean {});
+        array.push_back(Boolean { true });
+
+        const auto column { BooleanColumn::from(array) };
+        TEST_ASSERT(column.size() == 4)
+        TEST_ASSERT(column.null_count() == 1)
+        TEST_ASSERT(!column.get(2))
+        TEST_ASSERT(*column.get(3))
+        TEST_ASSERT(count(column) == 2)
+        TEST_ASSERT(any(column))
+        TEST_ASSERT(!all(column))
+        TEST_ASSERT(column.to_value() == array)
+
+        /* SYNTAX.md §2.4 */
+        Doc integers;
+        integers.push_back(Integer { 0 });
+        integers.push_back(Integer { -3 });
+        const auto flags { BooleanColumn::from(integers) };
+        TEST_ASSERT(!*flags.get(0))
+        TEST_ASSERT(*flags.get(1))
+
+        const auto odd { make_booleans(10) };
+        const auto even { BooleanColumn(Bitmap(10, true)) };
+        TEST_ASSERT(all(even))
+        TEST_ASSERT(count(odd && even) == count(odd))
+        TEST_ASSERT((odd || even) == even)
+        TEST_ASSERT((odd && even).null_count() == 0)
+
+        Doc strings;
+        strings.push_back(Doc::StringType { "a" });
+        TEST_THROWS((void)BooleanColumn::from(strings), ValueError)
+        TEST_THROWS((void)(odd && BooleanColumn {}), ValueError)
+        TEST_THROWS(BooleanColumn(Bitmap { 3 }, Bitmap { 4 }), ValueError)
+    })
+
+
+    auto
+    build(std::string_view source, bool pack) -> Doc
+    {
+        Builder<> builder;
+        builder.set_pack_booleans(pack);
+        Parser {}.parse(source, builder);
+        return builder.take();
+    }
+
+
+    /* An array of @p size booleans, every third one true. */
+    auto
+    flags_source(std::size_t size) -> std::string
+    {
+        std::string source { "flags: [ true" };
+        for (std::size_t i { 1 }; i < size; i++)
+            source += i % 3 == 0 ? ", true" : ", false";
+        return source + " ]";
+    }
+
+
+    TEST(packed, {
+        const auto source { flags_source(1000) };
+        const auto packed { build(source, true) };
+        const auto boxed { build(source, false) };
+
+        const auto &flags { packed.at("flags") };
+        TEST_ASSERT(flags.holds<BooleanArray>())
+        TEST_ASSERT(flags.type() == ValueType::Array)
+        TEST_ASSERT(flags.size() == 1000)
+        TEST_ASSERT(packed == boxed)
+        TEST_ASSERT(count(flags.get<BooleanArray>()) == 334)
+        TEST_ASSERT(BooleanColumn::from(flags)
+                    == BooleanColumn::from(boxed.at("flags")))
+        TEST_ASSERT(packed.memory_usage().bytes * 50
+                    < boxed.memory_usage().bytes)
+        TEST_THROWS((void)flags.at(0), ValueError)
+
+        /* only arrays that start with a boolean are packed */
+        const auto other { build("none: []\n"
+                                 "names: [ \"a\" ]\n"
+                                 "nested: [ [ true ], [] ]",
+                                 true) };
+        TEST_ASSERT(other.at("none").holds<Doc::Array>())
+        TEST_ASSERT(other.at("names").holds<Doc::Array>())
+        TEST_ASSERT(other.at("nested").holds<Doc::Array>())
+        TEST_ASSERT(other.at("nested").at(0).holds<BooleanArray>())
+        TEST_ASSERT(other.at("nested").at(1).holds<Doc::Array>())
+
+        Builder<> builder;
+        builder.set_pack_booleans();
+        builder.begin_array();
+        builder.boolean(true);
+        TEST_THROWS(builder.integer(1), ValueError)
+    })
+
+
+    template <typename T_Type>
+    auto
+    run_all(const Column<T_Type> &column, T_Type pivot)
+    {
+        std::vector<Bitmap> masks;
+        for (const auto op :
+             { Compare::Equal, Compare::NotEqual, Compare::Less,
+               Compare::LessEqual, Compare::Greater, Compare::GreaterEqual })
+            masks.push_back(compare(column, op, pivot));
+
+        return std::tuple { sum(column),
+                            min(column),
+                            max(column),
+                            add(column, column),
+                            scale(column, T_Type { 3 }),
+                            masks };
+    }
+
+
+    auto
+    query_all(const Bitmap &bitmap)
+    {
+        const Bitmap full { bitmap.size(), true };
+        const Bitmap none { bitmap.size() };
+
+        return std::tuple { count(bitmap), any(bitmap), all(bitmap),
+                            any(none),     all(full),   count(full) };
+    }
+
+
+    constexpr std::array Sizes { 0, 1, 7, 8, 63, 64, 65, 1000 };
+    constexpr std::array Levels { Isa::Avx2, Isa::Avx512 };
+
+
+    /* Every instruction set must agree with the scalar kernels. */
+    TEST(instruction_sets, {
+        const auto best { isa() };
+
+        for (const std::size_t size : Sizes)
+        {
+            const auto ints { make_column<Signed>(size, -500) };
+            const auto uints { make_column<Unsigned>(size, 1) };
+            const auto floats { make_column<double>(size, -500.0) };
+
+            const auto booleans { make_booleans(size).values() };
+
+            set_isa(Isa::Scalar);
+            const auto booleans_scalar { query_all(booleans) };
+            const auto ints_scalar { run_all(ints, Signed { 3 }) };
+            const auto uints_scalar { run_all(uints, Unsigned { 3 }) };
+            const auto floats_scalar { run_all(floats, 3.0) };
+
+            for (const auto level : Levels)
+            {
+                if (set_isa(level) != level) continue;
+
+                TEST_ASSERT(run_all(ints, Signed { 3 }) == ints_scalar)
+                TEST_ASSERT(run_all(uints, Unsigned { 3 }) == uints_scalar)
+                TEST_ASSERT(run_all(floats, 3.0) == floats_scalar)
+                TEST_ASSERT(query_all(booleans) == booleans_scalar)
+            }
+        }
+
+        TEST_ASSERT(set_isa(best) == best)
+    })
+}
+
+
+auto
+main() -> int
+{
+    test::conversion();
+    test::aggregates();
+    test::elementwise();
+    test::selection();
+    test::booleans();
+    test::packed();
+    test::instruction_sets();
+    return 0;
+}
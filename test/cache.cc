@@ -0,0 +1,200 @@
+#include <koncpp/cache.hh>
+
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include "_.hh"
+
+
+namespace test
+{
+    using namespace koncpp;
+    using namespace koncpp::types;
+
+
+    const auto directory { std::filesystem::temp_directory_path()
+                           / "koncpp-cache-test" };
+
+
+    constexpr std::string_view Source { "name: \"svc\" // a comment\n"
+                                        "http:\n"
+                                        "    port: 8080\n"
+                                        "    hosts: [ \"a\", \"b\\n\" ]\n"
+                                        "http.timeout: 2.5\n"
+                                        "big: 18446744073709551615\n"
+                                        "flags: { on: true; off: null }\n" };
+
+
+    auto
+    recorded(std::string_view source) -> std::string
+    {
+        TapeRecorder recorder;
+        Parser {}.parse(source, recorder);
+        return std::string { recorder.tape() };
+    }
+
+
+    TEST(tape, {
+        const auto tape { recorded(Source) };
+        TEST_ASSERT(valid_tape(tape))
+
+        Builder<> builder;
+        replay(tape, builder);
+        TEST_ASSERT(builder.take() == parse(Source))
+
+        /* truncated or unbalanced tapes are refused */
+        TEST_ASSERT(!valid_tape(std::string_view { tape }.substr(0, 7)))
+        TEST_ASSERT(!valid_tape(tape.substr(0, tape.size() - 1)))
+        TEST_ASSERT(!valid_tape("\x7f"))
+    })
+
+
+    TEST(hits, {
+        std::filesystem::remove_all(directory);
+        ParseCache cache { directory };
+
+        TEST_ASSERT(cache.parse(Source) == parse(Source))
+        TEST_ASSERT(cache.misses() == 1)
+        TEST_ASSERT(std::filesystem::exists(cache.entry_path(Source)))
+
+        TEST_ASSERT(cache.parse(Source) == parse(Source))
+        TEST_ASSERT(cache.hits() == 1)
+
+        /* another source is another entry */
+        TEST_ASSERT(cache.parse("a: 1\n") == parse("a: 1\n"))
+        TEST_ASSERT(cache.misses() == 2)
+
+        /* a separate cache finds the entries on disk */
+        ParseCache other { directory };
+        TEST_ASSERT(other.parse(Source) == parse(Source))
+        TEST_ASSERT(other.hits() == 1)
+    })
+
+
+    TEST(invalid, {
+        std::filesystem::remove_all(directory);
+        ParseCache cache { directory };
+
+        TEST_THROWS((void)cache.parse("a: [1, \"b\"]\n"), ParseError)
+        TEST_ASSERT(!std::filesystem::exists(
+            cache.entry_path("a: [1, \"b\"]\n")))
+
+        /* a damaged entry is replaced */
+        (void)cache.parse(Source);
+        const auto entry { cache.entry_path(Source) };
+        std::filesystem::resize_file(entry,
+                                     std::filesystem::file_size(entry) - 3);
+
+        TEST_ASSERT(cache.parse(Source) == parse(Source))
+        TEST_ASSERT(cache.misses() == 3)
+        TEST_ASSERT(cache.parse(Source) == parse(Source))
+        TEST_ASSERT(cache.hits() == 1)
+    })
+
+
+    auto
+    parse_error(ParseCache &cache, std::string_view source) -> std::size_t
+    {
+        try
+        {
+            (void)cache.parse(source);
+        }
+        catch (const ParseError &error)
+        {
+            return error.offset();
+        }
+        return 0;
+    }
+
+
+    TEST(builder, {
+        std::filesystem::remove_all(directory);
+        ParseCache cache { directory };
+
+        /* valid kon, that the builder rejects */
+        constexpr std::string_view Source { "a: 1\na.b: 2\n" };
+        const auto offset { try_parse(Source).error().offset };
+
+        TEST_ASSERT(parse_error(cache, Source) == offset)
+        TEST_ASSERT(!std::filesystem::exists(cache.entry_path(Source)))
+        TEST_ASSERT(parse_error(cache, Source) == offset)
+        TEST_ASSERT(cache.misses() == 2)
+
+        /* an entry stored for another handler fails in the same way */
+        TapeRecorder recorder;
+        cache.parse(Source, recorder);
+        TEST_ASSERT(std::filesystem::exists(cache.entry_path(Source)))
+        TEST_ASSERT(parse_error(cache, Source) == offset)
+        TEST_ASSERT(cache.hits() == 1)
+    })
+
+
+    void
+    overwrite(const std::filesystem::path &file, std::streamoff at, char c)
+    {
+        std::fstream out { file, std::ios::in | std::ios::out
+                                     | std::ios::binary };
+        out.seekp(at);
+        out.put(c);
+    }
+
+
+    TEST(collision, {
+        std::filesystem::remove_all(directory);
+        ParseCache cache { directory };
+
+        (void)cache.parse(Source);
+
+        /* an entry whose size and hash match, for another source */
+        overwrite(cache.entry_path(Source), 32, 'N');
+
+        TEST_ASSERT(cache.parse(Source) == parse(Source))
+        TEST_ASSERT(cache.misses() == 2)
+        TEST_ASSERT(cache.parse(Source) == parse(Source))
+        TEST_ASSERT(cache.hits() == 1)
+    })
+
+
+    TEST(concurrent, {
+        std::filesystem::remove_all(directory);
+        ParseCache cache { directory };
+
+        std::vector<std::thread> threads;
+        std::atomic<int>         matches {};
+
+        for (int i { 0 }; i < 8; i++)
+            threads.emplace_back(
+                [&]
+                {
+                    for (int j { 0 }; j < 50; j++)
+                        if (cache.parse(Source) == parse(Source)) matches++;
+                });
+        for (auto &thread : threads) thread.join();
+
+        TEST_ASSERT(matches == 400)
+        TEST_ASSERT(cache.hits() + cache.misses() == 400)
+
+        /* no temporary files are left behind */
+        TEST_ASSERT(std::distance(std::filesystem::directory_iterator {
+                                      directory },
+                                  std::filesystem::directory_iterator {})
+                    == 1)
+    })
+}
+
+
+auto
+main() -> int
+{
+    test::tape();
+    test::hits();
+    test::invalid();
+    test::builder();
+    test::collision();
+    test::concurrent();
+
+    std::filesystem::remove_all(test::directory);
+    return 0;
+}
@@ -0,0 +1,162 @@
+#include <koncpp/diff.hh>
+
+#include "_.hh"
+
+
+namespace test
+{
+    using namespace koncpp;
+    using namespace koncpp::types;
+
+    using Doc  = Value<>;
+    using Kind = Edit<>::Kind;
+
+
+    auto
+    make_document() -> Doc
+    {
+        Doc http;
+        http.insert("timeout", Integer { 30 });
+        http.insert("retries", Integer { 3 });
+
+        Doc svc;
+        svc.insert("http", http);
+        svc.insert("name", Doc::StringType { "svc" });
+
+        Doc ports;
+        ports.push_back(Integer { 80 });
+        ports.push_back(Integer { 443 });
+
+        Doc document;
+        document.insert("svc", svc);
+        document.insert("ports", ports);
+        document.insert("debug", Boolean { false });
+        return document;
+    }
+
+
+    TEST(digest, {
+        const auto a { make_document() };
+        auto       b { make_document() };
+        TEST_ASSERT(digest(a).hash == digest(b).hash)
+
+        b.at("svc").at("http").insert("timeout", Integer { 31 });
+        TEST_ASSERT(digest(a).hash != digest(b).hash)
+        TEST_ASSERT(digest(a).children[1].hash == digest(b).children[1].hash)
+
+        /* member order does not matter */
+        Doc c;
+        c.insert("debug", Boolean { false });
+        c.insert("ports", a.at("ports"));
+        c.insert("svc", a.at("svc"));
+        TEST_ASSERT(digest(a).hash == digest(c).hash)
+    })
+
+
+    /* Whether diff() finds the change of member "a" from @p from to @p to. */
+    auto
+    changes(const Doc &from, const Doc &to) -> bool
+    {
+        Doc lhs;
+        lhs.insert("a", from);
+        Doc rhs;
+        rhs.insert("a", to);
+
+        const auto patch { diff(lhs, rhs) };
+        return patch.size() == 1 && patch[0].kind == Kind::Changed
+            && patch[0].path == "a" && patch[0].value == to;
+    }
+
+
+    TEST(scalars, {
+        /* no value hashes like null, or like another kind of number */
+        TEST_ASSERT(changes(Integer { -1 }, Doc {}))
+        TEST_ASSERT(changes(Integer { -1 }, Integer<> {}))
+        TEST_ASSERT(changes(Integer<Unsigned> { UINT64_MAX },
+                            Integer<Unsigned> {}))
+        TEST_ASSERT(changes(Integer { 5 }, Integer<Unsigned> { 5U }))
+        TEST_ASSERT(changes(Integer<Unsigned> { 5U }, Integer { 5 }))
+        TEST_ASSERT(changes(Boolean { false }, Boolean {}))
+        TEST_ASSERT(changes(Doc::StringType { "" }, Doc::StringType {}))
+
+        TEST_ASSERT(!changes(Integer { -1 }, Integer { -1 }))
+    })
+
+
+    auto
+    packed(std::initializer_list<bool> values) -> Doc
+    {
+        BooleanArray array;
+        for (const auto value : values) array.push_back(value);
+        return array;
+    }
+
+
+    auto
+    boxed(std::initializer_list<bool> values) -> Doc
+    {
+        Doc array { ValueType::Array };
+        for (const auto value : values) array.push_back(Boolean { value });
+        return array;
+    }
+
+
+    TEST(packed, {
+        /* a packed array hashes as the boxed one it stands for */
+        TEST_ASSERT(!changes(boxed({ true, false }), packed({ true, false })))
+        TEST_ASSERT(changes(boxed({ true, false }), packed({ true, true })))
+        TEST_ASSERT(changes(packed({ true }), packed({ true, false })))
+    })
+
+
+    TEST(edits, {
+        const auto a { make_document() };
+        TEST_ASSERT(diff(a, a).empty())
+
+        auto b { make_document() };
+        b.at("svc").at("http").insert("timeout", Integer { 60 });
+        b.at("svc").insert("owner", Doc::StringType { "kei" });
+        b.erase("debug");
+
+        const auto patch { diff(a, b) };
+        TEST_ASSERT(patch.size() == 3)
+        TEST_ASSERT(patch[0].kind == Kind::Changed)
+        TEST_ASSERT(patch[0].path == "svc.http.timeout")
+        TEST_ASSERT(patch[1].kind == Kind::Added)
+        TEST_ASSERT(patch[1].path == "svc.owner")
+        TEST_ASSERT(patch[2].kind == Kind::Removed)
+        TEST_ASSERT(patch[2].path == "debug")
+    })
+
+
+    TEST(patching, {
+        auto a { make_document() };
+        auto b { make_document() };
+        b.at("svc").at("http").erase("retries");
+        b.at("ports").push_back(Integer { 8080 });
+        b.insert("extra", Float { 1.5 });
+
+        apply_patch(a, diff(a, b));
+        TEST_ASSERT(a == b)
+
+        Doc empty;
+        apply_patch(empty, diff(Doc { ValueType::Object }, b));
+        TEST_ASSERT(digest(empty).hash == digest(b).hash)
+
+        Patch<> bad;
+        bad.push_back(Edit<> { Kind::Added, "debug.value", Integer { 1 } });
+        TEST_THROWS(apply_patch(a, bad), ValueError)
+    })
+}
+
+
+auto
+main() -> int
+{
+    test::digest();
+    test::scalars();
+    test::packed();
+    test::edits();
+    test::patching();
+    return 0;
+}
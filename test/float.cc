@@ -1,3 +1,4 @@
+#include <koncpp/types/checked.hh>
 #include <koncpp/types/float.hh>
 
 #include <cmath>
@@ -167,6 +168,24 @@ namespace test
         Float c { std::numeric_limits<double>::quiet_NaN() };
         TEST_ASSERT(std::isnan(*c.get()))
     })
+
+
+    TEST(checked, {
+        constexpr auto max { std::numeric_limits<double>::max() };
+        constexpr auto infinity { std::numeric_limits<double>::infinity() };
+
+        TEST_ASSERT(eq(*checked_div(Float { 1.0 }, Float { 4.0 })->get(), 0.25))
+        TEST_ASSERT(checked_div(Float { 1.0 }, Float { 0.0 }).error()
+                    == koncpp::ErrorCode::DivisionByZero)
+        TEST_ASSERT(checked_mul(Float { max }, Float { 2.0 }).error()
+                    == koncpp::ErrorCode::Overflow)
+        TEST_ASSERT(checked_add(Float {}, Float { 1.0 }).error()
+                    == koncpp::ErrorCode::NullOperand)
+
+        /* infinite operands are not an overflow */
+        TEST_ASSERT(*checked_add(Float { infinity }, Float { 1.0 })->get()
+                    == infinity)
+    })
 }
 
 
@@ -182,5 +201,6 @@ main() -> int
     test::conversion();
     test::formatter();
     test::special_cases();
+    test::checked();
     return 0;
 }
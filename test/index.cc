@@ -0,0 +1,217 @@
+#include <koncpp/index.hh>
+
+#include <filesystem>
+#include <format>
+#include <fstream>
+
+#include "_.hh"
+
+
+namespace test
+{
+    using namespace koncpp;
+    using namespace koncpp::types;
+
+
+    const auto path { std::filesystem::temp_directory_path()
+                      / "koncpp-index-test.kon" };
+
+
+    constexpr std::string_view Source { "name: \"inventory\"\n"
+                                        "svc:\n"
+                                        "    http:\n"
+                                        "        port: 80\n"
+                                        "        hosts: [ \"a\", \"b\" ]\n"
+                                        "    dns.port: 53\n"
+                                        "svc.http.timeout: 30\n"
+                                        "limits: { cpu: 4; mem: { max: 8 } }\n"
+                                        "svc.tls: true\n" };
+
+
+    void
+    write(std::string_view contents)
+    {
+        std::ofstream { path, std::ios::binary | std::ios::trunc }
+            << contents;
+    }
+
+
+    /* What a full parse has at @p key . */
+    auto
+    expected(std::string_view key) -> Value<>
+    {
+        return parse(Source).at(Path { key });
+    }
+
+
+    auto
+    indexed_equals(const IndexedFile &file, std::string_view key) -> bool
+    {
+        return file.get(Path { key }) == expected(key);
+    }
+
+
+    TEST(round_trip, {
+        auto index { SourceIndex::build(Source) };
+        index.stamp.size   = Source.size();
+        index.stamp.mtime  = 1;
+        index.stamp.hash   = 2;
+        index.stamp.sample = 3;
+
+        const auto sidecar { sidecar_path(path) };
+        index.write(sidecar);
+
+        const auto read { SourceIndex::read(sidecar) };
+        TEST_ASSERT(read.stamp == index.stamp)
+        TEST_ASSERT(read.entries == index.entries)
+
+        /* the root members and those of the objects they hold */
+        TEST_ASSERT(index.entries.size() == 9)
+        TEST_ASSERT(index.entries[0].key == "name")
+        TEST_ASSERT(index.entries[1].key == "svc")
+        TEST_ASSERT(index.entries[2].key == "http")
+        TEST_ASSERT(index.entries[2].parent == 1)
+        TEST_ASSERT(index.entries[3].key == "dns.port")
+        TEST_ASSERT(index.entries[4].parent == SourceIndex::NoParent)
+    })
+
+
+    TEST(subtrees, {
+        write(Source);
+        (void)write_index(path);
+
+        const auto file { open_indexed(path) };
+        TEST_ASSERT(indexed_equals(file, "name"))
+        TEST_ASSERT(indexed_equals(file, "svc"))
+        TEST_ASSERT(indexed_equals(file, "svc.http"))
+        TEST_ASSERT(indexed_equals(file, "svc.http.port"))
+        TEST_ASSERT(indexed_equals(file, "svc.http.hosts"))
+        TEST_ASSERT(indexed_equals(file, "svc.dns"))
+        TEST_ASSERT(indexed_equals(file, "svc.tls"))
+        TEST_ASSERT(indexed_equals(file, "limits"))
+        TEST_ASSERT(indexed_equals(file, "limits.mem.max"))
+        TEST_ASSERT(file.get(Path {}) == parse(Source))
+
+        TEST_THROWS((void)file.get(Path { "missing" }), ValueError)
+        TEST_THROWS((void)file.get(Path { "svc.missing" }), ValueError)
+    })
+
+
+    TEST(fragments, {
+        write(Source);
+        (void)write_index(path);
+
+        const auto file { open_indexed(path) };
+
+        /* only the members of svc that lead to the path are parsed */
+        const auto http { file.fragments(Path { "svc.http" }) };
+        TEST_ASSERT(http.size() == 2)
+        TEST_ASSERT(http[0].parent == "svc")
+        TEST_ASSERT(http[0].text.starts_with("http:"))
+        TEST_ASSERT(http[1].parent.empty())
+        TEST_ASSERT(http[1].text.starts_with("svc.http.timeout"))
+        TEST_ASSERT(file.fragments(Path { "svc.http.port" }).size() == 1)
+        TEST_ASSERT(file.fragments(Path { "missing" }).empty())
+    })
+
+
+    TEST(stale, {
+        write(Source);
+        (void)write_index(path);
+
+        write("name: \"other\"\n");
+        TEST_THROWS((void)open_indexed(path), IndexError)
+
+        std::filesystem::remove(sidecar_path(path));
+        TEST_THROWS((void)open_indexed(path), IndexError)
+
+        write("not an index");
+        std::filesystem::remove(sidecar_path(path));
+        std::filesystem::copy_file(path, sidecar_path(path));
+        TEST_THROWS((void)SourceIndex::read(sidecar_path(path)), IndexError)
+    })
+
+
+    TEST(contents, {
+        write(Source);
+        auto index { write_index(path) };
+        TEST_ASSERT(index.stamp.hash == hash_contents(Source))
+        TEST_ASSERT(index.stamp.sample == hash_sample(Source))
+
+        /* the same size and time, but other contents */
+        index.stamp.sample++;
+        index.write(sidecar_path(path));
+        TEST_THROWS((void)open_indexed(path), IndexError)
+        (void)open_indexed(path, Verify::Stamp);
+
+        index.stamp.sample--;
+        index.stamp.hash++;
+        index.write(sidecar_path(path));
+        (void)open_indexed(path);
+        TEST_THROWS((void)open_indexed(path, Verify::Contents), IndexError)
+    })
+
+
+    /* Large enough for only a sample of it to be hashed. */
+    auto
+    large_source() -> std::string
+    {
+        std::string source;
+        for (int i { 0 }; source.size() < 1 << 20; i++)
+            source += std::format("key{}: {}\n", i, 1000000 + i);
+        return source;
+    }
+
+
+    /* Overwrites the byte at @p offset , keeping the size and modification
+       time of the file. */
+    void
+    overwrite(std::size_t offset)
+    {
+        const auto time { std::filesystem::last_write_time(path) };
+        {
+            std::fstream file { path,
+                                std::ios::binary | std::ios::in
+                                    | std::ios::out };
+            file.seekp(static_cast<std::streamoff>(offset));
+            file.put('X');
+        }
+        std::filesystem::last_write_time(path, time);
+    }
+
+
+    TEST(sampling, {
+        const auto source { large_source() };
+        const auto stride { (source.size() - 4096) / 15 };
+        TEST_ASSERT(hash_sample(source) != hash_contents(source))
+
+        /* an edit within a sampled block is caught by default */
+        write(source);
+        (void)write_index(path);
+        overwrite(stride + 100);
+        TEST_THROWS((void)open_indexed(path), IndexError)
+
+        /* one between them takes hashing everything */
+        write(source);
+        (void)write_index(path);
+        overwrite(stride / 2);
+        (void)open_indexed(path);
+        TEST_THROWS((void)open_indexed(path, Verify::Contents), IndexError)
+    })
+}
+
+
+auto
+main() -> int
+{
+    test::round_trip();
+    test::subtrees();
+    test::fragments();
+    test::stale();
+    test::contents();
+    test::sampling();
+
+    std::filesystem::remove(test::path);
+    std::filesystem::remove(koncpp::sidecar_path(test::path));
+    return 0;
+}
@@ -1,3 +1,4 @@
+#include <koncpp/types/checked.hh>
 #include <koncpp/types/integer.hh>
 
 #include "_.hh"
@@ -25,6 +26,12 @@ namespace test
         Integer<Unsigned> d { -1 };
         TEST_ASSERT(!d.get())
 
+        /* signed receiving unsigned, null only when it does not fit */
+        Integer<Signed> k { 42U };
+        TEST_ASSERT(k.get().value() == 42)
+        Integer<Signed> l { std::numeric_limits<Unsigned>::max() };
+        TEST_ASSERT(!l.get())
+
         /* signed overflow => null */
         Integer e { std::numeric_limits<Signed>::max() };
         e = std::numeric_limits<Signed>::max();
@@ -196,6 +203,30 @@ namespace test
         Integer<Unsigned> nullv { -1 };
         TEST_ASSERT(std::format("{}", nullv) == "null")
     })
+
+
+    TEST(checked, {
+        constexpr auto max { std::numeric_limits<Signed>::max() };
+        constexpr auto min { std::numeric_limits<Signed>::min() };
+
+        TEST_ASSERT(checked_add(Integer { 40 }, Integer { 2 })->get() == 42)
+        TEST_ASSERT(checked_mod(Integer { 7 }, Integer { 4 })->get() == 3)
+        TEST_ASSERT(checked_mod(Integer { min }, Integer { -1 })->get() == 0)
+
+        TEST_ASSERT(checked_add(Integer { max }, Integer { 1 }).error()
+                    == koncpp::ErrorCode::Overflow)
+        TEST_ASSERT(checked_mul(Integer { max }, Integer { 2 }).error()
+                    == koncpp::ErrorCode::Overflow)
+        TEST_ASSERT(checked_div(Integer { min }, Integer { -1 }).error()
+                    == koncpp::ErrorCode::Overflow)
+        TEST_ASSERT(checked_div(Integer { 1 }, Integer { 0 }).error()
+                    == koncpp::ErrorCode::DivisionByZero)
+        const Integer<Unsigned> zero { 0U };
+        TEST_ASSERT(checked_sub(zero, Integer<Unsigned> { 1U }).error()
+                    == koncpp::ErrorCode::Overflow)
+        TEST_ASSERT(checked_sub(Integer { std::nullopt }, Integer { 1 }).error()
+                    == koncpp::ErrorCode::NullOperand)
+    })
 }
 
 
@@ -210,6 +241,7 @@ main() -> int
     test::comparison();
     test::conversion();
     test::formatter();
+    test::checked();
 
     return 0;
 }
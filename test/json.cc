@@ -0,0 +1,161 @@
+#include <koncpp/json.hh>
+
+#include <sstream>
+
+#include "_.hh"
+
+
+namespace test
+{
+    using namespace koncpp;
+    using namespace koncpp::types;
+
+
+    auto
+    to_json(std::string_view source) -> std::string
+    {
+        std::ostringstream out;
+        kon_to_json(source, out);
+        return out.str();
+    }
+
+
+    auto
+    to_kon(std::string_view source) -> std::string
+    {
+        std::ostringstream out;
+        json_to_kon(source, out);
+        return out.str();
+    }
+
+
+    /* Converting to kon and back is lossless for documents it can hold. */
+    auto
+    round_trips(std::string_view json) -> bool
+    {
+        return to_json(to_kon(json)) == std::string { json } + '\n';
+    }
+
+
+    /* An object holding @p arrays arrays nested in each other. */
+    auto
+    nested(std::size_t arrays) -> std::string
+    {
+        return "{\"a\":" + std::string(arrays, '[') + "1"
+             + std::string(arrays, ']') + "}";
+    }
+
+
+    TEST(kon_to_json, {
+        TEST_ASSERT(to_json("") == "{}\n")
+        TEST_ASSERT(to_json("/* dropped */\n"
+                            "a: 1 // dropped\n"
+                            "b: -2\n")
+                    == "{\"a\":1,\"b\":-2}\n")
+        TEST_ASSERT(to_json("object:\n"
+                            "    string: \"x\"\n"
+                            "    list: [ 1.5, 2.0 ]\n"
+                            "inline: { on: true; off: null }\n")
+                    == "{\"object\":{\"string\":\"x\",\"list\":[1.5,2]},"
+                       "\"inline\":{\"on\":true,\"off\":null}}\n")
+
+        /* concatenated and escaped strings */
+        TEST_ASSERT(to_json("s: \"Hello,\"\n\" \\\"World\\\"\\n\"\n")
+                    == "{\"s\":\"Hello, \\\"World\\\"\\n\"}\n")
+        TEST_ASSERT(to_json("s: \"\x01\"\n") == "{\"s\":\"\\u0001\"}\n")
+
+        /* beyond the range of a signed integer */
+        TEST_ASSERT(to_json("big: 18446744073709551615\n")
+                    == "{\"big\":18446744073709551615}\n")
+    })
+
+
+    TEST(dotted_keys, {
+        TEST_ASSERT(to_json("a.b: 1\n") == "{\"a\":{\"b\":1}}\n")
+        TEST_ASSERT(to_json("a.b.c: 1\n"
+                            "a.b.d: 2\n"
+                            "a.e: 3\n"
+                            "f: 4\n")
+                    == "{\"a\":{\"b\":{\"c\":1,\"d\":2},\"e\":3},\"f\":4}\n")
+        TEST_ASSERT(to_json("x: { a.b: 1; a.c: 2 }\n")
+                    == "{\"x\":{\"a\":{\"b\":1,\"c\":2}}}\n")
+
+        /* a key continuing in a nested object of a dotted one */
+        TEST_ASSERT(to_json("a.b: { c: 1 }\n"
+                            "a.d: 2\n")
+                    == "{\"a\":{\"b\":{\"c\":1},\"d\":2}}\n")
+
+        /* only consecutive keys are merged */
+        TEST_ASSERT(to_json("a.b: 1\n"
+                            "c: 2\n"
+                            "a.d: 3\n")
+                    == "{\"a\":{\"b\":1},\"c\":2,\"a\":{\"d\":3}}\n")
+    })
+
+
+    TEST(json_to_kon, {
+        TEST_ASSERT(to_kon("{}") == "")
+        TEST_ASSERT(to_kon("{ \"a\": 1, \"b\": { \"c\": \"x\" } }")
+                    == "a: 1\n"
+                       "b:\n"
+                       "    c: \"x\"\n")
+        TEST_ASSERT(to_kon("{\"l\":[{\"a\":1},{}],\"e\":{},\"f\":1.0}")
+                    == "l: [ { a: 1 }, {} ]\n"
+                       "e: {}\n"
+                       "f: 1.0\n")
+        TEST_ASSERT(to_kon("{\"s\":\"\\u00e9\\ud83d\\ude00\\\\\\t\"}")
+                    == "s: \"\xc3\xa9\xf0\x9f\x98\x80\\\\\\t\"\n")
+        TEST_ASSERT(to_kon("{\"n\":-9223372036854775809}")
+                    == "n: -9223372036854775808.0\n")
+    })
+
+
+    TEST(round_trip, {
+        TEST_ASSERT(round_trips("{\"a\":{\"b\":{\"c\":[1,2,3]},\"d\":[]}}"))
+        TEST_ASSERT(round_trips("{\"s\":[\"a\\\"b\",\"\\\\\",\"\\n\"]}"))
+        TEST_ASSERT(round_trips("{\"f\":[0.5,1e+300,-2.5],\"n\":null}"))
+        TEST_ASSERT(round_trips("{\"o\":[{\"a\":{\"b\":true}},{\"c\":[]}]}"))
+        TEST_ASSERT(round_trips("{\"u\":18446744073709551615}"))
+    })
+
+
+    TEST(errors, {
+        TEST_THROWS(to_kon("[1]"), JsonError)
+        TEST_THROWS(to_kon("{\"a\":[1,\"b\"]}"), JsonError)
+        TEST_THROWS(to_kon("{\"a.b\":1}"), JsonError)
+        TEST_THROWS(to_kon("{\"1a\":1}"), JsonError)
+        TEST_THROWS(to_kon("{\"a\":1,}"), JsonError)
+        TEST_THROWS(to_kon("{\"a\":01}"), JsonError)
+        TEST_THROWS(to_kon("{\"a\":\"\\x\"}"), JsonError)
+        TEST_THROWS(to_kon("{\"a\":\"open}"), JsonError)
+        TEST_THROWS(to_kon("{} {}"), JsonError)
+        TEST_THROWS(to_json("a: [1, \"b\"]\n"), ParseError)
+
+        /* deep input fails rather than overflowing the stack */
+        TEST_ASSERT(to_kon(nested(MaxDepth - 1)).starts_with("a: [ [ ["))
+        TEST_THROWS(to_kon(nested(MaxDepth)), JsonError)
+        TEST_THROWS(to_kon(nested(100000)), JsonError)
+
+        try
+        {
+            (void)to_kon("{\"a\": tru}");
+            TEST_ASSERT(false)
+        }
+        catch (const JsonError &e)
+        {
+            TEST_ASSERT(e.offset() == 6)
+        }
+    })
+}
+
+
+auto
+main() -> int
+{
+    test::kon_to_json();
+    test::dotted_keys();
+    test::json_to_kon();
+    test::round_trip();
+    test::errors();
+    return 0;
+}
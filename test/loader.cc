@@ -0,0 +1,164 @@
+#include <koncpp/loader.hh>
+
+#include <filesystem>
+#include <format>
+#include <fstream>
+
+#include "_.hh"
+
+
+namespace test
+{
+    using namespace koncpp;
+    using namespace koncpp::types;
+
+
+    const auto directory { std::filesystem::temp_directory_path()
+                           / "koncpp-loader-test" };
+
+
+    auto
+    source(int index) -> std::string
+    {
+        return std::format("name: \"file {}\"\n"
+                           "http:\n"
+                           "    port: {}\n"
+                           "    hosts: [ \"a\", \"b\" ]\n",
+                           index, 8000 + index);
+    }
+
+
+    void
+    write(const std::string &name, std::string_view contents)
+    {
+        std::ofstream { directory / name } << contents;
+    }
+
+
+    void
+    populate()
+    {
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory / "nested.kon");
+
+        for (int i { 0 }; i < 100; i++)
+            write(std::format("{}.kon", 100 + i), source(i));
+
+        write("empty.kon", "");
+        write("notes.txt", "not: [kon\n");
+    }
+
+
+    auto
+    with(LoadMethod method) -> LoadOptions
+    {
+        LoadOptions options;
+        options.method  = method;
+        options.threads = 4;
+        options.batch   = 16;
+        return options;
+    }
+
+
+    void
+    check(const std::vector<Loaded<>> &loaded)
+    {
+        TEST_ASSERT(loaded.size() == 101)
+
+        for (int i { 0 }; i < 100; i++)
+        {
+            TEST_ASSERT(loaded[i].path
+                        == directory / std::format("{}.kon", 100 + i))
+            TEST_ASSERT(loaded[i].document == parse(source(i)))
+        }
+
+        TEST_ASSERT(loaded[100].path.filename() == "empty.kon")
+        TEST_ASSERT(loaded[100].document == parse(""))
+    }
+
+
+    TEST(threads, {
+        populate();
+        check(load_directory(directory, with(LoadMethod::Threads)));
+    })
+
+
+    TEST(io_uring, {
+        populate();
+
+        try
+        {
+            check(load_directory(directory, with(LoadMethod::IoUring)));
+        }
+        catch (const LoadError &)
+        {
+            /* not supported by this kernel, or not allowed in here */
+        }
+
+        check(load_directory(directory));
+    })
+
+
+    TEST(extension, {
+        populate();
+
+        LoadOptions options;
+        options.extension = ".txt";
+        TEST_THROWS((void)load_directory(directory, options), ParseError)
+
+        options.extension = ".none";
+        TEST_ASSERT(load_directory(directory, options).empty())
+    })
+
+
+    auto
+    first() -> std::string
+    {
+        try
+        {
+            (void)parse("a: [1, \"b\"]\n");
+        }
+        catch (const ParseError &error)
+        {
+            return error.what();
+        }
+        return {};
+    }
+
+
+    TEST(errors, {
+        populate();
+        write("150.kon", "a: [1, \"b\"]\n");
+        write("170.kon", "a: {\n");
+
+        for (const auto method :
+             { LoadMethod::Automatic, LoadMethod::Threads })
+        {
+            try
+            {
+                (void)load_directory(directory, with(method));
+                TEST_ASSERT(false)
+            }
+            catch (const ParseError &error)
+            {
+                /* the first file by name */
+                TEST_ASSERT(std::string_view { error.what() } == first())
+            }
+        }
+
+        TEST_THROWS((void)load_directory(directory / "missing"), LoadError)
+    })
+}
+
+
+auto
+main() -> int
+{
+    test::threads();
+    test::io_uring();
+    test::extension();
+    test::errors();
+
+    std::filesystem::remove_all(test::directory);
+    return 0;
+}
@@ -0,0 +1,85 @@
+#include <koncpp/location.hh>
+#include <koncpp/parser.hh>
+
+#include "_.hh"
+
+
+namespace test
+{
+    using namespace koncpp;
+
+
+    constexpr std::string_view Source { "first: 1\n"
+                                        "second:\n"
+                                        "    name: \"line one\n"
+                                        "line two\"\n"
+                                        "    size: 2\n"
+                                        "    héllo: 3" };
+
+
+    auto
+    at(std::size_t line, std::size_t column) -> Location
+    {
+        return Location { .line = line, .column = column };
+    }
+
+
+    TEST(index, {
+        const LineIndex index { Source };
+
+        TEST_ASSERT(index.line_count() == 6)
+        TEST_ASSERT(index.locate(0) == at(1, 1))
+        TEST_ASSERT(index.locate(8) == at(1, 9))
+        TEST_ASSERT(index.locate(9) == at(2, 1))
+        TEST_ASSERT(index.locate(Source.find("size")) == at(5, 5))
+        TEST_ASSERT(index.locate(Source.size()) == at(6, 13))
+        TEST_ASSERT(index.locate(Source.size() + 10) == at(6, 13))
+
+        /* é is two bytes but one column */
+        TEST_ASSERT(index.locate(Source.find(':', Source.find("llo")))
+                    == at(6, 10))
+
+        TEST_ASSERT(index.line(2) == "second:")
+        TEST_ASSERT(index.line(6) == "    héllo: 3")
+        TEST_ASSERT(index.line(7).empty())
+        TEST_ASSERT(index.line(0).empty())
+    })
+
+
+    TEST(lazy, {
+        const LineIndex index { Source };
+
+        for (std::size_t offset { 0 }; offset <= Source.size(); offset++)
+            TEST_ASSERT(locate(Source, offset) == index.locate(offset))
+
+        TEST_ASSERT(locate("", 0) == at(1, 1))
+        TEST_ASSERT(std::format("{}", at(3, 7)) == "3:7")
+    })
+
+
+    TEST(diagnostics, {
+        /* an unterminated string spanning lines points at its quote */
+        constexpr std::string_view unterminated { "a: 1\nb: \"x\ny\n" };
+
+        const auto string { try_parse(unterminated) };
+        TEST_ASSERT(string.error().location(unterminated) == at(2, 4))
+        TEST_ASSERT(string.error().message(unterminated)
+                    == "2:4: unterminated string")
+
+        constexpr std::string_view indented { "a:\n    b: 1\n      c: 2\n" };
+
+        const auto indent { try_parse(indented) };
+        TEST_ASSERT(indent.error().code == ErrorCode::InconsistentIndentation)
+        TEST_ASSERT(indent.error().location(indented) == at(3, 7))
+    })
+}
+
+
+auto
+main() -> int
+{
+    test::index();
+    test::lazy();
+    test::diagnostics();
+    return 0;
+}
@@ -0,0 +1,197 @@
+#include <koncpp/memory.hh>
+#include <koncpp/parser.hh>
+
+#include <cstdlib>
+#include <new>
+
+#include "_.hh"
+
+
+namespace
+{
+    std::size_t allocations {};
+}
+
+
+auto
+operator new(std::size_t size) -> void *
+{
+    allocations++;
+    if (auto *ptr { std::malloc(size == 0 ? 1 : size) }) return ptr;
+    throw std::bad_alloc {};
+}
+
+
+void
+operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+
+void
+operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+
+namespace test
+{
+    using namespace koncpp;
+    using namespace koncpp::types;
+
+    using Allocator = AccountingAllocator<char>;
+    using Doc       = Value<Allocator>;
+    using ArenaDoc  = Value<ArenaAllocator<char>>;
+
+
+    constexpr std::string_view Source { R"(name: "short"
+description: "a string that is too long for the small string buffer"
+ports: [ 80, 443, 8080 ]
+limits:
+    memory: 1024
+    ratio: 0.5
+    enabled: true
+)" };
+
+
+    TEST(accounting, {
+        MemoryAccount account;
+        {
+            MemoryAccount::Scope scope { account };
+            const auto           doc { parse<Allocator>(Source) };
+
+            TEST_ASSERT(account.live() > 0)
+            TEST_ASSERT(account.live() == doc.memory_usage().bytes)
+            TEST_ASSERT(account.peak() >= account.live())
+            TEST_ASSERT(account.allocations() > 0)
+        }
+
+        /* freeing goes back to the account even outside the scope */
+        TEST_ASSERT(account.live() == 0)
+        TEST_ASSERT(account.allocations() == 0)
+        TEST_ASSERT(account.peak() > 0)
+
+        account.reset_peak();
+        TEST_ASSERT(account.peak() == 0)
+        TEST_ASSERT(MemoryAccount::current() == nullptr)
+    })
+
+
+    TEST(nested_scopes, {
+        MemoryAccount outer;
+        MemoryAccount inner;
+
+        MemoryAccount::Scope outer_scope { outer };
+        {
+            MemoryAccount::Scope inner_scope { inner };
+            TEST_ASSERT(MemoryAccount::current() == &inner)
+        }
+        TEST_ASSERT(MemoryAccount::current() == &outer)
+
+        Doc doc;
+        doc.insert("a key that does not fit in place", Integer { 1 });
+        TEST_ASSERT(outer.live() == doc.memory_usage().bytes)
+        TEST_ASSERT(inner.live() == 0)
+    })
+
+
+    TEST(usage, {
+        const auto usage { parse(Source).memory_usage() };
+
+        TEST_ASSERT(usage.count(ValueType::Object) == 2)
+        TEST_ASSERT(usage.count(ValueType::Array) == 1)
+        TEST_ASSERT(usage.count(ValueType::Integer) == 4)
+        TEST_ASSERT(usage.count(ValueType::Float) == 1)
+        TEST_ASSERT(usage.count(ValueType::Boolean) == 1)
+        TEST_ASSERT(usage.count(ValueType::String) == 2)
+
+        /* seven keys and "short" fit the first bucket */
+        TEST_ASSERT(usage.strings[0] == 8)
+        TEST_ASSERT(usage.strings[1] == 1)
+        TEST_ASSERT(usage.bytes > 0)
+
+        TEST_ASSERT(MemoryUsage::bucket(0) == 0)
+        TEST_ASSERT(MemoryUsage::bucket(16) == 1)
+        TEST_ASSERT(MemoryUsage::bucket(1 << 20) == 4)
+        TEST_ASSERT(Value<> {}.memory_usage().count(ValueType::Null) == 1)
+    })
+
+
+    TEST(arena, {
+        Arena arena;
+        TEST_ASSERT(arena.capacity() == 0)
+
+        auto *small { arena.allocate(3, 1) };
+        auto *aligned { arena.allocate(8, 8) };
+        TEST_ASSERT(reinterpret_cast<std::uintptr_t>(aligned) % 8 == 0)
+        TEST_ASSERT(static_cast<char *>(aligned) > static_cast<char *>(small))
+        TEST_ASSERT(arena.capacity() == Arena::BlockSize)
+
+        /* larger than a block */
+        (void)arena.allocate(Arena::BlockSize * 2, 16);
+        TEST_ASSERT(arena.capacity() > Arena::BlockSize * 3)
+
+        const auto used { arena.used() };
+        arena.reset();
+        TEST_ASSERT(arena.used() == 0)
+        TEST_ASSERT(arena.high_water() == used)
+        TEST_ASSERT(arena.capacity() > Arena::BlockSize * 3)
+
+        arena.shrink_to_fit();
+        TEST_ASSERT(arena.capacity() == 0)
+        TEST_ASSERT(arena.high_water() == used)
+
+        /* blocks beyond the limit are freed by a reset */
+        arena.set_retain_limit(Arena::BlockSize);
+        (void)arena.allocate(Arena::BlockSize, 1);
+        (void)arena.allocate(Arena::BlockSize, 1);
+        arena.reset();
+        TEST_ASSERT(arena.capacity() == Arena::BlockSize)
+    })
+
+
+    /* Once the parser, the builder and the arena have grown to fit a
+       document, parsing it again does not allocate. */
+    TEST(steady_state, {
+        Parser                        parser;
+        Arena                         arena;
+        Builder<ArenaAllocator<char>> builder;
+
+        std::size_t counts[3] {};
+        for (auto &count : counts)
+        {
+            const auto before { allocations };
+            {
+                Arena::Scope scope { arena };
+                parser.parse(Source, builder);
+
+                const auto doc { builder.take() };
+                TEST_ASSERT(
+                    *doc.at("limits").at("memory").get<Integer<>>().get()
+                    == 1024)
+            }
+
+            count = allocations - before;
+            arena.reset();
+        }
+
+        TEST_ASSERT(counts[0] > 0)
+        TEST_ASSERT(counts[1] == 0)
+        TEST_ASSERT(counts[2] == 0)
+        TEST_ASSERT(ArenaDoc {}.memory_usage().bytes == 0)
+    })
+}
+
+
+auto
+main() -> int
+{
+    test::accounting();
+    test::nested_scopes();
+    test::usage();
+    test::arena();
+    test::steady_state();
+    return 0;
+}
@@ -0,0 +1,621 @@
+#include <koncpp/parser.hh>
+
+#include "_.hh"
+
+
+namespace test
+{
+    using namespace koncpp;
+    using namespace koncpp::types;
+
+
+    constexpr std::string_view Source { R"(/* multi-line comment */
+// single-line comment
+
+object:
+    string: "Hello, World!"
+    uint: 12
+    int: -5
+    float: 25.555
+    bool: true
+    bool-int: 1 // this is true
+
+    array-int: [ 0, 1, 2, 3, 4, 5 ] // an array can only contain a single data type
+
+    nested:
+        value: null
+
+object-dot.string: "Awesome!"
+
+single-line: { string: "Hell"; int: 10 }
+)" };
+
+
+    auto
+    string_of(const Value<> &value) -> std::string
+    {
+        return std::string { *value.get<Value<>::StringType>().view() };
+    }
+
+
+    auto
+    int_of(const Value<> &value) -> Signed
+    {
+        return *value.get<Integer<>>().get();
+    }
+
+
+    TEST(document, {
+        const auto doc { parse(Source) };
+
+        const auto &object { doc.at("object") };
+        TEST_ASSERT(string_of(object.at("string")) == "Hello, World!")
+        TEST_ASSERT(int_of(object.at("uint")) == 12)
+        TEST_ASSERT(int_of(object.at("int")) == -5)
+        TEST_ASSERT(*object.at("float").get<Float>().get() == 25.555)
+        TEST_ASSERT(*object.at("bool").get<Boolean>().get())
+        TEST_ASSERT(int_of(object.at("bool-int")) == 1)
+        TEST_ASSERT(object.at("array-int").size() == 6)
+        TEST_ASSERT(int_of(object.at("array-int").at(5)) == 5)
+        TEST_ASSERT(object.at("nested").at("value").is_null())
+
+        TEST_ASSERT(string_of(doc.at("object-dot").at("string")) == "Awesome!")
+        TEST_ASSERT(string_of(doc.at("single-line").at("string")) == "Hell")
+        TEST_ASSERT(int_of(doc.at("single-line").at("int")) == 10)
+    })
+
+
+    TEST(strings, {
+        const auto doc { parse(R"(raw: "Path C:\User\Docs"
+escaped: "Line1\nLine2\t\"q\"\\"
+multi-line: "Hello,
+ World!"
+non-multi: "Hello,"
+    " World!"
+)") };
+
+        TEST_ASSERT(string_of(doc.at("raw")) == R"(Path C:\User\Docs)")
+        TEST_ASSERT(string_of(doc.at("escaped")) == "Line1\nLine2\t\"q\"\\")
+        TEST_ASSERT(string_of(doc.at("multi-line")) == "Hello,\n World!")
+        TEST_ASSERT(string_of(doc.at("non-multi")) == "Hello, World!")
+    })
+
+
+    TEST(numbers, {
+        const auto doc { parse("a: 9223372036854775807\n"
+                               "b: 18446744073709551615\n"
+                               "c: -1.5e3\n"
+                               "d: +7\n") };
+
+        TEST_ASSERT(int_of(doc.at("a")) == std::numeric_limits<Signed>::max())
+        TEST_ASSERT(*doc.at("b").get<Integer<Unsigned>>().get()
+                    == std::numeric_limits<Unsigned>::max())
+        TEST_ASSERT(*doc.at("c").get<Float>().get() == -1500.0)
+        TEST_ASSERT(int_of(doc.at("d")) == 7)
+
+        TEST_THROWS(auto _ = parse("a: 99999999999999999999\n"), ParseError)
+        TEST_THROWS(auto _ = parse("a: -\n"), ParseError)
+    })
+
+
+    TEST(dot_notation, {
+        const auto doc { parse("a.b.c: 1\n"
+                               "a.b.d: 2\n"
+                               "a:\n"
+                               "    e: 3\n") };
+
+        TEST_ASSERT(doc.at("a").size() == 2)
+        TEST_ASSERT(int_of(doc.at("a").at("b").at("c")) == 1)
+        TEST_ASSERT(int_of(doc.at("a").at("b").at("d")) == 2)
+        TEST_ASSERT(int_of(doc.at("a").at("e")) == 3)
+
+        TEST_THROWS(auto _ = parse("a: 1\na.b: 2\n"), ParseError)
+    })
+
+
+    /* Builds what parsing the dotted keys of @p keys should produce. */
+    auto
+    expected_tree(const std::vector<std::string> &keys) -> Value<>
+    {
+        Value<> root { ValueType::Object };
+
+        for (std::size_t i { 0 }; i < keys.size(); i++)
+        {
+            std::string_view key { keys[i] };
+            auto            *node { &root };
+
+            for (auto dot { key.find('.') }; dot != std::string_view::npos;
+                 dot = key.find('.'))
+            {
+                auto *next { node->find(key.substr(0, dot)) };
+                if (next == nullptr)
+                    next = &node->insert(key.substr(0, dot),
+                                         Value<> { ValueType::Object });
+                node = next;
+                key.remove_prefix(dot + 1);
+            }
+
+            node->insert(key, Integer<> { static_cast<Signed>(i) });
+        }
+
+        return root;
+    }
+
+
+    TEST(dotted_prefixes, {
+        std::vector<std::string> keys;
+        std::string              source;
+
+        /* repeated and alternating prefixes, in objects large enough to
+           be indexed, with some keys written twice */
+        for (std::size_t i { 0 }; i < 3000; i++)
+        {
+            keys.push_back(std::format("s{}.h{}.k{}", i / 1000, (i / 7) % 30,
+                                       (i * 13) % 700));
+            source += std::format("{}: {}\n", keys.back(), i);
+        }
+        for (std::size_t i { 0 }; i < 100; i++)
+        {
+            keys.push_back(std::format("flat{}", i % 60));
+            source += std::format("{}: {}\n", keys.back(), keys.size() - 1);
+        }
+
+        TEST_ASSERT(parse(source) == expected_tree(keys))
+
+        /* prefixes cached inside blocks do not leak out of them */
+        const auto doc { parse("a.x.y: 1\n"
+                               "b:\n"
+                               "    x.y: 2\n"
+                               "    x.z: 3\n"
+                               "a.x.z: 4\n"
+                               "b.x.w: 5\n") };
+
+        TEST_ASSERT(int_of(doc.at("a").at("x").at("z")) == 4)
+        TEST_ASSERT(doc.at("a").at("x").size() == 2)
+        TEST_ASSERT(doc.at("b").at("x").size() == 3)
+        TEST_ASSERT(int_of(doc.at("b").at("x").at("w")) == 5)
+
+        /* a cached prefix whose object was replaced */
+        TEST_THROWS(auto _ = parse("a.b.c: 1\na.b: 2\na.b.d: 3\n"),
+                    ParseError)
+        TEST_THROWS(auto _ = parse("a.b.c: 1\na.b: [ 1 ]\na.b.d: 3\n"),
+                    ParseError)
+    })
+
+
+    TEST(errors, {
+        TEST_THROWS(auto _ = parse("1key: 1\n"), ParseError)
+        TEST_THROWS(auto _ = parse("key 1\n"), ParseError)
+        TEST_THROWS(auto _ = parse("key: [ 1, \"a\" ]\n"), ParseError)
+        TEST_THROWS(auto _ = parse("key: \"open\n"), ParseError)
+        TEST_THROWS(auto _ = parse("key: 1 2\n"), ParseError)
+        TEST_THROWS(auto _ = parse("key: /* open\n"), ParseError)
+        TEST_THROWS(auto _ = parse("key: { a: 1 b: 2 }\n"), ParseError)
+        TEST_THROWS(auto _ = parse("a:\n    b: 1\n      c: 2\n"), ParseError)
+
+        try
+        {
+            auto _ = parse("key: 1\nother: what\n");
+            TEST_ASSERT(false)
+        }
+        catch (const ParseError &e)
+        {
+            TEST_ASSERT(e.offset() == 14)
+        }
+    })
+
+
+    /* A member holding @p arrays arrays nested in each other. */
+    auto
+    nested_arrays(std::size_t arrays) -> std::string
+    {
+        return "a: " + std::string(arrays, '[') + "1" + std::string(arrays, ']')
+             + "\n";
+    }
+
+
+    /* A member holding @p objects block objects nested in each other. */
+    auto
+    nested_blocks(std::size_t objects) -> std::string
+    {
+        std::string source;
+        for (std::size_t i { 0 }; i < objects; i++)
+            source += std::string(i, ' ') + "a:\n";
+        return source + std::string(objects, ' ') + "b: 1\n";
+    }
+
+
+    auto
+    error_code(const std::string &source) -> ErrorCode
+    {
+        const auto result { try_parse(source) };
+        return result ? ErrorCode::InvalidValue : result.error().code;
+    }
+
+
+    TEST(depth, {
+        /* the document is a level of its own */
+        TEST_ASSERT(try_parse(nested_arrays(MaxDepth - 1)).has_value())
+        TEST_ASSERT(error_code(nested_arrays(MaxDepth))
+                    == ErrorCode::NestingTooDeep)
+        TEST_ASSERT(error_code(nested_arrays(100000))
+                    == ErrorCode::NestingTooDeep)
+
+        TEST_ASSERT(try_parse(nested_blocks(MaxDepth - 1)).has_value())
+        TEST_ASSERT(error_code(nested_blocks(MaxDepth))
+                    == ErrorCode::NestingTooDeep)
+    })
+
+
+    /* A block comment of @p size bytes full of lone '*' and '/'. */
+    auto
+    with_comment(std::size_t size) -> std::string
+    {
+        std::string source { "/*" };
+        for (std::size_t i { 0 }; i < size; i++)
+            source.push_back("* /\n"[i % 4]);
+        return source + "*/ a: 1 /* b: 2 */\n";
+    }
+
+
+    TEST(comments, {
+        /* the end of the comment at every position within a vector */
+        for (std::size_t size { 0 }; size < 64; size++)
+        {
+            const auto doc { parse(with_comment(size)) };
+            TEST_ASSERT(doc.size() == 1)
+            TEST_ASSERT(int_of(doc.at("a")) == 1)
+        }
+
+        TEST_ASSERT(parse("a: 1 /**/\n").size() == 1)
+        TEST_ASSERT(parse("a: /* **/ 1\n").size() == 1)
+        TEST_THROWS(auto _ = parse("a: 1 /*/\n"), ParseError)
+        TEST_THROWS(auto _ = parse(std::string(100, '*').insert(0, "/*")),
+                    ParseError)
+    })
+
+
+    auto
+    parse_tabs(std::string_view source, std::size_t tab_width) -> Value<>
+    {
+        Parser    parser { tab_width };
+        Builder<> builder;
+
+        parser.parse(source, builder);
+        return builder.take();
+    }
+
+
+    /* Nests @p depth objects, indented by @p step spaces each. */
+    auto
+    nested(std::size_t depth, std::size_t step) -> std::string
+    {
+        std::string source;
+        for (std::size_t i { 0 }; i < depth; i++)
+            source += std::string(i * step, ' ') + "k:\n";
+        return source + std::string(depth * step, ' ') + "v: 1\n"
+             + "after: 2\n";
+    }
+
+
+    TEST(indentation, {
+        /* indentation runs across every 64 byte boundary */
+        for (std::size_t step { 1 }; step < 8; step++)
+        {
+            const auto doc { parse(nested(40, step)) };
+
+            const auto *node { &doc };
+            for (std::size_t i { 0 }; i < 40; i++) node = &node->at("k");
+
+            TEST_ASSERT(int_of(node->at("v")) == 1)
+            TEST_ASSERT(int_of(doc.at("after")) == 2)
+        }
+
+        /* a tab counts as one by default */
+        TEST_ASSERT(parse("a:\n\tb: 1\n c: 2\n").at("a").size() == 2)
+        TEST_THROWS(auto _ = parse("a:\n\tb: 1\n    c: 2\n"), ParseError)
+
+        const auto doc { parse_tabs("a:\n\tb:\n\t  c: 1\n    d: 2\n", 2) };
+        TEST_ASSERT(doc.at("a").at("b").size() == 2)
+        TEST_ASSERT(int_of(doc.at("a").at("b").at("d")) == 2)
+        TEST_THROWS(auto _ = parse_tabs("a:\n\tb: 1\n    c: 2\n", 2),
+                    ParseError)
+        TEST_ASSERT(parse_tabs("a:\n\tb: 1\n    c: 2\n", 4).at("a").size()
+                    == 2)
+
+        /* blank lines and comments do not count */
+        TEST_ASSERT(parse("a:\n\n      \n  /* x */\n  b: 1\n").at("a").size()
+                    == 1)
+    })
+
+
+    auto
+    project(std::string_view source, std::initializer_list<const char *> paths)
+        -> Value<>
+    {
+        std::vector<Path> compiled;
+        for (const auto *path : paths) compiled.emplace_back(path);
+        return parse(source, compiled);
+    }
+
+
+    constexpr std::string_view Record { R"(id: 7
+skipped:
+    text: "not } a ] bracket, \"quoted\" too"
+    lines: "first
+second"
+    joined: "a"
+"b"
+    /* { unbalanced in a comment */
+    deep:
+        items: [
+            { a: 1; b: "]" },
+            { a: 2; b: "}" }
+        ]
+    mixed: [ 1, "not checked" ]
+user:
+    name: "Ann"
+    address: { city: "Oslo"; zip: "0150" }
+    tags: [ "a", "b" ]
+after: { x: 1; y: { z: 2 } }
+)" };
+
+
+    TEST(projection, {
+        const auto doc { project(Record, { "user.name", "user.address.city",
+                                           "after.y", "id" }) };
+
+        TEST_ASSERT(doc.size() == 3)
+        TEST_ASSERT(int_of(doc.at("id")) == 7)
+        TEST_ASSERT(doc.at("user").size() == 2)
+        TEST_ASSERT(string_of(doc.at("user").at("name")) == "Ann")
+        TEST_ASSERT(doc.at("user").at("address").size() == 1)
+        TEST_ASSERT(string_of(doc.at("user").at("address").at("city"))
+                    == "Oslo")
+        TEST_ASSERT(doc.at("after").size() == 1)
+        TEST_ASSERT(int_of(doc.at("after").at("y").at("z")) == 2)
+
+        /* whole subtrees, and the same from a full parse */
+        const auto full { parse(Source) };
+        const auto part { project(Source, { "object.nested", "object-dot",
+                                            "single-line" }) };
+        TEST_ASSERT(part.at("object").size() == 1)
+        TEST_ASSERT(part.at("object").at("nested")
+                    == full.at("object").at("nested"))
+        TEST_ASSERT(part.at("object-dot") == full.at("object-dot"))
+        TEST_ASSERT(part.at("single-line") == full.at("single-line"))
+
+        /* objects that hold nothing requested are left out */
+        TEST_ASSERT(project(Record, { "user.phone", "skipped.deep.x" }).size()
+                    == 0)
+        /* paths do not lead into arrays */
+        TEST_ASSERT(project(Record, { "skipped.deep.items.a" }).size() == 0)
+
+        /* an empty path asks for everything, no path for nothing */
+        TEST_ASSERT(project(Source, { "" }) == full)
+        TEST_ASSERT(project(Source, {}).type() == ValueType::Object)
+        TEST_ASSERT(project(Source, {}).size() == 0)
+
+        /* dotted keys are matched segment by segment */
+        const auto dotted { project("a.b.c: 1\na.b.d: 2\na.e: 3\n",
+                                    { "a.b.d", "a.e" }) };
+        TEST_ASSERT(dotted.at("a").size() == 2)
+        TEST_ASSERT(dotted.at("a").at("b").size() == 1)
+        TEST_ASSERT(int_of(dotted.at("a").at("b").at("d")) == 2)
+
+        /* what is parsed is still checked */
+        TEST_THROWS(auto _ = project("a: [ 1, \"b\" ]\n", { "a" }), ParseError)
+        TEST_THROWS(auto _ = project("a: \"open\n", { "b" }), ParseError)
+        TEST_THROWS(auto _ = project("a: 1 2\nb: 1\n", { "a" }), ParseError)
+    })
+
+
+    TEST(expected, {
+        TEST_ASSERT(try_parse(Source).value() == parse(Source))
+
+        const auto mixed { try_parse("key: [ 1, \"a\" ]\n") };
+        TEST_ASSERT(mixed.error().code == ErrorCode::MixedArray)
+        TEST_ASSERT(mixed.error().offset == 10)
+        TEST_ASSERT(mixed.error().message() == std::format(
+                        "{} at byte 10", describe(ErrorCode::MixedArray)))
+
+        const auto number { try_parse("a: 99999999999999999999\n") };
+        TEST_ASSERT(number.error().code == ErrorCode::IntegerOutOfRange)
+
+        /* errors from the Builder */
+        const auto conflict { try_parse("a: 1\na.b: 2\n") };
+        TEST_ASSERT(conflict.error().code == ErrorCode::InvalidValue)
+
+        try
+        {
+            auto _ = parse("key 1\n");
+            TEST_ASSERT(false)
+        }
+        catch (const ParseError &e)
+        {
+            TEST_ASSERT(e.code() == ErrorCode::ExpectedColon)
+        }
+    })
+
+
+    /* Counts the events it receives. */
+    class Counter : public Handler
+    {
+    public:
+        std::size_t events {};
+
+        void key(std::string_view) override { events++; }
+        void begin_object() override { events++; }
+        void end_object() override { events++; }
+        void begin_array() override { events++; }
+        void end_array() override { events++; }
+        void null() override { events++; }
+        void integer(Signed) override { events++; }
+        void unsigned_integer(Unsigned) override { events++; }
+        void floating(double) override { events++; }
+        void boolean(bool) override { events++; }
+        void string(std::string_view) override { events++; }
+    };
+
+
+    /* Whether try_parse() rejects @p source as parse() does. */
+    auto
+    rejects_alike(std::string_view source) -> bool
+    {
+        const auto result { try_parse(source) };
+
+        try
+        {
+            (void)parse(source);
+        }
+        catch (const ParseError &error)
+        {
+            return !result && result.error().code == error.code()
+                && result.error().offset == error.offset();
+        }
+        return false;
+    }
+
+
+    TEST(rejection, {
+        TEST_ASSERT(rejects_alike("a: \"open\n"))
+        TEST_ASSERT(rejects_alike("a: \"x\" \"y\n"))
+        TEST_ASSERT(rejects_alike("a: 1e\n"))
+        TEST_ASSERT(rejects_alike("a: -99999999999999999999\n"))
+        TEST_ASSERT(rejects_alike("a:\n    b: 1\n  c: 2\n"))
+        TEST_ASSERT(rejects_alike("a: { b: [ 1 }\n"))
+        TEST_ASSERT(rejects_alike("a: [ { b: 1 }, 2 ]\n"))
+
+        /* nothing is reported after the error */
+        Parser  parser;
+        Counter counter;
+        TEST_ASSERT(!parser.try_parse("a: 1\nb: [ 1, 2\n", counter))
+        TEST_ASSERT(counter.events == 7)
+    })
+
+
+    /* The counters are only filled in by a statistics build. */
+    auto
+    stats_valid(const ParseStats &stats, const Value<> &doc) -> bool
+    {
+#ifdef KONCPP_STATS
+        return stats.bytes == Source.size() && stats.tokens > doc.size()
+            && stats.allocations > 0
+            && stats.allocated_bytes >= stats.allocations
+            && stats.total
+                   == stats.scan + stats.parse + stats.unescape + stats.number
+                          + stats.build;
+#else
+        return doc.size() > 0 && stats == ParseStats {};
+#endif
+    }
+
+
+    TEST(stats, {
+        const auto parsed { parse_with_stats(Source) };
+        TEST_ASSERT(parsed.document == parse(Source))
+        TEST_ASSERT(stats_valid(parsed.stats, parsed.document))
+    })
+
+
+    /* Mostly skipped values, made of comments and adjacent strings. */
+    auto
+    skipped_source() -> std::string
+    {
+        const std::string comment { "/*" + std::string(10000, ']') + "*/" };
+
+        std::string source;
+        for (int i { 0 }; i < 100; i++)
+        {
+            source += "skip" + std::to_string(i) + ": [ " + comment
+                    + " \"a\"\n" + comment + " \"b\" ]\n";
+        }
+        return source + "keep: 1\n";
+    }
+
+
+    /* The phases do not overlap, what is left of the total is parsing. */
+    auto
+    phases_valid(const ParseStats &stats) -> bool
+    {
+#ifdef KONCPP_STATS
+        return stats.scan > ParseStats::Duration {}
+            && stats.parse >= ParseStats::Duration {}
+            && stats.total
+                   == stats.scan + stats.parse + stats.unescape + stats.number
+                          + stats.build;
+#else
+        return stats == ParseStats {};
+#endif
+    }
+
+
+    TEST(projected_stats, {
+        const auto source { skipped_source() };
+        const Path path { "keep" };
+
+        Parser     parser;
+        Builder<>  builder;
+        ParseStats stats;
+        parser.parse(source, builder, std::span { &path, 1 }, stats);
+        TEST_ASSERT(builder.take().at("keep") == Value<> { Integer { 1 } })
+        TEST_ASSERT(phases_valid(stats))
+    })
+
+
+    /* Parses @p source with a parser and builder that were used before. */
+    auto
+    reparse(Parser &parser, Builder<> &builder, std::string_view source)
+        -> Value<>
+    {
+        parser.parse(source, builder);
+        return builder.take();
+    }
+
+
+    TEST(reuse, {
+        std::string large;
+        for (std::size_t i { 0 }; i < 100; i++)
+            large += std::format("k{}: \"{}\\n\"\n", i, i);
+
+        Parser    parser;
+        Builder<> builder;
+
+        for (std::size_t i { 0 }; i < 3; i++)
+        {
+            TEST_ASSERT(reparse(parser, builder, large) == parse(large))
+            TEST_ASSERT(reparse(parser, builder, Source) == parse(Source))
+        }
+
+        TEST_ASSERT(parser.retained() > Parser {}.retained())
+        parser.shrink_to_fit();
+        TEST_ASSERT(parser.retained() == Parser {}.retained())
+
+        /* a large document does not keep its scratch storage */
+        parser.set_retain_limit(64);
+        TEST_ASSERT(reparse(parser, builder, large) == parse(large))
+        TEST_ASSERT(parser.retained() <= 64)
+    })
+}
+
+
+auto
+main() -> int
+{
+    test::document();
+    test::strings();
+    test::numbers();
+    test::dot_notation();
+    test::dotted_prefixes();
+    test::errors();
+    test::depth();
+    test::comments();
+    test::indentation();
+    test::projection();
+    test::expected();
+    test::rejection();
+    test::stats();
+    test::projected_stats();
+    test::reuse();
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include <koncpp/parser.hh>
+#include <koncpp/path.hh>
+
+#include "_.hh"
+
+
+namespace test
+{
+    using namespace koncpp;
+    using namespace koncpp::literals;
+    using namespace koncpp::types;
+
+
+    auto
+    int_of(const Value<> &value) -> Signed
+    {
+        return *value.get<Integer<>>().get();
+    }
+
+
+    constexpr auto Port { "port"_k };
+    static_assert(Port.hash == hash_key("port"));
+    static_assert(Port.name == "port");
+
+
+    TEST(keys, {
+        const auto doc { parse("server:\n"
+                               "    host: \"localhost\"\n"
+                               "    port: 8080\n"
+                               "object-dot.string: \"Awesome!\"\n") };
+
+        TEST_ASSERT(int_of(doc["server"_k][Port]) == 8080)
+        TEST_ASSERT(&doc["server"_k] == &doc.at("server"))
+        TEST_ASSERT(doc.find("missing"_k) == nullptr)
+        TEST_ASSERT(doc["server"_k].find("por"_k) == nullptr)
+        TEST_THROWS(auto _ = doc["missing"_k], ValueError)
+        TEST_THROWS(auto _ = doc["server"_k][Port]["deeper"_k], ValueError)
+    })
+
+
+    TEST(paths, {
+        auto doc { parse("server.http.port: 8080\n"
+                         "object-dot.string: \"Awesome!\"\n") };
+
+        const Path port { "server.http.port" };
+        TEST_ASSERT(port.size() == 3)
+        TEST_ASSERT(port[1].name == "http")
+        TEST_ASSERT(port[1].hash == hash_key("http"))
+        TEST_ASSERT(port.text() == "server.http.port")
+
+        TEST_ASSERT(int_of(doc[port]) == 8080)
+        TEST_ASSERT(doc.find(Path { "object-dot.string" }) != nullptr)
+        TEST_ASSERT(doc.find(Path { "server.http.host" }) == nullptr)
+        TEST_ASSERT(doc.find(Path { "server..port" }) == nullptr)
+        TEST_ASSERT(doc.find(Path {}) == &doc)
+        TEST_THROWS(auto _ = doc.at(Path { "server.port" }), ValueError)
+
+        /* a copied path does not refer to the original's text */
+        auto copy { std::make_unique<Path>(port) };
+        const auto moved { std::move(*copy) };
+        copy.reset();
+        TEST_ASSERT(int_of(doc[moved]) == 8080)
+
+        /* members inserted later are found by their hash as well */
+        doc.at("server").insert("tls", Boolean { true });
+        TEST_ASSERT(*doc[Path { "server.tls" }].get<Boolean>().get())
+    })
+
+
+    TEST(members, {
+        /* a member added to the object directly is hashed as well */
+        Value<> doc;
+        doc.insert("a", Integer { 1 });
+        doc.get<Value<>::Object>().push_back({ "b", Integer { 2 } });
+
+        TEST_ASSERT(int_of(doc.at("b")) == 2)
+        TEST_ASSERT(int_of(doc["b"_k]) == 2)
+
+        Value<> inserted;
+        inserted.insert("a", Integer { 1 });
+        inserted.insert("b", Integer { 2 });
+        TEST_ASSERT(doc == inserted)
+    })
+}
+
+
+auto
+main() -> int
+{
+    test::keys();
+    test::paths();
+    test::members();
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include <koncpp/persistent.hh>
+
+#include "_.hh"
+
+
+namespace test
+{
+    using namespace koncpp;
+    using namespace koncpp::types;
+
+    using Doc  = Value<>;
+    using PDoc = PersistentValue<>;
+
+
+    auto
+    make_base() -> PDoc
+    {
+        Doc http;
+        http.insert("timeout", Integer { 30 });
+        http.insert("retries", Integer { 3 });
+
+        Doc tls;
+        tls.insert("enabled", Boolean { true });
+
+        Doc ports;
+        ports.push_back(Integer { 80 });
+        ports.push_back(Integer { 443 });
+
+        Doc document;
+        document.insert("http", http);
+        document.insert("tls", tls);
+        document.insert("ports", ports);
+        document.insert("name", Doc::StringType { "base" });
+        return document;
+    }
+
+
+    auto
+    timeout(const PDoc &document) -> Signed
+    {
+        return *document.at("http").at("timeout").get<Integer<>>().get();
+    }
+
+
+    TEST(conversion, {
+        const auto base { make_base() };
+
+        TEST_ASSERT(base.type() == ValueType::Object)
+        TEST_ASSERT(base.size() == 4)
+        TEST_ASSERT(timeout(base) == 30)
+        TEST_ASSERT(*base.at("ports").at(1).get<Integer<>>().get() == 443)
+        TEST_ASSERT(base.find("missing") == nullptr)
+
+        const auto value { base.to_value() };
+        TEST_ASSERT(value.size() == 4)
+        TEST_ASSERT(PDoc { value }.to_value().at("tls") == value.at("tls"))
+
+        /* a packed array comes back boxed, with the same booleans */
+        BooleanArray flags;
+        flags.push_back(true);
+        flags.push_back(std::nullopt);
+        const Doc packed { flags };
+        TEST_ASSERT(PDoc { packed }.size() == 2)
+        TEST_ASSERT(PDoc { packed }.to_value() == packed)
+    })
+
+
+    TEST(sharing, {
+        const auto base { make_base() };
+        const auto tenant { base.with("http.timeout", Doc { Integer { 60 } }) };
+
+        TEST_ASSERT(timeout(base) == 30)
+        TEST_ASSERT(timeout(tenant) == 60)
+
+        /* unchanged subtrees are shared, not copied */
+        TEST_ASSERT(tenant.at("tls").identical(base.at("tls")))
+        TEST_ASSERT(tenant.at("ports").identical(base.at("ports")))
+        TEST_ASSERT(tenant.at("http")
+                        .at("retries")
+                        .identical(base.at("http").at("retries")))
+        TEST_ASSERT(!tenant.at("http").identical(base.at("http")))
+    })
+
+
+    TEST(paths, {
+        const auto base { make_base() };
+
+        const auto created { base.with("a.b.c", Doc { Boolean { true } }) };
+        TEST_ASSERT(*created.at("a").at("b").at("c").get<Boolean>().get())
+        TEST_ASSERT(base.find("a") == nullptr)
+
+        const auto port { base.with("ports.0", Doc { Integer { 8080 } }) };
+        TEST_ASSERT(*port.at("ports").at(0).get<Integer<>>().get() == 8080)
+        TEST_ASSERT(*base.at("ports").at(0).get<Integer<>>().get() == 80)
+
+        TEST_THROWS(auto _ = base.with("ports.5", PDoc {}), ValueError)
+        TEST_THROWS(auto _ = base.with("ports.x", PDoc {}), ValueError)
+        TEST_THROWS(auto _ = base.with("name.x", PDoc {}), ValueError)
+        TEST_THROWS(auto _ = base.with("ports.0", Doc { Float { 1.0 } }),
+                    ValueError)
+
+        const auto removed { base.without("http.retries") };
+        TEST_ASSERT(removed.at("http").size() == 1)
+        TEST_ASSERT(base.at("http").size() == 2)
+    })
+
+
+    TEST(large, {
+        PDoc::Object object;
+        PDoc::Array  array;
+
+        for (int i { 0 }; i < 5000; i++)
+        {
+            object = object.assoc(std::format("key-{}", i),
+                                  Doc { Integer { i } });
+            array  = array.push_back(Doc { Integer { i } });
+        }
+
+        TEST_ASSERT(object.size() == 5000)
+        TEST_ASSERT(array.size() == 5000)
+
+        bool found { true };
+        for (int i { 0 }; i < 5000; i++)
+        {
+            const auto *v { object.find(std::format("key-{}", i)) };
+            found = found && v != nullptr
+                 && *v->get<Integer<>>().get() == i
+                 && *array.at(i).get<Integer<>>().get() == i;
+        }
+        TEST_ASSERT(found)
+
+        const auto smaller { object.erase("key-42") };
+        TEST_ASSERT(smaller.size() == 4999)
+        TEST_ASSERT(smaller.find("key-42") == nullptr)
+        TEST_ASSERT(object.find("key-42") != nullptr)
+
+        const auto changed { array.set(4321, Doc { Integer { -1 } }) };
+        TEST_ASSERT(*changed.at(4321).get<Integer<>>().get() == -1)
+        TEST_ASSERT(*array.at(4321).get<Integer<>>().get() == 4321)
+    })
+}
+
+
+auto
+main() -> int
+{
+    test::conversion();
+    test::sharing();
+    test::paths();
+    test::large();
+    return 0;
+}
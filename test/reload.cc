@@ -0,0 +1,195 @@
+#include <koncpp/reload.hh>
+
+#include <chrono>
+#include <fstream>
+
+#include "_.hh"
+
+
+namespace test
+{
+    using namespace koncpp;
+    using namespace koncpp::types;
+
+    using Config = Reloadable<>;
+
+
+    const auto path { std::filesystem::temp_directory_path()
+                      / "koncpp-reload-test.kon" };
+
+
+    void
+    write(int value)
+    {
+        std::ofstream { path } << value;
+    }
+
+
+    auto
+    load(const std::filesystem::path &file) -> Value<>
+    {
+        int value {};
+        if (!(std::ifstream { file } >> value))
+            throw Exception { "failed to read {}", file.string() };
+
+        Value<> document;
+        document.insert("value", Integer { value });
+        return document;
+    }
+
+
+    auto
+    value_of(const Config::Reader &reader) -> Signed
+    {
+        return *reader->at("value").get<Integer<>>().get();
+    }
+
+
+    TEST(snapshot, {
+        write(1);
+        Config config(path, load);
+
+        auto reader { config.reader() };
+        TEST_ASSERT(value_of(reader) == 1)
+
+        const auto &old { reader.get() };
+
+        write(2);
+        config.reload();
+        TEST_ASSERT(value_of(reader) == 2)
+
+        /* the old snapshot is kept alive until the reader is quiescent */
+        TEST_ASSERT(*old.at("value").get<Integer<>>().get() == 1)
+
+        reader.quiescent();
+        config.collect();
+
+        write(3);
+        config.reload();
+        reader.quiescent();
+        config.collect();
+        TEST_ASSERT(value_of(reader) == 3)
+    })
+
+
+    TEST(failed_reload, {
+        write(4);
+        Config config(path, load);
+
+        std::ofstream { path } << "not a number";
+        TEST_THROWS(config.reload(), Exception)
+
+        auto reader { config.reader() };
+        TEST_ASSERT(value_of(reader) == 4)
+    })
+
+
+    TEST(listener, {
+        write(5);
+        Config config(path, load);
+
+        Signed          previous {};
+        Signed          current {};
+        Config::Changes changes;
+        config.on_reload(
+            [&](const Value<> &a, const Value<> &b, const Config::Changes &c)
+            {
+                previous = *a.at("value").get<Integer<>>().get();
+                current  = *b.at("value").get<Integer<>>().get();
+                changes  = c;
+            });
+
+        write(6);
+        config.reload();
+        TEST_ASSERT(previous == 5)
+        TEST_ASSERT(current == 6)
+        TEST_ASSERT(changes.size() == 1)
+        TEST_ASSERT(changes[0].path == "value")
+
+        /* the digest kept from the last reload matches the file */
+        config.reload();
+        TEST_ASSERT(changes.empty())
+    })
+
+
+    TEST(throwing_listener, {
+        write(9);
+        Config config(path, load);
+        auto   reader { config.reader() };
+
+        config.on_reload(
+            [](const Value<> &, const Value<> &, const Config::Changes &)
+            { throw Exception { "listener failed" }; });
+
+        /* the reload has taken effect, and the old snapshot is still
+           retired and freed */
+        write(10);
+        TEST_THROWS(config.reload(), Exception)
+        TEST_ASSERT(value_of(reader) == 10)
+
+        reader.quiescent();
+        config.collect();
+    })
+
+
+    TEST(watch, {
+        write(7);
+        Config config(path, load);
+        config.watch();
+
+        auto reader { config.reader() };
+        write(8);
+
+        const auto deadline { std::chrono::steady_clock::now()
+                              + std::chrono::seconds { 5 } };
+        while (value_of(reader) != 8
+               && std::chrono::steady_clock::now() < deadline)
+        {
+            reader.quiescent();
+            std::this_thread::sleep_for(std::chrono::milliseconds { 10 });
+        }
+
+        TEST_ASSERT(value_of(reader) == 8)
+        config.stop();
+    })
+
+
+    TEST(reclamation, {
+        EpochDomain domain;
+        auto       *slot { domain.enter() };
+
+        static int freed {};
+        auto      *ptr { new int { 0 } };
+        domain.retire(ptr,
+                      [](void *p)
+                      {
+                          delete static_cast<int *>(p);
+                          freed++;
+                      });
+
+        domain.collect();
+        TEST_ASSERT(domain.pending() == 1)
+
+        domain.quiescent(*slot);
+        domain.collect();
+        TEST_ASSERT(domain.pending() == 0)
+        TEST_ASSERT(freed == 1)
+
+        domain.leave(slot);
+    })
+}
+
+
+auto
+main() -> int
+{
+    test::snapshot();
+    test::failed_reload();
+    test::listener();
+    test::throwing_listener();
+    test::watch();
+    test::reclamation();
+
+    std::filesystem::remove(test::path);
+    return 0;
+}
@@ -0,0 +1,237 @@
+#include <koncpp/schema.hh>
+
+#include "_.hh"
+
+
+namespace test
+{
+    using namespace koncpp;
+    using namespace koncpp::types;
+
+    using Doc = Value<>;
+
+
+    auto
+    spec(std::string_view type, bool required = false) -> Doc
+    {
+        Doc value;
+        value.insert("type", Doc::StringType { type });
+        value.insert("required", Boolean { required });
+        return value;
+    }
+
+
+    auto
+    make_schema() -> Schema
+    {
+        Doc port { spec("uint", true) };
+        port.insert("min", Integer { 1 });
+        port.insert("max", Integer { 65535 });
+
+        Doc ratio { spec("float") };
+        ratio.insert("max", Float { 1.0 });
+
+        Doc server;
+        server.insert("port", port);
+        server.insert("ratio", ratio);
+        server.insert("debug", Doc::StringType { "bool" });
+
+        Doc document;
+        document.insert("name", spec("string", true));
+        document.insert("count", Doc::StringType { "int" });
+        document.insert("server", server);
+
+        return Schema::compile(document);
+    }
+
+
+    TEST(compile, {
+        const auto schema { make_schema() };
+
+        TEST_ASSERT(schema.rules().size() == 5)
+        TEST_ASSERT(schema.required_count() == 2)
+        TEST_ASSERT(schema.find("server.port") != nullptr)
+        TEST_ASSERT(schema.find("server.port")->is_unsigned)
+        TEST_ASSERT(schema.find("server") == nullptr)
+
+        Doc bad;
+        bad.insert("x", Doc::StringType { "complex" });
+        TEST_THROWS(auto _ = Schema::compile(bad), SchemaError)
+
+        Doc ranged { spec("string") };
+        ranged.insert("min", Integer { 1 });
+        Doc bad_range;
+        bad_range.insert("x", ranged);
+        TEST_THROWS(auto _ = Schema::compile(bad_range), SchemaError)
+    })
+
+
+    TEST(types, {
+        const auto schema { make_schema() };
+        Validator  validator { schema };
+
+        Doc name { Doc::StringType { "kon" } };
+        TEST_ASSERT(validator.feed("name", name))
+
+        Doc wrong { Float { 1.5 } };
+        TEST_ASSERT(!validator.feed("count", wrong))
+        TEST_ASSERT(!validator.error().empty())
+
+        Doc unknown { Float { 1.5 } };
+        TEST_ASSERT(validator.feed("unknown.key", unknown))
+
+        Doc null {};
+        TEST_ASSERT(validator.feed("count", null))
+    })
+
+
+    TEST(coercion, {
+        const auto schema { make_schema() };
+        Validator  validator { schema };
+
+        /* int -> uint */
+        Doc port { Integer { 8080 } };
+        TEST_ASSERT(validator.feed("server.port", port))
+        TEST_ASSERT(port.holds<Integer<Unsigned>>())
+        TEST_ASSERT(*port.get<Integer<Unsigned>>().get() == 8080)
+
+        /* negative uint -> null, SYNTAX.md §2.2.2 */
+        Doc negative { Integer { -1 } };
+        TEST_ASSERT(validator.feed("server.port", negative))
+        TEST_ASSERT(!negative.get<Integer<Unsigned>>().get())
+
+        /* integer-compatible boolean, SYNTAX.md §2.4 */
+        Doc one { Integer { 1 } };
+        Doc zero { Integer { 0 } };
+        TEST_ASSERT(validator.feed("server.debug", one))
+        TEST_ASSERT(validator.feed("server.debug", zero))
+        TEST_ASSERT(*one.get<Boolean>().get() == true)
+        TEST_ASSERT(*zero.get<Boolean>().get() == false)
+    })
+
+
+    TEST(ranges, {
+        const auto schema { make_schema() };
+        Validator  validator { schema };
+
+        Doc low { Integer { 0 } };
+        Doc high { Integer { 70000 } };
+        Doc fine { Integer { 443 } };
+        TEST_ASSERT(!validator.feed("server.port", low))
+        TEST_ASSERT(!validator.feed("server.port", high))
+        TEST_ASSERT(validator.feed("server.port", fine))
+
+        Doc ratio { Float { 1.5 } };
+        TEST_ASSERT(!validator.feed("server.ratio", ratio))
+        ratio = Float { 0.5 };
+        TEST_ASSERT(validator.feed("server.ratio", ratio))
+
+        /* an unsigned too large for an int fails, instead of turning null */
+        Doc huge { Integer<Unsigned> { UINT64_MAX } };
+        TEST_ASSERT(!validator.feed("count", huge))
+        TEST_ASSERT(huge.holds<Integer<Unsigned>>())
+
+        Doc small { Integer<Unsigned> { 5U } };
+        TEST_ASSERT(validator.feed("count", small))
+        TEST_ASSERT(*small.get<Integer<>>().get() == 5)
+
+        Doc limit { spec("int") };
+        limit.insert("max", Integer { 10 });
+        Doc rules;
+        rules.insert("n", limit);
+        const auto limited { Schema::compile(rules) };
+        TEST_ASSERT(!Validator { limited }.feed("n", huge))
+        TEST_THROWS((void)parse("n: 18446744073709551615", limited),
+                    ParseError)
+    })
+
+
+    TEST(required, {
+        const auto schema { make_schema() };
+        Validator  validator { schema };
+
+        Doc port { Integer { 80 } };
+        TEST_ASSERT(validator.feed("server.port", port))
+        TEST_ASSERT(!validator.finish())
+
+        Doc name { Doc::StringType { "kon" } };
+        TEST_ASSERT(validator.feed("name", name))
+        TEST_ASSERT(validator.finish())
+
+        validator.reset();
+        TEST_ASSERT(!validator.finish())
+    })
+
+
+    /* Where parsing @p source against make_schema() fails, or npos. */
+    auto
+    rejected(std::string_view source) -> std::size_t
+    {
+        try
+        {
+            (void)parse(source, make_schema());
+        }
+        catch (const ParseError &error)
+        {
+            return error.offset();
+        }
+        return std::string_view::npos;
+    }
+
+
+    TEST(parsing, {
+        const auto document { parse("name: \"svc\"\n"
+                                    "server:\n"
+                                    "    port: 8080\n"
+                                    "    debug: 1\n"
+                                    "    hosts: [ \"a\", \"b\" ]\n",
+                                    make_schema()) };
+
+        /* coerced while building */
+        const auto &server { document.at("server") };
+        TEST_ASSERT(server.at("port").holds<Integer<Unsigned>>())
+        TEST_ASSERT(*server.at("port").get<Integer<Unsigned>>().get() == 8080)
+        TEST_ASSERT(*server.at("debug").get<Boolean>().get() == true)
+        TEST_ASSERT(server.at("hosts").get<Doc::Array>().size() == 2)
+
+        /* dotted keys are checked by their full path */
+        const auto dotted { parse("name: \"svc\"\nserver.port: 80",
+                                  make_schema()) };
+        TEST_ASSERT(dotted.at("server").at("port").holds<Integer<Unsigned>>())
+        TEST_ASSERT(rejected("name: \"svc\"\nserver.port: 0") == 26)
+    })
+
+
+    TEST(violations, {
+        /* out of range, at the end of the offending value */
+        TEST_ASSERT(rejected("name: \"svc\"\n"
+                             "server:\n"
+                             "    port: 70000\n")
+                    == 35)
+
+        /* of the wrong type, or a container where a value is expected */
+        TEST_ASSERT(rejected("name: 1\nserver.port: 80") == 7)
+        TEST_ASSERT(rejected("name: [ \"a\" ]\nserver.port: 80") == 7)
+
+        /* a required member is missing, at the end */
+        TEST_ASSERT(rejected("server.port: 80") == 15)
+        TEST_ASSERT(rejected("name: \"svc\"") == 11)
+
+        TEST_ASSERT(rejected("name: \"svc\"\nserver.port: 80\nother: [ 1 ]")
+                    == std::string_view::npos)
+    })
+}
+
+
+auto
+main() -> int
+{
+    test::compile();
+    test::types();
+    test::coercion();
+    test::ranges();
+    test::required();
+    test::parsing();
+    test::violations();
+    return 0;
+}
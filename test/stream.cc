@@ -0,0 +1,352 @@
+#include <koncpp/stream.hh>
+
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+#include "_.hh"
+
+
+namespace test
+{
+    using namespace koncpp;
+    using namespace koncpp::types;
+
+    using Member = Value<>::Member;
+
+
+    constexpr std::string_view Source { "/* a header\n"
+                                        "name: 1 */\n"
+                                        "name: \"svc\" // a comment\n"
+                                        "http:\n"
+                                        "    port: 8080\n"
+                                        "    hosts: [ \"a\",\n"
+                                        "\"b\\\"\n"
+                                        "fake: 1\" ]\n"
+                                        "\n"
+                                        "note: \"split\"\n"
+                                        "\" string\"\n"
+                                        "flags: { on: true; off: null }\n"
+                                        "last.one: 2.5" };
+
+
+    auto
+    expected() -> std::vector<Member>
+    {
+        return parse(Source).get<Value<>::Object>();
+    }
+
+
+    /* Feeds @p source in chunks of @p size bytes. */
+    auto
+    chunked(std::string_view source, std::size_t size) -> std::vector<Member>
+    {
+        StreamParser<>      parser;
+        std::vector<Member> members;
+
+        for (std::size_t pos { 0 }; pos < source.size(); pos += size)
+        {
+            parser.feed(source.substr(pos, size));
+            while (auto member { parser.next() })
+                members.push_back(std::move(*member));
+        }
+
+        parser.finish();
+        while (auto member { parser.next() })
+            members.push_back(std::move(*member));
+        return members;
+    }
+
+
+    auto
+    error_offset(std::string_view source, std::size_t size) -> std::size_t
+    {
+        StreamParser<> parser;
+
+        try
+        {
+            for (std::size_t pos { 0 }; pos < source.size(); pos += size)
+                parser.feed(source.substr(pos, size));
+            parser.finish();
+        }
+        catch (const ParseError &error)
+        {
+            return error.offset();
+        }
+        return 0;
+    }
+
+
+    /* Runs the coroutines posted to it, as an event loop would. */
+    struct Executor
+    {
+        std::deque<std::coroutine_handle<>> queue;
+
+
+        void
+        run()
+        {
+            while (!queue.empty())
+            {
+                const auto handle { queue.front() };
+                queue.pop_front();
+                handle.resume();
+            }
+        }
+    };
+
+
+    /* Reads Source in small chunks, each one arriving later. */
+    struct Reader
+    {
+        Executor   *executor;
+        std::size_t pos {};
+        std::size_t size { 7 };
+
+
+        struct Read
+        {
+            Reader *reader;
+
+
+            [[nodiscard]]
+            auto
+            await_ready() const noexcept -> bool
+            {
+                return false;
+            }
+
+
+            void
+            await_suspend(std::coroutine_handle<> handle) const
+            {
+                reader->executor->queue.push_back(handle);
+            }
+
+
+            auto
+            await_resume() const noexcept -> std::string_view
+            {
+                const auto chunk { Source.substr(
+                    std::min(reader->pos, Source.size()), reader->size) };
+                reader->pos += chunk.size();
+                return chunk;
+            }
+        };
+
+
+        auto
+        operator()() -> Read
+        {
+            return Read { this };
+        }
+    };
+
+
+    /* Reads as Reader does, handing out every chunk as its own string. */
+    struct OwningReader
+    {
+        Reader reader;
+
+
+        struct Read
+        {
+            Reader::Read read;
+
+
+            [[nodiscard]]
+            auto
+            await_ready() const noexcept -> bool
+            {
+                return read.await_ready();
+            }
+
+
+            void
+            await_suspend(std::coroutine_handle<> handle) const
+            {
+                read.await_suspend(handle);
+            }
+
+
+            auto
+            await_resume() const -> std::string
+            {
+                return std::string { read.await_resume() };
+            }
+        };
+
+
+        auto
+        operator()() -> Read
+        {
+            return Read { reader() };
+        }
+    };
+
+
+    /* A coroutine started right away and left to the executor. */
+    struct Task
+    {
+        struct promise_type
+        {
+            auto
+            get_return_object() noexcept -> Task
+            {
+                return {};
+            }
+
+
+            auto
+            initial_suspend() const noexcept -> std::suspend_never
+            {
+                return {};
+            }
+
+
+            auto
+            final_suspend() const noexcept -> std::suspend_never
+            {
+                return {};
+            }
+
+
+            void
+            return_void() const noexcept
+            {
+            }
+
+
+            void
+            unhandled_exception() const
+            {
+                std::terminate();
+            }
+        };
+    };
+
+
+    template <typename T_Reader>
+    auto
+    consume(T_Reader read, std::vector<Member> &members, bool &done) -> Task
+    {
+        auto stream { parse_stream(std::move(read)) };
+
+        while (auto member { co_await stream.next() })
+            members.push_back(std::move(*member));
+
+        done = true;
+    }
+
+
+    /* The members of @p lines , each parsed on its own. */
+    auto
+    separately(std::initializer_list<std::string_view> lines)
+        -> std::vector<Member>
+    {
+        std::vector<Member> members;
+        for (const auto line : lines)
+        {
+            auto document { parse(line) };
+            for (auto &member : document.get<Value<>::Object>())
+                members.push_back(std::move(member));
+        }
+        return members;
+    }
+
+
+    TEST(chunks, {
+        for (std::size_t size { 1 }; size <= Source.size(); size++)
+            TEST_ASSERT(chunked(Source, size) == expected())
+    })
+
+
+    TEST(repeated, {
+        constexpr std::string_view Repeated { "a.b: 1\n"
+                                              "a.c: 2\n"
+                                              "a:\n"
+                                              "    d: 3\n"
+                                              "a: 4\n"
+                                              "b: 5" };
+
+        const auto members { separately(
+            { "a.b: 1", "a.c: 2", "a:\n    d: 3", "a: 4", "b: 5" }) };
+        TEST_ASSERT(members.size() == 5)
+
+        /* the same members, however the input is split */
+        for (std::size_t size { 1 }; size <= Repeated.size(); size++)
+            TEST_ASSERT(chunked(Repeated, size) == members)
+    })
+
+
+    TEST(early, {
+        StreamParser<> parser;
+
+        parser.feed("a: 1\n");
+        TEST_ASSERT(!parser.next())
+
+        /* the next key completes a, the adjacent string does not */
+        parser.feed("b: \"x\"\n");
+        TEST_ASSERT(parser.next()->key == "a")
+        parser.feed("\"y\"\n");
+        TEST_ASSERT(!parser.next())
+
+        parser.finish();
+        TEST_ASSERT(parser.next()->value == parse("b: \"xy\"").at("b"))
+        TEST_ASSERT(!parser.next())
+    })
+
+
+    TEST(errors, {
+        constexpr std::string_view Invalid { "a: 1\n"
+                                             "b: [ 1, \"x\" ]\n"
+                                             "c: 2\n" };
+
+        const auto offset { try_parse(Invalid).error().offset };
+        for (std::size_t size { 1 }; size <= Invalid.size(); size++)
+            TEST_ASSERT(error_offset(Invalid, size) == offset)
+
+        TEST_ASSERT(error_offset("a: \"unterminated\n", 4) == 3)
+    })
+
+
+    TEST(coroutine, {
+        Executor            executor;
+        std::vector<Member> members;
+        bool                done {};
+
+        consume(Reader { &executor }, members, done);
+        TEST_ASSERT(!done)
+
+        executor.run();
+        TEST_ASSERT(done)
+        TEST_ASSERT(members == expected())
+    })
+
+
+    TEST(owned_chunks, {
+        Executor            executor;
+        std::vector<Member> members;
+        bool                done {};
+
+        /* too long to be stored inside the string, and gone once the
+           reader is called again */
+        consume(OwningReader { Reader { &executor, 0, 40 } }, members, done);
+        executor.run();
+        TEST_ASSERT(done)
+        TEST_ASSERT(members == expected())
+    })
+}
+
+
+auto
+main() -> int
+{
+    test::chunks();
+    test::repeated();
+    test::early();
+    test::errors();
+    test::coroutine();
+    test::owned_chunks();
+    return 0;
+}
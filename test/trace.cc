@@ -0,0 +1,95 @@
+#include <koncpp/parser.hh>
+#include <koncpp/trace.hh>
+
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include "_.hh"
+
+
+namespace test
+{
+    using namespace koncpp;
+
+    const auto path { std::filesystem::temp_directory_path()
+                      / "koncpp-trace-test.json" };
+
+
+    auto
+    read_trace() -> std::string
+    {
+        std::stringstream contents;
+        contents << std::ifstream { path }.rdbuf();
+        return contents.str();
+    }
+
+
+    auto
+    occurrences(std::string_view text, std::string_view word) -> std::size_t
+    {
+        std::size_t result {};
+        for (auto pos { text.find(word) }; pos != std::string_view::npos;
+             pos = text.find(word, pos + word.size()))
+            result++;
+        return result;
+    }
+
+
+    void
+    parse_twice()
+    {
+        (void)parse("a: 1\n");
+        std::thread { [] { (void)parse("b: [ 1, 2 ]\n"); } }.join();
+    }
+
+
+    TEST(events, {
+        TEST_ASSERT(!trace::enabled())
+
+        trace::start(path);
+        TEST_ASSERT(trace::enabled())
+
+        parse_twice();
+        {
+            trace::Span span("custom", "test");
+            span.arg("items", 3);
+        }
+
+        trace::stop();
+        TEST_ASSERT(!trace::enabled())
+
+        const auto text { read_trace() };
+        TEST_ASSERT(text.starts_with(R"({"displayTimeUnit":"ns")"))
+        TEST_ASSERT(text.ends_with("]}\n"))
+        TEST_ASSERT(occurrences(text, R"("name":"parse")") == 2)
+        TEST_ASSERT(occurrences(text, R"("bytes":5})") == 1)
+        TEST_ASSERT(occurrences(text, R"("tid":)") == 3)
+        TEST_ASSERT(occurrences(text, R"("items":3)") == 1)
+        TEST_ASSERT(occurrences(text, R"("cat":"test")") == 1)
+    })
+
+
+    TEST(disabled, {
+        trace::start(path);
+        trace::stop();
+
+        /* events after stop() are not recorded */
+        parse_twice();
+        TEST_ASSERT(occurrences(read_trace(), "parse") == 0)
+
+        TEST_THROWS(trace::start(path / "missing" / "trace.json"),
+                    trace::TraceError)
+        TEST_ASSERT(!trace::enabled())
+    })
+}
+
+
+auto
+main() -> int
+{
+    test::events();
+    test::disabled();
+    std::filesystem::remove(test::path);
+    return 0;
+}
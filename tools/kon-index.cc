@@ -0,0 +1,34 @@
+/* Writes the sidecar index of every given kon file, see koncpp/index.hh */
+
+#include <print>
+
+#include <koncpp/index.hh>
+
+
+auto
+main(int argc, char **argv) -> int
+{
+    if (argc < 2)
+    {
+        std::println(stderr, "usage: {} <file>...", argv[0]);
+        return 1;
+    }
+
+    int status { 0 };
+
+    for (int i { 1 }; i < argc; i++)
+    {
+        try
+        {
+            const auto index { koncpp::write_index(argv[i]) };
+            std::println("{}: {} members", argv[i], index.entries.size());
+        }
+        catch (const koncpp::Exception &e)
+        {
+            std::println(stderr, "{}: {}", argv[i], e.what());
+            status = 1;
+        }
+    }
+
+    return status;
+}
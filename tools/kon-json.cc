@@ -0,0 +1,37 @@
+/* Converts a kon file to JSON, or a JSON file to kon, on stdout */
+
+#include <iostream>
+#include <print>
+
+#include <koncpp/index.hh>
+#include <koncpp/json.hh>
+
+
+auto
+main(int argc, char **argv) -> int
+{
+    const std::string_view flag { argc == 3 ? argv[1] : "" };
+
+    if (argc < 2 || argc > 3 || (argc == 3 && flag != "--to-kon"))
+    {
+        std::println(stderr, "usage: {} [--to-kon] <file>", argv[0]);
+        return 1;
+    }
+
+    try
+    {
+        const koncpp::detail::FileContents contents { argv[argc - 1] };
+
+        if (flag.empty())
+            koncpp::kon_to_json(contents.view(), std::cout);
+        else
+            koncpp::json_to_kon(contents.view(), std::cout);
+    }
+    catch (const koncpp::Exception &e)
+    {
+        std::println(stderr, "{}: {}", argv[argc - 1], e.what());
+        return 1;
+    }
+
+    return 0;
+}